@@ -10,6 +10,46 @@
 #include <thread>
 #include <cstdlib>
 #include <filesystem>
+#include <sstream>
+#include <array>
+#include <atomic>
+#include <memory_resource>
+#include <cmath>
+#include <span>
+#include <string_view>
+#include <charconv>
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <cctype>
+#include <cstdio>
+#include <array>
+#include <bit>
+#include <numeric>
+#include <list>
+#include <random>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <poll.h>
+#endif
 
 // Console color definitions
 #define COLOR_RESET   "\033[0m"
@@ -22,16 +62,29 @@
 #define COLOR_WHITE   "\033[37m"
 #define COLOR_BOLD    "\033[1m"
 
+// Where the configurator prints. Scripted sessions point each thread at its own stream and skip
+// screen clearing and "Press Enter" pauses
+struct ConsoleTarget {
+    std::ostream* output = &std::cout;
+    std::ostream* errors = &std::cerr;
+    bool interactive = true;
+};
+
+thread_local ConsoleTarget consoleTarget;
+
+std::ostream& console() { return *consoleTarget.output; }
+std::ostream& consoleErrors() { return *consoleTarget.errors; }
+
 // Helper function to display headers
 void printHeader(const std::string& text) {
-    std::cout << COLOR_BOLD << COLOR_BLUE << "\n╔══════════════════════════════════════════════════════════╗" << COLOR_RESET << std::endl;
-    std::cout << COLOR_BOLD << COLOR_BLUE << "║ " << std::left << std::setw(52) << text << " ║" << COLOR_RESET << std::endl;
-    std::cout << COLOR_BOLD << COLOR_BLUE << "╚══════════════════════════════════════════════════════════╝" << COLOR_RESET << std::endl;
+    console() << COLOR_BOLD << COLOR_BLUE << "\n╔══════════════════════════════════════════════════════════╗" << COLOR_RESET << std::endl;
+    console() << COLOR_BOLD << COLOR_BLUE << "║ " << std::left << std::setw(52) << text << " ║" << COLOR_RESET << std::endl;
+    console() << COLOR_BOLD << COLOR_BLUE << "╚══════════════════════════════════════════════════════════╝" << COLOR_RESET << std::endl;
 }
 
 // Helper function to display menu items
 void printMenuItem(int number, const std::string& text) {
-    std::cout << COLOR_CYAN << " [" << number << "] " << COLOR_RESET << text << std::endl;
+    console() << COLOR_CYAN << " [" << number << "] " << COLOR_RESET << text << std::endl;
 }
 
 // Helper function to format prices
@@ -52,22 +105,39 @@ std::string formatPrice(double price) {
     return priceStr + " USD";
 }
 
-// Helper function for loading animation
-void showLoadingAnimation(const std::string& message, int duration = 1) {
-    std::cout << message;
-    for (int i = 0; i < 3; i++) {
-        for (char c : {'.', '.', '.'}) {
-            std::cout << c << std::flush;
-            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+// Helper function to format plain numbers the way std::cout does
+std::string formatNumber(double value) {
+    std::ostringstream ss;
+    ss << value;
+    return ss.str();
+}
+
+void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            out += buffer;
+        } else {
+            out += c;
         }
-        std::cout << "\b\b\b   \b\b\b" << std::flush;
     }
-    std::cout << COLOR_GREEN << "Done!" << COLOR_RESET << std::endl;
-    std::this_thread::sleep_for(std::chrono::seconds(duration));
+    out += '"';
+}
+
+// Status line for an action that completes immediately; slow work shows a spinner from its real progress instead
+void printStepDone(const std::string& message) {
+    console() << message << "... " << COLOR_GREEN << "Done!" << COLOR_RESET << std::endl;
 }
 
 // Function to clear console screen
 void clearScreen() {
+    if (!consoleTarget.interactive) return;
+    console() << std::flush;
 #ifdef _WIN32
     system("cls");
 #else
@@ -75,6 +145,332 @@ void clearScreen() {
 #endif
 }
 
+// Waits for Enter in the interactive configurator; scripted sessions continue at once
+void pauseForEnter() {
+    if (!consoleTarget.interactive) return;
+    console() << "\nPress Enter to continue...";
+    std::cin.ignore();
+    std::cin.get();
+}
+
+// Parts of the program heap allocations are charged to. Each thread carries one as a tag, set by
+// AllocationScope; worker threads tag themselves for their whole life.
+enum class MemorySubsystem : uint8_t {
+    OTHER,
+    CATALOG,
+    SESSION,
+    PRICING,
+    SEARCH,
+    LISTINGS,
+    SIMULATION,
+    BACKGROUND_IO,
+    BATCH,
+    COUNT
+};
+
+constexpr std::string_view memorySubsystemNames[] = {"other",      "catalog",       "session", "pricing", "search",
+                                                     "listings",   "simulation",    "background_io", "batch"};
+
+// Allocation counters, one block per thread. Only the owning thread writes its block, so counting
+// is a plain load and store rather than a locked add; readers sum every block. A block outlives its
+// thread and goes to the next new thread, which keeps counting on top of it.
+constexpr size_t MEMORY_SUBSYSTEMS = static_cast<size_t>(MemorySubsystem::COUNT);
+
+struct alignas(64) AllocationCounters {
+    std::atomic<uint64_t> allocations[MEMORY_SUBSYSTEMS]{};
+    std::atomic<uint64_t> bytes[MEMORY_SUBSYSTEMS]{};
+    std::atomic<uint64_t> frees[MEMORY_SUBSYSTEMS]{};
+    std::atomic<uint64_t> freedBytes[MEMORY_SUBSYSTEMS]{};
+    std::atomic<bool> inUse{false};
+    AllocationCounters* next = nullptr;
+};
+
+// Shared by threads that already handed their block back on exit; updated with atomic adds
+AllocationCounters exitingThreadCounters;
+std::atomic<AllocationCounters*> allocationCounterList{&exitingThreadCounters};
+
+thread_local AllocationCounters* threadCounters = nullptr;
+thread_local bool threadCountersReleased = false;
+thread_local MemorySubsystem allocationSubsystem = MemorySubsystem::OTHER;
+
+// Hands the thread's block back when the thread ends; frees after that go to the shared block
+struct AllocationCountersRelease {
+    ~AllocationCountersRelease() {
+        if (threadCounters && threadCounters != &exitingThreadCounters) {
+            threadCounters->inUse.store(false, std::memory_order_release);
+        }
+        threadCounters = &exitingThreadCounters;
+        threadCountersReleased = true;
+    }
+};
+thread_local AllocationCountersRelease threadCountersRelease;
+
+// Takes over an idle block, or adds one. Blocks come from malloc, as operator new is what is counted.
+AllocationCounters* claimAllocationCounters() {
+    for (AllocationCounters* block = allocationCounterList.load(std::memory_order_acquire); block; block = block->next) {
+        bool idle = false;
+        if (block != &exitingThreadCounters &&
+            block->inUse.compare_exchange_strong(idle, true, std::memory_order_acquire)) {
+            return block;
+        }
+    }
+#ifdef _WIN32
+    void* memory = _aligned_malloc(sizeof(AllocationCounters), alignof(AllocationCounters));
+#else
+    void* memory = std::aligned_alloc(alignof(AllocationCounters), sizeof(AllocationCounters));
+#endif
+    if (!memory) return &exitingThreadCounters;
+    auto* block = ::new (memory) AllocationCounters;
+    block->inUse.store(true, std::memory_order_relaxed);
+    block->next = allocationCounterList.load(std::memory_order_relaxed);
+    while (!allocationCounterList.compare_exchange_weak(block->next, block, std::memory_order_release,
+                                                        std::memory_order_relaxed)) {
+    }
+    return block;
+}
+
+AllocationCounters& threadAllocationCounters() {
+    if (!threadCounters) {
+        if (threadCountersReleased) {
+            threadCounters = &exitingThreadCounters;
+        } else {
+            threadCounters = claimAllocationCounters();
+            (void)&threadCountersRelease; // First use registers the hand-back at thread exit
+        }
+    }
+    return *threadCounters;
+}
+
+void addAllocationCount(const AllocationCounters& block, std::atomic<uint64_t>& counter, uint64_t amount) {
+    if (&block == &exitingThreadCounters) {
+        counter.fetch_add(amount, std::memory_order_relaxed);
+    } else {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+}
+
+// Every heap block starts with the size asked for and the subsystem it was charged to, so freeing it
+// credits that subsystem whichever thread or scope the free runs on. The header is as large as the
+// default new alignment, which keeps the block behind it aligned alike.
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) AllocationHeader {
+    size_t size;
+    MemorySubsystem subsystem;
+};
+
+// Bytes in front of the caller's block: the header, or a whole alignment step for over-aligned blocks
+constexpr size_t allocationOffset(size_t alignment) {
+    return std::max(alignment, sizeof(AllocationHeader));
+}
+
+void* allocateCounted(size_t size, size_t alignment) noexcept {
+    size_t offset = allocationOffset(alignment);
+    if (size > SIZE_MAX - 2 * offset) return nullptr;
+    void* base = nullptr;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        base = std::malloc(size + offset);
+    } else {
+#ifdef _WIN32
+        base = _aligned_malloc(size + offset, alignment);
+#else
+        base = std::aligned_alloc(alignment, (size + offset + alignment - 1) / alignment * alignment);
+#endif
+    }
+    if (!base) return nullptr;
+
+    MemorySubsystem subsystem = allocationSubsystem;
+    void* block = static_cast<char*>(base) + offset;
+    ::new (static_cast<AllocationHeader*>(block) - 1) AllocationHeader{size, subsystem};
+    AllocationCounters& counters = threadAllocationCounters();
+    size_t index = static_cast<size_t>(subsystem);
+    addAllocationCount(counters, counters.allocations[index], 1);
+    addAllocationCount(counters, counters.bytes[index], size);
+    return block;
+}
+
+void freeCounted(void* block, size_t alignment) noexcept {
+    if (!block) return;
+    const AllocationHeader& header = *(static_cast<AllocationHeader*>(block) - 1);
+    AllocationCounters& counters = threadAllocationCounters();
+    size_t index = static_cast<size_t>(header.subsystem);
+    addAllocationCount(counters, counters.frees[index], 1);
+    addAllocationCount(counters, counters.freedBytes[index], header.size);
+
+    void* base = static_cast<char*>(block) - allocationOffset(alignment);
+#ifdef _WIN32
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        _aligned_free(base);
+        return;
+    }
+#endif
+    std::free(base);
+}
+
+struct AllocationTotals {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    uint64_t liveBlocks = 0;
+    uint64_t liveBytes = 0;
+};
+
+// Allocations since start and blocks still in use, over all threads
+AllocationTotals allocationTotals(MemorySubsystem subsystem) {
+    AllocationTotals totals;
+    uint64_t frees = 0;
+    uint64_t freedBytes = 0;
+    size_t index = static_cast<size_t>(subsystem);
+    for (const AllocationCounters* block = allocationCounterList.load(std::memory_order_acquire); block;
+         block = block->next) {
+        totals.allocations += block->allocations[index].load(std::memory_order_relaxed);
+        totals.bytes += block->bytes[index].load(std::memory_order_relaxed);
+        frees += block->frees[index].load(std::memory_order_relaxed);
+        freedBytes += block->freedBytes[index].load(std::memory_order_relaxed);
+    }
+    // Blocks are read one after another, so a block freed meanwhile can show as freed but not allocated
+    totals.liveBlocks = totals.allocations > frees ? totals.allocations - frees : 0;
+    totals.liveBytes = totals.bytes > freedBytes ? totals.bytes - freedBytes : 0;
+    return totals;
+}
+
+// Charges this thread's allocations to a subsystem while alive, and tells how much heap the subsystem
+// gained meanwhile. That is the work of this scope as long as no other thread allocates for the same
+// subsystem at the same time.
+class AllocationScope {
+private:
+    MemorySubsystem subsystem;
+    MemorySubsystem previous;
+    uint64_t liveAtStart;
+
+public:
+    explicit AllocationScope(MemorySubsystem subsystem)
+        : subsystem(subsystem), previous(allocationSubsystem), liveAtStart(allocationTotals(subsystem).liveBytes) {
+        allocationSubsystem = subsystem;
+    }
+    ~AllocationScope() { allocationSubsystem = previous; }
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    // Bytes the subsystem holds now beyond what it held when the scope began
+    size_t retainedBytes() const {
+        uint64_t live = allocationTotals(subsystem).liveBytes;
+        return live > liveAtStart ? static_cast<size_t>(live - liveAtStart) : 0;
+    }
+};
+
+// Global allocation hook: every form of operator new and delete is replaced, aligned and nothrow
+// ones included, so each block carries its header and is counted against the subsystem it was
+// allocated for. The operators stay out of line, as replacement functions are meant to be.
+[[gnu::noinline]] void* operator new(size_t size) {
+    if (void* block = allocateCounted(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__)) return block;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+[[gnu::noinline]] void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocateCounted(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+[[gnu::noinline]] void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocateCounted(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+[[gnu::noinline]] void* operator new(size_t size, std::align_val_t alignment) {
+    if (void* block = allocateCounted(size, static_cast<size_t>(alignment))) return block;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void* operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+[[gnu::noinline]] void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateCounted(size, static_cast<size_t>(alignment));
+}
+
+[[gnu::noinline]] void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateCounted(size, static_cast<size_t>(alignment));
+}
+
+[[gnu::noinline]] void operator delete(void* pointer) noexcept {
+    freeCounted(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+[[gnu::noinline]] void operator delete[](void* pointer) noexcept {
+    freeCounted(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+[[gnu::noinline]] void operator delete(void* pointer, size_t) noexcept {
+    freeCounted(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+[[gnu::noinline]] void operator delete[](void* pointer, size_t) noexcept {
+    freeCounted(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+[[gnu::noinline]] void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    freeCounted(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+[[gnu::noinline]] void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    freeCounted(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+[[gnu::noinline]] void operator delete(void* pointer, std::align_val_t alignment) noexcept {
+    freeCounted(pointer, static_cast<size_t>(alignment));
+}
+
+[[gnu::noinline]] void operator delete[](void* pointer, std::align_val_t alignment) noexcept {
+    freeCounted(pointer, static_cast<size_t>(alignment));
+}
+
+[[gnu::noinline]] void operator delete(void* pointer, size_t, std::align_val_t alignment) noexcept {
+    freeCounted(pointer, static_cast<size_t>(alignment));
+}
+
+[[gnu::noinline]] void operator delete[](void* pointer, size_t, std::align_val_t alignment) noexcept {
+    freeCounted(pointer, static_cast<size_t>(alignment));
+}
+
+[[gnu::noinline]] void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    freeCounted(pointer, static_cast<size_t>(alignment));
+}
+
+[[gnu::noinline]] void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    freeCounted(pointer, static_cast<size_t>(alignment));
+}
+
+// Memory resource that counts allocations before forwarding them upstream
+class CountingResource : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* upstream;
+    std::atomic<size_t> allocationCount{0};
+    std::atomic<size_t> bytesAllocated{0};
+
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream(upstream) {}
+
+    size_t getAllocationCount() const { return allocationCount.load(std::memory_order_relaxed); }
+    size_t getBytesAllocated() const { return bytesAllocated.load(std::memory_order_relaxed); }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+        upstream->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
 // Equipment categories
 enum class EquipmentCategory {
     COMFORT,
@@ -95,1327 +491,10695 @@ std::string categoryToString(EquipmentCategory category) {
         default: return "Other";
     }
 }
-// Class representing equipment option
-class Equipment {
-private:
-    std::string name;
-    std::string description;
-    double price;
-    EquipmentCategory category;
-
-public:
-    Equipment(const std::string& name, const std::string& description, double price, EquipmentCategory category)
-        : name(name), description(description), price(price), category(category) {}
 
-    std::string getName() const { return name; }
-    std::string getDescription() const { return description; }
-    double getPrice() const { return price; }
-    EquipmentCategory getCategory() const { return category; }
+// Vehicle kinds known to the catalog
+enum class VehicleKind {
+    CAR,
+    MOTORCYCLE,
+    ELECTRIC
 };
 
-// Class representing engine
-class Engine {
-private:
-    std::string name;
+// Catalog records: plain data that can live in constexpr tables or point into a loaded catalog file
+struct EngineRecord {
+    std::string_view name;
     double capacity;
     int horsePower;
-    std::string fuelType;
+    std::string_view fuelType;
     double price;
-    int co2Emissions; // Added CO2 emissions in g/km
-    double fuelConsumption; // Added fuel consumption in l/100km
-
-public:
-    Engine(const std::string& name, double capacity, int horsePower,
-           const std::string& fuelType, double price, int co2Emissions = 0, double fuelConsumption = 0.0)
-        : name(name), capacity(capacity), horsePower(horsePower),
-          fuelType(fuelType), price(price), co2Emissions(co2Emissions), fuelConsumption(fuelConsumption) {}
+    int co2Emissions;
+    double fuelConsumption;
+};
 
-    std::string getName() const { return name; }
-    double getCapacity() const { return capacity; }
-    int getHorsePower() const { return horsePower; }
-    std::string getFuelType() const { return fuelType; }
-    double getPrice() const { return price; }
-    int getCO2Emissions() const { return co2Emissions; }
-    double getFuelConsumption() const { return fuelConsumption; }
+struct EquipmentRecord {
+    std::string_view name;
+    std::string_view description;
+    double price;
+    EquipmentCategory category;
 };
-// Base class for all vehicles
-class Vehicle {
-protected:
-    std::string brand;
-    std::string model;
-    double basePrice;
-    std::shared_ptr<Engine> engine;
-    std::vector<Equipment> selectedEquipment;
-    std::string color;
-    std::string year;
-    double discount; // Percentage discount
 
-    // ASCII art for visualization
-    std::vector<std::string> asciiArt;
+struct VehicleRecord {
+    VehicleKind kind;
+    std::string_view brand;
+    std::string_view model;
+    double basePrice;
+    std::string_view year;
+    std::string_view bodyType; // Car body type or motorcycle type
+    int numberOfDoors;
+    int trunkCapacity;
+    int engineDisplacement;
+    int batteryCapacity;
+    int range;
+    int chargingTime;
+};
 
-public:
-    Vehicle(const std::string& brand, const std::string& model, double basePrice, const std::string& year = "2023")
-        : brand(brand), model(model), basePrice(basePrice), color("White"), year(year), discount(0.0) {}
+// Compile-time catalog generated from catalog.dat by catalog_gen
+#include "catalog_data.h"
 
-    virtual ~Vehicle() = default;
+// Read-only view of a catalog; the records are never copied
+struct CatalogView {
+    std::span<const VehicleRecord> vehicles;
+    std::span<const EngineRecord> engines;
+    std::span<const EquipmentRecord> equipment;
+    std::span<const std::string_view> colors;
+};
 
-    // Getters
-    std::string getBrand() const { return brand; }
-    std::string getModel() const { return model; }
-    double getBasePrice() const { return basePrice; }
-    std::string getColor() const { return color; }
-    std::string getYear() const { return year; }
-    double getDiscount() const { return discount; }
-    const std::vector<Equipment>& getSelectedEquipment() const { return selectedEquipment; } // Added accessor
+constinit const CatalogView builtInCatalog{catalogVehicles, catalogEngines, catalogEquipment, catalogColors};
 
-    // Setters
-    void setEngine(std::shared_ptr<Engine> newEngine) { engine = newEngine; }
-    void setColor(const std::string& newColor) { color = newColor; }
-    void setDiscount(double newDiscount) { discount = newDiscount; }
+// Read-only memory mapping of a whole file
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    std::string buffer;
+#else
+    // Maps the whole object behind a descriptor read-only and closes the descriptor
+    bool mapDescriptor(int fd) {
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
 
-    // Adding equipment
-    void addEquipment(const Equipment& equipment) {
-        // Check if equipment is already added
-        auto it = std::find_if(selectedEquipment.begin(), selectedEquipment.end(),
-            [&equipment](const Equipment& e) { return e.getName() == equipment.getName(); });
+        size = static_cast<size_t>(info.st_size);
+        if (size == 0) {
+            ::close(fd);
+            data = "";
+            return true;
+        }
 
-        if (it == selectedEquipment.end()) {
-            selectedEquipment.push_back(equipment);
-            std::cout << COLOR_GREEN << "✓ " << equipment.getName() << " added to configuration." << COLOR_RESET << std::endl;
-        } else {
-            std::cout << COLOR_YELLOW << "! " << equipment.getName() << " is already in your configuration." << COLOR_RESET << std::endl;
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            size = 0;
+            return false;
         }
+        data = static_cast<const char*>(mapping);
+        return true;
     }
+#endif
 
-    // Removing equipment
-    void removeEquipment(const std::string& name) {
-        auto it = std::find_if(selectedEquipment.begin(), selectedEquipment.end(),
-            [&name](const Equipment& e) { return e.getName() == name; });
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
 
-        if (it != selectedEquipment.end()) {
-            selectedEquipment.erase(it);
-            std::cout << COLOR_RED << "✓ " << name << " removed from configuration." << COLOR_RESET << std::endl;
-        } else {
-            std::cout << COLOR_YELLOW << "! " << name << " is not in your configuration." << COLOR_RESET << std::endl;
-        }
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        size = buffer.size();
+        return true;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        return mapDescriptor(fd);
+#endif
     }
 
-    // Calculating total price
-    virtual double calculateTotalPrice() const {
-        double total = basePrice;
-
-        if (engine) {
-            total += engine->getPrice();
-        }
+    // Maps a POSIX shared-memory object read-only
+    bool openSharedMemory(const std::string& name) {
+        close();
+#ifdef _WIN32
+        return false;
+#else
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) return false;
+        return mapDescriptor(fd);
+#endif
+    }
 
-        for (const auto& equipment : selectedEquipment) {
-            total += equipment.getPrice();
+    void close() {
+#ifndef _WIN32
+        if (data && size > 0) {
+            munmap(const_cast<char*>(data), size);
         }
+#endif
+        data = nullptr;
+        size = 0;
+    }
 
-        // Apply discount if any
-        if (discount > 0) {
-            total = total * (1.0 - discount / 100.0);
-        }
+    std::string_view contents() const { return {data, size}; }
+};
 
-        return total;
+// Reads a whole file into a buffer that is reused between calls
+bool readFileInto(const std::filesystem::path& path, std::string& buffer) {
+    std::FILE* file = std::fopen(path.string().c_str(), "rb");
+    if (!file) return false;
+    buffer.clear();
+    char chunk[16384];
+    size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        buffer.append(chunk, read);
     }
-    // Displaying vehicle information
-    virtual void displayInfo() const {
-        printHeader(brand + " " + model + " (" + year + ")");
+    bool ok = !std::ferror(file);
+    std::fclose(file);
+    return ok;
+}
 
-        std::cout << COLOR_BOLD << "Color: " << COLOR_RESET << color << std::endl;
-        std::cout << COLOR_BOLD << "Base price: " << COLOR_RESET << formatPrice(basePrice) << std::endl;
+// Helpers for the catalog parser: trimming and number conversion over string_views
+std::string_view trimView(std::string_view text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) return {};
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
 
-        if (engine) {
-            std::cout << COLOR_BOLD << "\nEngine: " << COLOR_RESET << engine->getName() << std::endl;
-            std::cout << "  ├─ Capacity: " << engine->getCapacity() << "L" << std::endl;
-            std::cout << "  ├─ Power: " << engine->getHorsePower() << " HP" << std::endl;
-            std::cout << "  ├─ Fuel type: " << engine->getFuelType() << std::endl;
+template <typename Number>
+bool parseNumber(std::string_view text, Number& value) {
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
 
-            if (engine->getCO2Emissions() > 0) {
-                std::cout << "  ├─ CO2 emissions: " << engine->getCO2Emissions() << " g/km" << std::endl;
-            }
+bool parseCategory(std::string_view text, EquipmentCategory& category) {
+    if (text == "COMFORT") category = EquipmentCategory::COMFORT;
+    else if (text == "SAFETY") category = EquipmentCategory::SAFETY;
+    else if (text == "MULTIMEDIA") category = EquipmentCategory::MULTIMEDIA;
+    else if (text == "EXTERIOR") category = EquipmentCategory::EXTERIOR;
+    else if (text == "PERFORMANCE") category = EquipmentCategory::PERFORMANCE;
+    else return false;
+    return true;
+}
 
-            if (engine->getFuelConsumption() > 0) {
-                std::cout << "  ├─ Fuel consumption: " << engine->getFuelConsumption() << " l/100km" << std::endl;
-            }
+// Catalog layout for POSIX shared memory. Everything is addressed by offsets from the start of the
+// segment, so any process can map it anywhere read-only. Each published version is its own segment
+// "<name>.<version>"; a small control segment "<name>" holds the current version number. Publishing
+// writes a complete new segment, then bumps the number and unlinks the previous segment. Readers that
+// still map it keep a valid copy until they switch over.
+constexpr char SHARED_CATALOG_MAGIC[8] = {'V', 'C', 'F', 'G', 'S', 'H', 'M', '1'};
+constexpr uint32_t SHARED_CATALOG_LAYOUT = 1;
+
+struct SharedString {
+    uint32_t offset; // Into the string area
+    uint32_t length;
+};
 
-            std::cout << "  └─ Price: " << formatPrice(engine->getPrice()) << std::endl;
-        }
+struct SharedTable {
+    uint64_t offset; // From the start of the segment
+    uint64_t count;
+};
 
-        if (!selectedEquipment.empty()) {
-            std::cout << COLOR_BOLD << "\nSelected equipment:" << COLOR_RESET << std::endl;
+struct SharedVehicle {
+    uint32_t kind;
+    SharedString brand;
+    SharedString model;
+    SharedString year;
+    SharedString bodyType;
+    double basePrice;
+    int32_t numberOfDoors;
+    int32_t trunkCapacity;
+    int32_t engineDisplacement;
+    int32_t batteryCapacity;
+    int32_t range;
+    int32_t chargingTime;
+};
 
-            // Group equipment by category
-            std::map<EquipmentCategory, std::vector<Equipment>> equipmentByCategory;
-            for (const auto& equipment : selectedEquipment) {
-                equipmentByCategory[equipment.getCategory()].push_back(equipment);
-            }
+struct SharedEngine {
+    SharedString name;
+    SharedString fuelType;
+    double capacity;
+    double price;
+    double fuelConsumption;
+    int32_t horsePower;
+    int32_t co2Emissions;
+};
 
-            for (const auto& categoryPair : equipmentByCategory) {
-                std::cout << COLOR_YELLOW << "  " << categoryToString(categoryPair.first) << ":" << COLOR_RESET << std::endl;
+struct SharedEquipment {
+    SharedString name;
+    SharedString description;
+    double price;
+    uint32_t category;
+};
 
-                double categoryTotal = 0.0;
-                for (const auto& equipment : categoryPair.second) {
-                    std::cout << "    ├─ " << equipment.getName() << ": " << formatPrice(equipment.getPrice()) << std::endl;
-                    std::cout << "    │  " << equipment.getDescription() << std::endl;
-                    categoryTotal += equipment.getPrice();
-                }
-                std::cout << "    └─ " << COLOR_BOLD << "Category total: " << formatPrice(categoryTotal) << COLOR_RESET << std::endl;
-            }
-        }
+struct SharedCatalogHeader {
+    char magic[8];
+    uint32_t layout;
+    uint32_t reserved;
+    uint64_t version;
+    uint64_t totalSize;
+    SharedTable vehicles;
+    SharedTable engines;
+    SharedTable equipment;
+    SharedTable colors; // SharedString entries
+    SharedTable strings; // Bytes
+};
 
-        if (discount > 0) {
-            double discountAmount = (basePrice + (engine ? engine->getPrice() : 0.0));
-            for (const auto& equipment : selectedEquipment) {
-                discountAmount += equipment.getPrice();
-            }
-            discountAmount = discountAmount * (discount / 100.0);
+struct SharedCatalogControl {
+    char magic[8];
+    std::atomic<uint64_t> version; // 0 until the first publish
+    std::atomic<uint64_t> claimed; // Highest version a publisher has started on
+};
 
-            std::cout << COLOR_BOLD << "\nDiscount: " << COLOR_RESET << discount << "% (" << formatPrice(discountAmount) << ")" << std::endl;
-        }
+// The control word is read and written by different processes through their own mappings
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
 
-        std::cout << COLOR_BOLD << COLOR_GREEN << "\nTotal price: " << formatPrice(calculateTotalPrice()) << COLOR_RESET << std::endl;
-    }
+inline std::string sharedCatalogSegmentName(const std::string& name, uint64_t version) {
+    return name + "." + std::to_string(version);
+}
 
-    // Vehicle visualization
-    virtual void visualize() const {
-        clearScreen();
-        printHeader("Visualization of " + brand + " " + model + " in " + color + " color");
+// Builds the segment image of a catalog view; equal strings are stored once
+std::vector<char> buildSharedCatalogImage(const CatalogView& catalog, uint64_t version) {
+    std::string strings;
+    std::unordered_map<std::string_view, SharedString> interned;
+    auto intern = [&strings, &interned](std::string_view text) {
+        auto it = interned.find(text);
+        if (it != interned.end()) return it->second;
+        SharedString entry{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(text.size())};
+        strings.append(text);
+        interned.emplace(text, entry);
+        return entry;
+    };
+
+    std::vector<SharedVehicle> vehicles;
+    for (const auto& record : catalog.vehicles) {
+        vehicles.push_back({static_cast<uint32_t>(record.kind), intern(record.brand), intern(record.model),
+                            intern(record.year), intern(record.bodyType), record.basePrice, record.numberOfDoors,
+                            record.trunkCapacity, record.engineDisplacement, record.batteryCapacity, record.range,
+                            record.chargingTime});
+    }
+    std::vector<SharedEngine> engines;
+    for (const auto& record : catalog.engines) {
+        engines.push_back({intern(record.name), intern(record.fuelType), record.capacity, record.price,
+                           record.fuelConsumption, record.horsePower, record.co2Emissions});
+    }
+    std::vector<SharedEquipment> equipment;
+    for (const auto& record : catalog.equipment) {
+        equipment.push_back({intern(record.name), intern(record.description), record.price,
+                             static_cast<uint32_t>(record.category)});
+    }
+    std::vector<SharedString> colors;
+    for (std::string_view color : catalog.colors) colors.push_back(intern(color));
+
+    SharedCatalogHeader header{};
+    std::memcpy(header.magic, SHARED_CATALOG_MAGIC, sizeof(header.magic));
+    header.layout = SHARED_CATALOG_LAYOUT;
+    header.version = version;
+
+    std::vector<char> image(sizeof(SharedCatalogHeader));
+    auto append = [&image](const void* bytes, size_t size, size_t count) {
+        image.resize((image.size() + 7) / 8 * 8);
+        SharedTable table{image.size(), count};
+        image.insert(image.end(), static_cast<const char*>(bytes), static_cast<const char*>(bytes) + size);
+        return table;
+    };
+    header.vehicles = append(vehicles.data(), vehicles.size() * sizeof(SharedVehicle), vehicles.size());
+    header.engines = append(engines.data(), engines.size() * sizeof(SharedEngine), engines.size());
+    header.equipment = append(equipment.data(), equipment.size() * sizeof(SharedEquipment), equipment.size());
+    header.colors = append(colors.data(), colors.size() * sizeof(SharedString), colors.size());
+    header.strings = append(strings.data(), strings.size(), strings.size());
+    header.totalSize = image.size();
+    std::memcpy(image.data(), &header, sizeof(header));
+    return image;
+}
 
-        // Apply color to ASCII art
-        std::string colorCode;
-        if (color == "Red") colorCode = COLOR_RED;
-        else if (color == "Blue") colorCode = COLOR_BLUE;
-        else if (color == "Green") colorCode = COLOR_GREEN;
-        else if (color == "Yellow") colorCode = COLOR_YELLOW;
-        else if (color == "Black") colorCode = COLOR_BOLD;
-        else colorCode = COLOR_WHITE; // Default for other colors
+#ifndef _WIN32
+// Creates (or opens) a shared-memory object of the given size and maps it writable
+void* mapSharedMemoryForWriting(const std::string& name, size_t size, bool exclusive, std::string& error) {
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | (exclusive ? O_EXCL : 0), 0644);
+    if (fd < 0) {
+        error = "Cannot create shared memory " + name + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (static_cast<size_t>(info.st_size) < size && ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+        error = "Cannot size shared memory " + name + ": " + std::strerror(errno);
+        ::close(fd);
+        return nullptr;
+    }
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        error = "Cannot map shared memory " + name + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    return mapping;
+}
+#endif
 
-        for (const auto& line : asciiArt) {
-            std::cout << colorCode << line << COLOR_RESET << std::endl;
+// Publishes a catalog under a shared-memory name and returns its shared version number (0 on failure)
+uint64_t publishSharedCatalog(const std::string& name, const CatalogView& catalog, std::string& error) {
+#ifdef _WIN32
+    error = "Shared-memory catalogs need POSIX shared memory";
+    return 0;
+#else
+    void* controlMapping = mapSharedMemoryForWriting(name, sizeof(SharedCatalogControl), false, error);
+    if (!controlMapping) return 0;
+    // A new object is zero-filled, which is a valid atomic holding 0
+    auto* control = static_cast<SharedCatalogControl*>(controlMapping);
+    std::memcpy(control->magic, SHARED_CATALOG_MAGIC, sizeof(control->magic));
+
+    // Claim a version of our own first, so concurrent publishers never build the same segment
+    uint64_t claimed = control->claimed.load(std::memory_order_acquire);
+    uint64_t version;
+    do {
+        version = std::max(claimed, control->version.load(std::memory_order_acquire)) + 1;
+    } while (!control->claimed.compare_exchange_weak(claimed, version, std::memory_order_acq_rel));
+    std::vector<char> image = buildSharedCatalogImage(catalog, version);
+
+    std::string segment = sharedCatalogSegmentName(name, version);
+    shm_unlink(segment.c_str()); // Left over from before the control object was recreated
+    void* mapping = mapSharedMemoryForWriting(segment, image.size(), true, error);
+    if (mapping) {
+        std::memcpy(mapping, image.data(), image.size());
+        munmap(mapping, image.size());
+
+        // Announce the segment unless a later version got there first, then drop the one it replaces
+        uint64_t previous = control->version.load(std::memory_order_acquire);
+        while (previous < version &&
+               !control->version.compare_exchange_weak(previous, version, std::memory_order_acq_rel)) {
         }
+        uint64_t replaced = previous < version ? previous : version;
+        if (replaced != 0) {
+            shm_unlink(sharedCatalogSegmentName(name, replaced).c_str());
+        }
+    }
+    munmap(controlMapping, sizeof(SharedCatalogControl));
+    return mapping ? version : 0;
+#endif
+}
 
-        std::cout << "\nPress Enter to continue...";
-        std::cin.ignore();
-        std::cin.get();
+// Current shared version of a published catalog, 0 if nothing is published under the name
+uint64_t sharedCatalogVersion(const std::string& name) {
+    MappedFile control;
+    if (!control.openSharedMemory(name)) return 0;
+    std::string_view data = control.contents();
+    if (data.size() < sizeof(SharedCatalogControl) ||
+        std::memcmp(data.data(), SHARED_CATALOG_MAGIC, sizeof(SHARED_CATALOG_MAGIC)) != 0) {
+        return 0;
     }
-    // Saving configuration to file
-    virtual void saveToFile(const std::string& filename) const {
-        // Create directory if it doesn't exist
-        std::filesystem::path dirPath = "configs";
-        if (!std::filesystem::exists(dirPath)) {
-            std::filesystem::create_directory(dirPath);
-        }
+    return reinterpret_cast<const SharedCatalogControl*>(data.data())->version.load(std::memory_order_acquire);
+}
 
-        std::ofstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << COLOR_RED << "Cannot open file for writing: " << filename << COLOR_RESET << std::endl;
-            return;
-        }
+// Removes the published catalog; processes that mapped it keep their copy
+void unpublishSharedCatalog(const std::string& name) {
+#ifndef _WIN32
+    if (uint64_t version = sharedCatalogVersion(name)) {
+        shm_unlink(sharedCatalogSegmentName(name, version).c_str());
+    }
+    shm_unlink(name.c_str());
+#endif
+}
 
-        file << "VEHICLE_CONFIGURATION\n";
-        file << "VERSION 2.0\n";
-        file << "DATE " << getCurrentDateTime() << "\n\n";
+// Copies one fixed-size entry out of a segment table; the caller has checked the bounds
+template <typename Entry>
+Entry readSharedEntry(std::string_view image, const SharedTable& table, uint64_t index) {
+    Entry entry;
+    std::memcpy(&entry, image.data() + table.offset + index * sizeof(Entry), sizeof(Entry));
+    return entry;
+}
 
-        file << "[VEHICLE]\n";
-        file << "BRAND=" << brand << "\n";
-        file << "MODEL=" << model << "\n";
-        file << "YEAR=" << year << "\n";
-        file << "BASE_PRICE=" << basePrice << "\n";
-        file << "COLOR=" << color << "\n";
-        file << "DISCOUNT=" << discount << "\n\n";
+// Immutable catalog version. Snapshots loaded from a file own a copy of its text and shared-memory
+// snapshots keep their segment mapped; the records point straight into either.
+class CatalogSnapshot {
+private:
+    CatalogView view;
+    uint64_t version = 0;
+    uint64_t publishedVersion = 0; // Shared-memory version this snapshot was mapped from
+    std::string source;
+
+    MappedFile file;
+    std::string text;
+    std::vector<VehicleRecord> vehicles;
+    std::vector<EngineRecord> engines;
+    std::vector<EquipmentRecord> equipment;
+    std::vector<std::string_view> colors;
+
+    // Single pass over the catalog text (same format as catalog.dat); no field is copied
+    bool parse(std::string_view text, std::string& error) {
+        std::string_view section;
+        size_t lineNumber = 0;
+
+        auto fail = [&](const std::string& message) {
+            error = source + ":" + std::to_string(lineNumber) + ": " + message;
+            return false;
+        };
 
-        if (engine) {
-            file << "[ENGINE]\n";
-            file << "NAME=" << engine->getName() << "\n";
-            file << "CAPACITY=" << engine->getCapacity() << "\n";
-            file << "HORSEPOWER=" << engine->getHorsePower() << "\n";
-            file << "FUEL_TYPE=" << engine->getFuelType() << "\n";
-            file << "PRICE=" << engine->getPrice() << "\n";
-            file << "CO2_EMISSIONS=" << engine->getCO2Emissions() << "\n";
-            file << "FUEL_CONSUMPTION=" << engine->getFuelConsumption() << "\n\n";
+        while (!text.empty()) {
+            size_t end = text.find('\n');
+            std::string_view line = text.substr(0, end);
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+            ++lineNumber;
+
+            line = trimView(line);
+            if (line.empty() || line.front() == '#') continue;
+            if (line.front() == '[') {
+                section = line;
+                continue;
+            }
+
+            std::array<std::string_view, 8> fields;
+            size_t fieldCount = 0;
+            while (fieldCount < fields.size()) {
+                size_t separator = line.find('|');
+                fields[fieldCount++] = trimView(line.substr(0, separator));
+                if (separator == std::string_view::npos) {
+                    line = {};
+                    break;
+                }
+                line.remove_prefix(separator + 1);
+            }
+            if (!line.empty()) return fail("too many fields");
+
+            if (section == "[COLORS]") {
+                colors.push_back(fields[0]);
+            } else if (section == "[ENGINES]") {
+                EngineRecord engine{fields[0], 0.0, 0, fields[3], 0.0, 0, 0.0};
+                if (fieldCount != 7 || !parseNumber(fields[1], engine.capacity) ||
+                    !parseNumber(fields[2], engine.horsePower) || !parseNumber(fields[4], engine.price) ||
+                    !parseNumber(fields[5], engine.co2Emissions) || !parseNumber(fields[6], engine.fuelConsumption)) {
+                    return fail("invalid engine entry");
+                }
+                engines.push_back(engine);
+            } else if (section == "[EQUIPMENT]") {
+                EquipmentRecord item{fields[0], fields[1], 0.0, EquipmentCategory::COMFORT};
+                if (fieldCount != 4 || !parseNumber(fields[2], item.price) || !parseCategory(fields[3], item.category)) {
+                    return fail("invalid equipment entry");
+                }
+                equipment.push_back(item);
+            } else if (section == "[VEHICLES]") {
+                VehicleRecord vehicle{VehicleKind::CAR, fields[1], fields[2], 0.0, fields[4], {}, 0, 0, 0, 0, 0, 0};
+                bool valid = parseNumber(fields[3], vehicle.basePrice);
+                if (fields[0] == "CAR") {
+                    vehicle.bodyType = fields[5];
+                    valid = valid && fieldCount == 8 && parseNumber(fields[6], vehicle.numberOfDoors) &&
+                            parseNumber(fields[7], vehicle.trunkCapacity);
+                } else if (fields[0] == "MOTORCYCLE") {
+                    vehicle.kind = VehicleKind::MOTORCYCLE;
+                    vehicle.bodyType = fields[5];
+                    valid = valid && fieldCount == 7 && parseNumber(fields[6], vehicle.engineDisplacement);
+                } else if (fields[0] == "ELECTRIC") {
+                    vehicle.kind = VehicleKind::ELECTRIC;
+                    valid = valid && fieldCount == 8 && parseNumber(fields[5], vehicle.batteryCapacity) &&
+                            parseNumber(fields[6], vehicle.range) && parseNumber(fields[7], vehicle.chargingTime);
+                } else {
+                    valid = false;
+                }
+                if (!valid) return fail("invalid vehicle entry");
+                vehicles.push_back(vehicle);
+            } else {
+                return fail("entry outside of a known section");
+            }
         }
 
-        file << "[EQUIPMENT]\n";
-        file << "COUNT=" << selectedEquipment.size() << "\n\n";
+        if (vehicles.empty() || engines.empty() || equipment.empty() || colors.empty()) {
+            error = source + ": every catalog section needs at least one entry";
+            return false;
+        }
+        return true;
+    }
 
-        for (size_t i = 0; i < selectedEquipment.size(); ++i) {
-            file << "[EQUIPMENT_ITEM_" << i + 1 << "]\n";
-            file << "NAME=" << selectedEquipment[i].getName() << "\n";
-            file << "DESCRIPTION=" << selectedEquipment[i].getDescription() << "\n";
-            file << "PRICE=" << selectedEquipment[i].getPrice() << "\n";
-            file << "CATEGORY=" << static_cast<int>(selectedEquipment[i].getCategory()) << "\n\n";
+    // Checks a shared-memory catalog image and builds the record tables; strings stay in the segment
+    bool readSharedImage(std::string_view image, std::string& error) {
+        SharedCatalogHeader header;
+        if (image.size() < sizeof(header)) {
+            error = source + ": truncated catalog segment";
+            return false;
+        }
+        std::memcpy(&header, image.data(), sizeof(header));
+        if (std::memcmp(header.magic, SHARED_CATALOG_MAGIC, sizeof(header.magic)) != 0 ||
+            header.layout != SHARED_CATALOG_LAYOUT || header.totalSize > image.size()) {
+            error = source + ": not a catalog segment of this version";
+            return false;
         }
 
-        file << "[SUMMARY]\n";
-        file << "TOTAL_PRICE=" << calculateTotalPrice() << "\n";
+        auto fits = [&image](const SharedTable& table, size_t entrySize) {
+            return table.offset % 8 == 0 && table.offset <= image.size() &&
+                   table.count <= (image.size() - table.offset) / entrySize;
+        };
+        if (!fits(header.vehicles, sizeof(SharedVehicle)) || !fits(header.engines, sizeof(SharedEngine)) ||
+            !fits(header.equipment, sizeof(SharedEquipment)) || !fits(header.colors, sizeof(SharedString)) ||
+            !fits(header.strings, 1)) {
+            error = source + ": catalog table out of bounds";
+            return false;
+        }
 
-        file.close();
-        showLoadingAnimation("Saving configuration to " + filename);
-    }
+        std::string_view strings = image.substr(header.strings.offset, header.strings.count);
+        bool valid = true;
+        auto text = [&strings, &valid](SharedString entry) {
+            if (entry.offset > strings.size() || entry.length > strings.size() - entry.offset) {
+                valid = false;
+                return std::string_view();
+            }
+            return strings.substr(entry.offset, entry.length);
+        };
 
-    // Helper function to get current date and time
-    std::string getCurrentDateTime() const {
-        auto now = std::chrono::system_clock::now();
-        auto in_time_t = std::chrono::system_clock::to_time_t(now);
+        for (uint64_t i = 0; i < header.vehicles.count; ++i) {
+            auto entry = readSharedEntry<SharedVehicle>(image, header.vehicles, i);
+            valid = valid && entry.kind <= static_cast<uint32_t>(VehicleKind::ELECTRIC);
+            vehicles.push_back({static_cast<VehicleKind>(entry.kind), text(entry.brand), text(entry.model),
+                                entry.basePrice, text(entry.year), text(entry.bodyType), entry.numberOfDoors,
+                                entry.trunkCapacity, entry.engineDisplacement, entry.batteryCapacity, entry.range,
+                                entry.chargingTime});
+        }
+        for (uint64_t i = 0; i < header.engines.count; ++i) {
+            auto entry = readSharedEntry<SharedEngine>(image, header.engines, i);
+            engines.push_back({text(entry.name), entry.capacity, entry.horsePower, text(entry.fuelType), entry.price,
+                               entry.co2Emissions, entry.fuelConsumption});
+        }
+        for (uint64_t i = 0; i < header.equipment.count; ++i) {
+            auto entry = readSharedEntry<SharedEquipment>(image, header.equipment, i);
+            valid = valid && entry.category <= static_cast<uint32_t>(EquipmentCategory::PERFORMANCE);
+            equipment.push_back({text(entry.name), text(entry.description), entry.price,
+                                 static_cast<EquipmentCategory>(entry.category)});
+        }
+        for (uint64_t i = 0; i < header.colors.count; ++i) {
+            colors.push_back(text(readSharedEntry<SharedString>(image, header.colors, i)));
+        }
 
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d %H:%M:%S");
-        return ss.str();
+        if (!valid) {
+            error = source + ": corrupt catalog entry";
+            return false;
+        }
+        if (vehicles.empty() || engines.empty() || equipment.empty() || colors.empty()) {
+            error = source + ": every catalog section needs at least one entry";
+            return false;
+        }
+        return true;
     }
-};
-// Class for passenger cars
-class Car : public Vehicle {
-private:
-    int numberOfDoors;
-    std::string bodyType; // sedan, hatchback, SUV, etc.
-    int trunkCapacity; // in liters
 
 public:
-    Car(const std::string& brand, const std::string& model, double basePrice,
-        int numberOfDoors, const std::string& bodyType, int trunkCapacity = 0,
-        const std::string& year = "2023")
-        : Vehicle(brand, model, basePrice, year), numberOfDoors(numberOfDoors),
-          bodyType(bodyType), trunkCapacity(trunkCapacity) {
+    CatalogSnapshot() = default;
+    CatalogSnapshot(const CatalogView& view, uint64_t version, std::string source)
+        : view(view), version(version), source(std::move(source)) {}
+    CatalogSnapshot(const CatalogSnapshot&) = delete;
+    CatalogSnapshot& operator=(const CatalogSnapshot&) = delete;
+
+    const CatalogView& getView() const { return view; }
+    uint64_t getVersion() const { return version; }
+    uint64_t getPublishedVersion() const { return publishedVersion; }
+    const std::string& getSource() const { return source; }
+
+    // Where the catalog text lives: compiled-in read-only data, a copy of a file or a shared-memory segment
+    std::string_view getTextStorage() const {
+        return publishedVersion ? "shared" : text.empty() ? "read-only" : "heap";
+    }
+    size_t getImageBytes() const { return publishedVersion ? file.contents().size() : text.size(); }
 
-        // Enhanced ASCII visualization for car
-        if (bodyType == "Sedan") {
-            asciiArt = {
-                "          ______--------___",
-                "         /|             / |",
-                "        / |  ___      /   |",
-                "       /__|_/   \\____/    |",
-                "      |            |     _|",
-                "      |____________|____/",
-                "      |            |",
-                "      \\____________/",
-                "       O        O"
-            };
-        } else if (bodyType == "Hatchback") {
-            asciiArt = {
-                "         __---~~~~--__",
-                "       /|             \\",
-                "      / |  ___        |",
-                "     /__|_/   \\____   |",
-                "    |            |   _|",
-                "    |____________|__/",
-                "    |            |",
-                "    \\____________/",
-                "     O        O"
-            };
-        } else if (bodyType == "SUV") {
-            asciiArt = {
-                "         __---~~~~--__",
-                "       /|             \\",
-                "      / |  ___        |",
-                "     /__|_/   \\____   |",
-                "    |            |    |",
-                "    |            |    |",
-                "    |____________|____|",
-                "    |            |",
-                "    \\____________/",
-                "     O        O"
-            };
-        } else {
-            asciiArt = {
-                "    ____",
-                " __/  |_\\_",
-                "|  _     _`-.",
-                "'-(_)---(_)--'"
-            };
+    // Loaded catalogs keep their record tables on the heap; the compiled-in tables are read-only data
+    std::string_view getTableStorage() const { return vehicles.empty() ? "read-only" : "heap"; }
+
+    // The compiled-in catalog; handed out without allocating a control block
+    static std::shared_ptr<const CatalogSnapshot> builtIn() {
+        static const CatalogSnapshot snapshot(builtInCatalog, 1, "built-in");
+        return std::shared_ptr<const CatalogSnapshot>(std::shared_ptr<const CatalogSnapshot>(), &snapshot);
+    }
+
+    // Reads a catalog file into the snapshot and parses it in place. The text is copied rather than
+    // mapped, so rewriting or truncating the file never changes or faults an older snapshot.
+    static std::shared_ptr<const CatalogSnapshot> loadFromFile(const std::string& path, uint64_t version,
+                                                               std::string& error) {
+        AllocationScope scope(MemorySubsystem::CATALOG);
+        auto snapshot = std::make_shared<CatalogSnapshot>();
+        snapshot->version = version;
+        snapshot->source = path;
+
+        if (!readFileInto(path, snapshot->text)) {
+            error = "Cannot open catalog file: " + path;
+            return nullptr;
+        }
+        if (!snapshot->parse(snapshot->text, error)) {
+            return nullptr;
         }
+
+        snapshot->view = {snapshot->vehicles, snapshot->engines, snapshot->equipment, snapshot->colors};
+        return snapshot;
     }
 
-    int getNumberOfDoors() const { return numberOfDoors; }
-    std::string getBodyType() const { return bodyType; }
-    int getTrunkCapacity() const { return trunkCapacity; }
+    // Maps the current version of a catalog published in shared memory; strings are read in place
+    static std::shared_ptr<const CatalogSnapshot> loadFromSharedMemory(const std::string& name, uint64_t version,
+                                                                       std::string& error) {
+        AllocationScope scope(MemorySubsystem::CATALOG);
+        auto snapshot = std::make_shared<CatalogSnapshot>();
+        snapshot->version = version;
+
+        // A publisher unlinks the previous segment right after announcing a new one, so a reader
+        // that lost that race simply reads the version number again
+        for (int attempt = 0; attempt < 3 && snapshot->publishedVersion == 0; ++attempt) {
+            uint64_t published = sharedCatalogVersion(name);
+            if (published == 0) break;
+            if (snapshot->file.openSharedMemory(sharedCatalogSegmentName(name, published))) {
+                snapshot->publishedVersion = published;
+            }
+        }
+        if (snapshot->publishedVersion == 0) {
+            error = "No catalog published in shared memory as " + name;
+            return nullptr;
+        }
 
-    void displayInfo() const override {
-        Vehicle::displayInfo();
-        std::cout << COLOR_BOLD << "\nCar details:" << COLOR_RESET << std::endl;
-        std::cout << "  ├─ Body type: " << bodyType << std::endl;
-        std::cout << "  ├─ Number of doors: " << numberOfDoors << std::endl;
-        if (trunkCapacity > 0) {
-            std::cout << "  └─ Trunk capacity: " << trunkCapacity << " liters" << std::endl;
+        snapshot->source = "shm:" + name + " v" + std::to_string(snapshot->publishedVersion);
+        if (!snapshot->readSharedImage(snapshot->file.contents(), error)) {
+            return nullptr;
         }
+        snapshot->view = {snapshot->vehicles, snapshot->engines, snapshot->equipment, snapshot->colors};
+        return snapshot;
     }
 };
-// Class for motorcycles
-class Motorcycle : public Vehicle {
+
+// Publishes the current catalog snapshot. Readers take a reference with one atomic load and
+// keep pricing against it; a reload swaps the pointer and the old version is freed when its
+// last reader lets go (RCU style).
+class CatalogStore {
 private:
-    std::string type; // sport, cruiser, enduro, etc.
-    int engineDisplacement; // in cc
+    std::atomic<std::shared_ptr<const CatalogSnapshot>> current;
+    std::atomic<uint64_t> latestVersion{1};
+    std::jthread watcher;
+
+    void publish(std::shared_ptr<const CatalogSnapshot> snapshot) {
+        latestVersion.store(snapshot->getVersion());
+        current.store(std::move(snapshot), std::memory_order_release);
+    }
 
 public:
-    Motorcycle(const std::string& brand, const std::string& model, double basePrice,
-              const std::string& type, int engineDisplacement = 0,
-              const std::string& year = "2023")
-        : Vehicle(brand, model, basePrice, year), type(type), engineDisplacement(engineDisplacement) {
+    CatalogStore() : current(CatalogSnapshot::builtIn()) {}
 
-        // Enhanced ASCII visualization for motorcycle based on type
-        if (type == "Sport") {
-            asciiArt = {
-                "    ,_oo",
-                ".-/c-//:::",
-                "(_)'  \\\\:::",
-                "      `\\:::",
-                "       _\\::",
-                "      /  \\:",
-                "     /    \\",
-                "    (    0 )",
-                "     \\    /",
-                "      \\__/"
-            };
-        } else if (type == "Cruiser") {
-            asciiArt = {
-                "      ,_",
-                "  .-_-' `--'",
-                " /     o   \\",
-                "(_)/-(_)--(_)"
-            };
-        } else {
-            asciiArt = {
-                "    ,_oo",
-                ".-/c-//:::",
-                "(_)'  \\\\:::",
-                "      `\\:::"
-            };
-        }
+    std::shared_ptr<const CatalogSnapshot> snapshot() const {
+        return current.load(std::memory_order_acquire);
     }
 
-    std::string getType() const { return type; }
-    int getEngineDisplacement() const { return engineDisplacement; }
+    // Loads a catalog file and publishes it as the next version
+    bool loadFile(const std::string& path, std::string& error) {
+        auto snapshot = CatalogSnapshot::loadFromFile(path, latestVersion.load() + 1, error);
+        if (!snapshot) {
+            return false;
+        }
+        publish(std::move(snapshot));
+        return true;
+    }
 
-    void displayInfo() const override {
-        Vehicle::displayInfo();
-        std::cout << COLOR_BOLD << "\nMotorcycle details:" << COLOR_RESET << std::endl;
-        std::cout << "  ├─ Type: " << type << std::endl;
-        if (engineDisplacement > 0) {
-            std::cout << "  └─ Engine displacement: " << engineDisplacement << " cc" << std::endl;
+    // Maps the catalog another process published in shared memory and publishes it as the next version
+    bool loadSharedCatalog(const std::string& name, std::string& error) {
+        auto snapshot = CatalogSnapshot::loadFromSharedMemory(name, latestVersion.load() + 1, error);
+        if (!snapshot) {
+            return false;
         }
+        publish(std::move(snapshot));
+        return true;
     }
-};
 
-// New class for electric vehicles
-class ElectricVehicle : public Vehicle {
-private:
-    int batteryCapacity; // in kWh
-    int range; // in km
-    int chargingTime; // in minutes (for fast charging)
+    // Polls the shared version number in the background and maps every newly published catalog
+    void watchSharedCatalog(const std::string& name,
+                            std::chrono::milliseconds interval = std::chrono::milliseconds(500)) {
+        watcher = std::jthread([this, name, interval](std::stop_token stopToken) {
+            std::mutex mutex;
+            std::condition_variable_any wakeUp;
+            while (!stopToken.stop_requested()) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wakeUp.wait_for(lock, stopToken, interval, [] { return false; });
+                }
+                if (stopToken.stop_requested()) break;
 
-public:
-    ElectricVehicle(const std::string& brand, const std::string& model, double basePrice,
-                    int batteryCapacity, int range, int chargingTime,
-                    const std::string& year = "2023")
-        : Vehicle(brand, model, basePrice, year),
-          batteryCapacity(batteryCapacity), range(range), chargingTime(chargingTime) {
+                uint64_t published = sharedCatalogVersion(name);
+                if (published == 0 || published == snapshot()->getPublishedVersion()) continue;
 
-        // ASCII art for electric vehicle
-        asciiArt = {
-            "      ____",
-            "    /|    \\",
-            "   / |     \\",
-            "  /__|______\\",
-            " |           |",
-            " |___________|",
-            " |_|       |_|",
-            "   ⚡       ⚡"
-        };
+                std::string error;
+                if (!loadSharedCatalog(name, error)) {
+                    std::cerr << COLOR_RED << "✗ Shared catalog update failed, keeping version "
+                              << snapshot()->getVersion() << ": " << error << COLOR_RESET << std::endl;
+                }
+            }
+        });
     }
 
-    int getBatteryCapacity() const { return batteryCapacity; }
-    int getRange() const { return range; }
-    int getChargingTime() const { return chargingTime; }
-
-    void displayInfo() const override {
-        Vehicle::displayInfo();
-        std::cout << COLOR_BOLD << "\nElectric vehicle details:" << COLOR_RESET << std::endl;
-        std::cout << "  ├─ Battery capacity: " << batteryCapacity << " kWh" << std::endl;
-        std::cout << "  ├─ Range: " << range << " km" << std::endl;
-        std::cout << "  └─ Fast charging time: " << chargingTime << " minutes" << std::endl;
+    // Polls the file in the background and publishes every valid change. Writers should write a
+    // temporary file and rename it into place. A file written in place is read only once its time and
+    // size have held for a whole interval, and dropped if it changes while being read, so a copy
+    // still in progress is not published half done.
+    void watchFile(const std::string& path, std::chrono::milliseconds interval = std::chrono::milliseconds(500)) {
+        watcher = std::jthread([this, path, interval](std::stop_token stopToken) {
+            std::error_code ec;
+            auto loadedWrite = std::filesystem::last_write_time(path, ec);
+            auto loadedSize = std::filesystem::file_size(path, ec);
+            auto seenWrite = loadedWrite;
+            auto seenSize = loadedSize;
+
+            std::mutex mutex;
+            std::condition_variable_any wakeUp;
+            while (!stopToken.stop_requested()) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wakeUp.wait_for(lock, stopToken, interval, [] { return false; });
+                }
+                if (stopToken.stop_requested()) break;
+
+                auto write = std::filesystem::last_write_time(path, ec);
+                if (ec) continue;
+                auto size = std::filesystem::file_size(path, ec);
+                if (ec) continue;
+                bool settled = write == seenWrite && size == seenSize;
+                seenWrite = write;
+                seenSize = size;
+                if (!settled || (write == loadedWrite && size == loadedSize)) continue;
+
+                std::string error;
+                auto next = CatalogSnapshot::loadFromFile(path, latestVersion.load() + 1, error);
+                // Written to while it was read: the next polls wait for it to settle again
+                auto writeAfter = std::filesystem::last_write_time(path, ec);
+                auto sizeAfter = std::filesystem::file_size(path, ec);
+                if (ec || writeAfter != write || sizeAfter != size) continue;
+
+                loadedWrite = write;
+                loadedSize = size;
+                if (!next) {
+                    std::cerr << COLOR_RED << "✗ Catalog reload failed, keeping version "
+                              << snapshot()->getVersion() << ": " << error << COLOR_RESET << std::endl;
+                    continue;
+                }
+                publish(std::move(next));
+            }
+        });
     }
 };
-// Class for configuring vehicles
-class VehicleConfigurator {
+
+// Hash lookups from names to catalog positions, for resolving orders and saved files in bulk.
+// Keys point into the catalog, so the index must not outlive its snapshot.
+class CatalogIndex {
 private:
-    std::vector<std::shared_ptr<Vehicle>> availableVehicles;
-    std::vector<std::shared_ptr<Engine>> availableEngines;
-    std::vector<Equipment> availableEquipment;
-    std::vector<std::string> availableColors;
-    std::shared_ptr<Vehicle> currentVehicle;
-    std::shared_ptr<Vehicle> comparisonVehicle; // For comparing configurations
+    std::unordered_map<std::string, size_t> vehicles; // "Brand Model"
+    std::unordered_map<std::string_view, size_t> engines;
+    std::unordered_map<std::string_view, size_t> equipment;
+    std::unordered_map<std::string_view, size_t> colors;
+
+    template <typename Map, typename Key>
+    static std::optional<size_t> find(const Map& map, const Key& key) {
+        auto it = map.find(key);
+        if (it == map.end()) return std::nullopt;
+        return it->second;
+    }
 
 public:
-    VehicleConfigurator() {
-        initializeData();
+    explicit CatalogIndex(const CatalogView& catalog) {
+        for (size_t i = 0; i < catalog.vehicles.size(); ++i) {
+            vehicles.emplace(std::string(catalog.vehicles[i].brand) + " " + std::string(catalog.vehicles[i].model), i);
+        }
+        for (size_t i = 0; i < catalog.engines.size(); ++i) engines.emplace(catalog.engines[i].name, i);
+        for (size_t i = 0; i < catalog.equipment.size(); ++i) equipment.emplace(catalog.equipment[i].name, i);
+        for (size_t i = 0; i < catalog.colors.size(); ++i) colors.emplace(catalog.colors[i], i);
     }
 
-    // Data initialization - available vehicles, engines, equipment, colors
-    void initializeData() {
-        // Adding available colors
-        availableColors = {"White", "Black", "Red", "Blue", "Silver", "Green", "Yellow", "Orange", "Purple", "Brown"};
-
-        // Adding available engines with more details
-        availableEngines.push_back(std::make_shared<Engine>("1.4 TSI", 1.4, 150, "Gasoline", 12000, 130, 6.5));
-        availableEngines.push_back(std::make_shared<Engine>("1.6 TDI", 1.6, 115, "Diesel", 15000, 110, 4.8));
-        availableEngines.push_back(std::make_shared<Engine>("2.0 TDI", 2.0, 190, "Diesel", 20000, 135, 5.2));
-        availableEngines.push_back(std::make_shared<Engine>("2.0 TSI", 2.0, 220, "Gasoline", 22000, 155, 7.1));
-        availableEngines.push_back(std::make_shared<Engine>("Electric Motor", 0.0, 204, "Electric", 30000, 0, 0.0));
-        availableEngines.push_back(std::make_shared<Engine>("Hybrid 1.8", 1.8, 180, "Hybrid", 25000, 95, 4.2));
-        availableEngines.push_back(std::make_shared<Engine>("3.0 V6", 3.0, 340, "Gasoline", 35000, 190, 9.8));
-        availableEngines.push_back(std::make_shared<Engine>("650cc Twin", 0.65, 75, "Gasoline", 8000, 90, 3.8));
-
-        // Adding available equipment with categories
-        availableEquipment.push_back(Equipment("Leather upholstery", "High-quality leather upholstery", 5000, EquipmentCategory::COMFORT));
-        availableEquipment.push_back(Equipment("Navigation system", "Advanced GPS navigation system", 3000, EquipmentCategory::MULTIMEDIA));
-        availableEquipment.push_back(Equipment("Panoramic roof", "Glass panoramic roof", 7000, EquipmentCategory::EXTERIOR));
-        availableEquipment.push_back(Equipment("Heated seats", "Heated front seats", 2000, EquipmentCategory::COMFORT));
-        availableEquipment.push_back(Equipment("Premium audio system", "Audio system with 12 speakers", 4500, EquipmentCategory::MULTIMEDIA));
-        availableEquipment.push_back(Equipment("Parking assistant", "Automatic parking assistant", 3500, EquipmentCategory::SAFETY));
-        availableEquipment.push_back(Equipment("Adaptive cruise control", "Cruise control with adaptive function", 4000, EquipmentCategory::SAFETY));
-        availableEquipment.push_back(Equipment("Backup camera", "HD camera with 360-degree view", 2500, EquipmentCategory::SAFETY));
-        availableEquipment.push_back(Equipment("Sport suspension", "Lowered sport suspension", 3800, EquipmentCategory::PERFORMANCE));
-        availableEquipment.push_back(Equipment("Alloy wheels 19\"", "19-inch alloy wheels", 4200, EquipmentCategory::EXTERIOR));
-        availableEquipment.push_back(Equipment("LED headlights", "Full LED headlights with dynamic turn signals", 3200, EquipmentCategory::EXTERIOR));
-        availableEquipment.push_back(Equipment("Sport exhaust", "Sport exhaust system with enhanced sound", 5500, EquipmentCategory::PERFORMANCE));
-        availableEquipment.push_back(Equipment("Wireless charging", "Wireless phone charging pad", 800, EquipmentCategory::MULTIMEDIA));
-        availableEquipment.push_back(Equipment("Head-up display", "Information projected onto windshield", 2800, EquipmentCategory::MULTIMEDIA));
-        availableEquipment.push_back(Equipment("Keyless entry", "Keyless entry and start system", 1500, EquipmentCategory::COMFORT));
-
-        // Adding available vehicles
-        availableVehicles.push_back(std::make_shared<Car>("Volkswagen", "Golf", 80000, 5, "Hatchback", 380, "2023"));
-        availableVehicles.push_back(std::make_shared<Car>("Audi", "A4", 150000, 4, "Sedan", 480, "2023"));
-        availableVehicles.push_back(std::make_shared<Car>("BMW", "X5", 250000, 5, "SUV", 650, "2023"));
-        availableVehicles.push_back(std::make_shared<Car>("Toyota", "Corolla", 90000, 4, "Sedan", 470, "2023"));
-        availableVehicles.push_back(std::make_shared<Car>("Mercedes-Benz", "C-Class", 170000, 4, "Sedan", 455, "2023"));
-        availableVehicles.push_back(std::make_shared<Car>("Ford", "Mustang", 220000, 2, "Coupe", 408, "2023"));
-        availableVehicles.push_back(std::make_shared<Motorcycle>("Yamaha", "MT-07", 35000, "Naked", 689, "2023"));
-        availableVehicles.push_back(std::make_shared<Motorcycle>("Honda", "CBR650R", 42000, "Sport", 649, "2023"));
-        availableVehicles.push_back(std::make_shared<Motorcycle>("Harley-Davidson", "Fat Boy", 85000, "Cruiser", 1868, "2023"));
-        availableVehicles.push_back(std::make_shared<ElectricVehicle>("Tesla", "Model 3", 180000, 75, 560, 30, "2023"));
-        availableVehicles.push_back(std::make_shared<ElectricVehicle>("Nissan", "Leaf", 120000, 62, 385, 40, "2023"));
-    }
-    // Displaying available vehicles with improved formatting
-    void displayAvailableVehicles() const {
-        printHeader("Available Vehicles");
+    std::optional<size_t> findVehicle(const std::string& brandAndModel) const { return find(vehicles, brandAndModel); }
+    std::optional<size_t> findEngine(std::string_view name) const { return find(engines, name); }
+    std::optional<size_t> findEquipment(std::string_view name) const { return find(equipment, name); }
+    std::optional<size_t> findColor(std::string_view name) const { return find(colors, name); }
+};
+// Class representing equipment option
+class Equipment {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
 
-        // Group vehicles by type
-        std::map<std::string, std::vector<std::shared_ptr<Vehicle>>> vehiclesByType;
-
-        for (const auto& vehicle : availableVehicles) {
-            std::string type;
-            if (std::dynamic_pointer_cast<Car>(vehicle)) {
-                type = "Cars";
-            } else if (std::dynamic_pointer_cast<Motorcycle>(vehicle)) {
-                type = "Motorcycles";
-            } else if (std::dynamic_pointer_cast<ElectricVehicle>(vehicle)) {
-                type = "Electric Vehicles";
-            } else {
-                type = "Other";
-            }
-            vehiclesByType[type].push_back(vehicle);
-        }
+private:
+    std::pmr::string name;
+    std::pmr::string description;
+    double price;
+    EquipmentCategory category;
 
-        size_t index = 1;
-        for (const auto& typePair : vehiclesByType) {
-            std::cout << COLOR_YELLOW << "\n" << typePair.first << ":" << COLOR_RESET << std::endl;
+public:
+    Equipment(std::string_view name, std::string_view description, double price, EquipmentCategory category,
+              allocator_type alloc = {})
+        : name(name, alloc), description(description, alloc), price(price), category(category) {}
+
+    Equipment(const Equipment& other) = default;
+    Equipment(Equipment&& other) = default;
+    Equipment& operator=(const Equipment& other) = default;
+    Equipment& operator=(Equipment&& other) = default;
+
+    // Allocator-extended copies, used when equipment is stored in a session or batch arena
+    Equipment(const Equipment& other, allocator_type alloc)
+        : name(other.name, alloc), description(other.description, alloc),
+          price(other.price), category(other.category) {}
+    Equipment(Equipment&& other, allocator_type alloc)
+        : name(std::move(other.name), alloc), description(std::move(other.description), alloc),
+          price(other.price), category(other.category) {}
+
+    std::string getName() const { return std::string(name); }
+    std::string getDescription() const { return std::string(description); }
+    double getPrice() const { return price; }
+    EquipmentCategory getCategory() const { return category; }
+    bool hasName(std::string_view other) const { return name == other; }
+};
 
-            for (const auto& vehicle : typePair.second) {
-                std::cout << COLOR_CYAN << " [" << index << "] " << COLOR_RESET;
-                std::cout << vehicle->getBrand() << " " << vehicle->getModel() << " (" << vehicle->getYear() << ") - ";
-                std::cout << formatPrice(vehicle->getBasePrice()) << std::endl;
-                index++;
-            }
-        }
-    }
+// Groups equipment by category without copying the items
+using EquipmentGroups = std::pmr::map<EquipmentCategory, std::pmr::vector<const Equipment*>>;
 
-    // Vehicle selection with improved feedback
-    bool selectVehicle(size_t index) {
-        if (index >= 1 && index <= availableVehicles.size()) {
-            currentVehicle = availableVehicles[index - 1];
-            showLoadingAnimation("Selecting vehicle");
-            std::cout << COLOR_GREEN << "✓ You've selected: " << currentVehicle->getBrand() << " "
-                      << currentVehicle->getModel() << COLOR_RESET << std::endl;
-            return true;
-        }
-        std::cout << COLOR_RED << "✗ Invalid selection. Please try again." << COLOR_RESET << std::endl;
-        return false;
+template <typename EquipmentRange>
+EquipmentGroups groupEquipmentByCategory(const EquipmentRange& equipment, std::pmr::memory_resource* resource) {
+    EquipmentGroups groups(resource);
+    for (const auto& item : equipment) {
+        groups[item.getCategory()].push_back(&item);
     }
+    return groups;
+}
 
-    // Displaying available engines with improved formatting
-    void displayAvailableEngines() const {
-        printHeader("Available Engines");
-
-        // Group engines by fuel type
-        std::map<std::string, std::vector<std::shared_ptr<Engine>>> enginesByFuelType;
-
-        for (const auto& engine : availableEngines) {
-            enginesByFuelType[engine->getFuelType()].push_back(engine);
-        }
+// Class representing engine
+class Engine {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
 
-        size_t index = 1;
-        for (const auto& typePair : enginesByFuelType) {
-            std::cout << COLOR_YELLOW << "\n" << typePair.first << " engines:" << COLOR_RESET << std::endl;
+private:
+    std::pmr::string name;
+    double capacity;
+    int horsePower;
+    std::pmr::string fuelType;
+    double price;
+    int co2Emissions; // Added CO2 emissions in g/km
+    double fuelConsumption; // Added fuel consumption in l/100km
 
-            for (const auto& engine : typePair.second) {
-                std::cout << COLOR_CYAN << " [" << index << "] " << COLOR_RESET;
-                std::cout << engine->getName() << " (" << engine->getCapacity() << "L, "
-                          << engine->getHorsePower() << " HP) - " << formatPrice(engine->getPrice());
+public:
+    Engine(std::string_view name, double capacity, int horsePower,
+           std::string_view fuelType, double price, int co2Emissions = 0, double fuelConsumption = 0.0,
+           allocator_type alloc = {})
+        : name(name, alloc), capacity(capacity), horsePower(horsePower),
+          fuelType(fuelType, alloc), price(price), co2Emissions(co2Emissions), fuelConsumption(fuelConsumption) {}
 
-                if (engine->getCO2Emissions() > 0) {
-                    std::cout << " - " << engine->getCO2Emissions() << " g/km CO2";
-                }
+    Engine(const Engine& other) = default;
 
-                if (engine->getFuelConsumption() > 0) {
-                    std::cout << " - " << engine->getFuelConsumption() << " l/100km";
-                }
+    // Allocator-extended copy
+    Engine(const Engine& other, allocator_type alloc)
+        : name(other.name, alloc), capacity(other.capacity), horsePower(other.horsePower),
+          fuelType(other.fuelType, alloc), price(other.price), co2Emissions(other.co2Emissions),
+          fuelConsumption(other.fuelConsumption) {}
 
-                std::cout << std::endl;
-                index++;
-            }
-        }
-    }
-    // Engine selection with improved feedback
-    bool selectEngine(size_t index) {
-        if (currentVehicle && index >= 1 && index <= availableEngines.size()) {
-            currentVehicle->setEngine(availableEngines[index - 1]);
-            showLoadingAnimation("Installing engine");
-            std::cout << COLOR_GREEN << "✓ Engine selected: " << availableEngines[index - 1]->getName() << COLOR_RESET << std::endl;
-            return true;
-        }
-        std::cout << COLOR_RED << "✗ Invalid selection. Please try again." << COLOR_RESET << std::endl;
-        return false;
+    std::string getName() const { return std::string(name); }
+    double getCapacity() const { return capacity; }
+    int getHorsePower() const { return horsePower; }
+    std::string getFuelType() const { return std::string(fuelType); }
+    double getPrice() const { return price; }
+    int getCO2Emissions() const { return co2Emissions; }
+    double getFuelConsumption() const { return fuelConsumption; }
+};
+// Flat percentage off a price; the pricing plan applies it after bundles and category discounts
+double discountedPrice(double listPrice, double discountPercent) {
+    if (discountPercent > 0) {
+        return listPrice * (1.0 - discountPercent / 100.0);
     }
+    return listPrice;
+}
 
-    // Displaying available equipment with improved formatting
-    void displayAvailableEquipment() const {
-        printHeader("Available Equipment");
+// Price of a configuration rule by rule, as evaluated by a PricingPlan
+struct PriceBreakdown {
+    double listPrice = 0.0;
+    double bundleSavings = 0.0;
+    double categorySavings = 0.0;
+    double discountAmount = 0.0;
+    double volumeSavings = 0.0;
+    double unitNet = 0.0;
+    double unitVat = 0.0;
+    double unitGross = 0.0;
+    double totalGross = 0.0;
+};
 
-        // Group equipment by category
-        std::map<EquipmentCategory, std::vector<Equipment>> equipmentByCategory;
+class PricingPlan;
 
-        for (const auto& equipment : availableEquipment) {
-            equipmentByCategory[equipment.getCategory()].push_back(equipment);
-        }
+// Destination for structured report content (HTML, PDF, ...)
+class ReportSink {
+public:
+    virtual ~ReportSink() = default;
 
-        size_t index = 1;
-        for (const auto& categoryPair : equipmentByCategory) {
-            std::cout << COLOR_YELLOW << "\n" << categoryToString(categoryPair.first) << ":" << COLOR_RESET << std::endl;
+    virtual void title(const std::string& text) = 0;
+    virtual void section(const std::string& text) = 0;
+    virtual void field(const std::string& label, const std::string& value) = 0;
+    virtual void note(const std::string& text) = 0;
+    virtual void total(const std::string& label, const std::string& value) = 0;
 
-            for (const auto& equipment : categoryPair.second) {
-                std::cout << COLOR_CYAN << " [" << index << "] " << COLOR_RESET;
-                std::cout << equipment.getName() << " - " << equipment.getDescription()
-                          << " - " << formatPrice(equipment.getPrice()) << std::endl;
-                index++;
-            }
-        }
+    // Completes the document; returns false if anything failed to write
+    virtual bool finish() = 0;
+};
+
+// Parts of a configuration that can change between saves, as bits of a change mask
+constexpr uint8_t CHANGED_VEHICLE = 1 << 0; // Vehicle or color
+constexpr uint8_t CHANGED_ENGINE = 1 << 1;
+constexpr uint8_t CHANGED_EQUIPMENT = 1 << 2;
+constexpr uint8_t CHANGED_DISCOUNT = 1 << 3;
+
+std::string describeChanges(uint8_t changes) {
+    static constexpr std::pair<uint8_t, const char*> names[] = {
+        {CHANGED_VEHICLE, "vehicle"}, {CHANGED_ENGINE, "engine"},
+        {CHANGED_EQUIPMENT, "equipment"}, {CHANGED_DISCOUNT, "discount"}};
+    std::string text;
+    for (const auto& [bit, name] : names) {
+        if (changes & bit) text += (text.empty() ? "" : ", ") + std::string(name);
     }
+    return text;
+}
 
-    // Adding equipment with improved feedback
-    bool addEquipment(size_t index) {
-        if (currentVehicle && index >= 1 && index <= availableEquipment.size()) {
-            currentVehicle->addEquipment(availableEquipment[index - 1]);
-            return true;
-        }
-        std::cout << COLOR_RED << "✗ Invalid selection. Please try again." << COLOR_RESET << std::endl;
-        return false;
-    }
+// Base class for all vehicles
+class Vehicle {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
 
-    // Displaying available colors with improved formatting
-    void displayAvailableColors() const {
-        printHeader("Available Colors");
+protected:
+    std::pmr::string brand;
+    std::pmr::string model;
+    double basePrice;
+    std::shared_ptr<Engine> engine;
+    std::pmr::vector<Equipment> selectedEquipment;
+    std::pmr::string color;
+    std::pmr::string year;
+    double discount; // Percentage discount
 
-        for (size_t i = 0; i < availableColors.size(); ++i) {
-            std::string colorCode;
-            if (availableColors[i] == "Red") colorCode = COLOR_RED;
-            else if (availableColors[i] == "Blue") colorCode = COLOR_BLUE;
-            else if (availableColors[i] == "Green") colorCode = COLOR_GREEN;
-            else if (availableColors[i] == "Yellow") colorCode = COLOR_YELLOW;
-            else if (availableColors[i] == "Black") colorCode = COLOR_BOLD;
-            else colorCode = COLOR_WHITE;
+    // ASCII art for visualization, pointing into the static art tables
+    std::span<const std::string_view> asciiArt;
 
-            std::cout << COLOR_CYAN << " [" << i + 1 << "] " << COLOR_RESET
-                      << colorCode << "■ " << availableColors[i] << COLOR_RESET << std::endl;
-        }
+    // Rules the total is priced with; a vehicle without a plan is priced at list price minus the discount
+    std::shared_ptr<const PricingPlan> pricingPlan;
+
+    // What changed since the configuration was last saved or loaded, and a counter of all changes
+    uint8_t unsavedChanges = CHANGED_VEHICLE;
+    uint64_t revision = 0;
+
+    void markChanged(uint8_t section) {
+        unsavedChanges |= section;
+        ++revision;
     }
-    // Color selection with improved feedback
-    bool selectColor(size_t index) {
-        if (currentVehicle && index >= 1 && index <= availableColors.size()) {
-            currentVehicle->setColor(availableColors[index - 1]);
-            showLoadingAnimation("Applying paint");
-            std::cout << COLOR_GREEN << "✓ Color selected: " << availableColors[index - 1] << COLOR_RESET << std::endl;
-            return true;
-        }
-        std::cout << COLOR_RED << "✗ Invalid selection. Please try again." << COLOR_RESET << std::endl;
-        return false;
+
+public:
+    Vehicle(std::string_view brand, std::string_view model, double basePrice, std::string_view year = "2023",
+            allocator_type alloc = {})
+        : brand(brand, alloc), model(model, alloc), basePrice(basePrice), selectedEquipment(alloc),
+          color("White", alloc), year(year, alloc), discount(0.0) {}
+
+    // Allocator-extended copy, used to give each session or batch job its own vehicle
+    Vehicle(const Vehicle& other, allocator_type alloc)
+        : brand(other.brand, alloc), model(other.model, alloc), basePrice(other.basePrice), engine(other.engine),
+          selectedEquipment(other.selectedEquipment, alloc), color(other.color, alloc), year(other.year, alloc),
+          discount(other.discount), asciiArt(other.asciiArt), pricingPlan(other.pricingPlan),
+          unsavedChanges(other.unsavedChanges), revision(other.revision) {}
+
+    virtual ~Vehicle() = default;
+
+    // Copies the vehicle, including its control block, into the given memory resource
+    virtual std::shared_ptr<Vehicle> clone(allocator_type alloc) const {
+        return std::allocate_shared<Vehicle>(alloc, *this);
     }
 
-    // Apply discount
-    bool applyDiscount(double discountPercent) {
-        if (currentVehicle && discountPercent >= 0 && discountPercent <= 30) {
-            currentVehicle->setDiscount(discountPercent);
-            showLoadingAnimation("Applying discount");
-            std::cout << COLOR_GREEN << "✓ " << discountPercent << "% discount applied!" << COLOR_RESET << std::endl;
-            return true;
-        }
-        std::cout << COLOR_RED << "✗ Invalid discount. Maximum allowed discount is 30%." << COLOR_RESET << std::endl;
-        return false;
+    // Getters
+    std::string getBrand() const { return std::string(brand); }
+    std::string getModel() const { return std::string(model); }
+    double getBasePrice() const { return basePrice; }
+    std::string getColor() const { return std::string(color); }
+    std::string getYear() const { return std::string(year); }
+    double getDiscount() const { return discount; }
+    const std::pmr::vector<Equipment>& getSelectedEquipment() const { return selectedEquipment; } // Added accessor
+    const std::shared_ptr<Engine>& getEngine() const { return engine; }
+    uint8_t getUnsavedChanges() const { return unsavedChanges; }
+    uint64_t getRevision() const { return revision; }
+    void markSaved() { unsavedChanges = 0; }
+    const std::shared_ptr<const PricingPlan>& getPricingPlan() const { return pricingPlan; }
+    void setPricingPlan(std::shared_ptr<const PricingPlan> plan) { pricingPlan = std::move(plan); }
+
+    // Setters
+    void setEngine(std::shared_ptr<Engine> newEngine) {
+        engine = newEngine;
+        markChanged(CHANGED_ENGINE);
+    }
+    void setColor(std::string_view newColor) {
+        if (color == newColor) return;
+        color = newColor;
+        markChanged(CHANGED_VEHICLE);
+    }
+    void setDiscount(double newDiscount) {
+        if (discount == newDiscount) return;
+        discount = newDiscount;
+        markChanged(CHANGED_DISCOUNT);
     }
 
-    // Displaying current configuration
-    void displayCurrentConfiguration() const {
-        if (currentVehicle) {
-            clearScreen();
-            currentVehicle->displayInfo();
-            std::cout << "\nPress Enter to continue...";
-            std::cin.ignore();
-            std::cin.get();
-        } else {
-            std::cout << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+    // Adding catalog equipment without console feedback; returns false if it is already present
+    bool attachEquipment(const EquipmentRecord& equipment) {
+        auto it = std::find_if(selectedEquipment.begin(), selectedEquipment.end(),
+            [&equipment](const Equipment& e) { return e.hasName(equipment.name); });
+
+        if (it != selectedEquipment.end()) {
+            return false;
         }
+        // The vector's allocator is passed on to the new item by uses-allocator construction
+        selectedEquipment.emplace_back(equipment.name, equipment.description, equipment.price, equipment.category);
+        markChanged(CHANGED_EQUIPMENT);
+        return true;
     }
 
-    // Visualizing current configuration
-    void visualizeCurrentConfiguration() const {
-        if (currentVehicle) {
-            currentVehicle->visualize();
+    // Adding equipment
+    void addEquipment(const EquipmentRecord& equipment) {
+        if (attachEquipment(equipment)) {
+            console() << COLOR_GREEN << "✓ " << equipment.name << " added to configuration." << COLOR_RESET << std::endl;
         } else {
-            std::cout << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+            console() << COLOR_YELLOW << "! " << equipment.name << " is already in your configuration." << COLOR_RESET << std::endl;
         }
     }
 
-    // Save current configuration as comparison vehicle
-    void saveForComparison() {
-        if (currentVehicle) {
-            comparisonVehicle = currentVehicle;
-            std::cout << COLOR_GREEN << "✓ Current configuration saved for comparison." << COLOR_RESET << std::endl;
+    // Removing equipment
+    void removeEquipment(const std::string& name) {
+        auto it = std::find_if(selectedEquipment.begin(), selectedEquipment.end(),
+            [&name](const Equipment& e) { return e.hasName(name); });
+
+        if (it != selectedEquipment.end()) {
+            selectedEquipment.erase(it);
+            markChanged(CHANGED_EQUIPMENT);
+            console() << COLOR_RED << "✓ " << name << " removed from configuration." << COLOR_RESET << std::endl;
         } else {
-            std::cout << COLOR_YELLOW << "! No vehicle selected to save for comparison." << COLOR_RESET << std::endl;
+            console() << COLOR_YELLOW << "! " << name << " is not in your configuration." << COLOR_RESET << std::endl;
         }
     }
-    // Compare current configuration with saved one
-    void compareConfigurations() const {
-        if (!currentVehicle) {
-            std::cout << COLOR_YELLOW << "! No current vehicle selected for comparison." << COLOR_RESET << std::endl;
-            return;
-        }
 
-        if (!comparisonVehicle) {
-            std::cout << COLOR_YELLOW << "! No vehicle saved for comparison." << COLOR_RESET << std::endl;
-            return;
-        }
+    // Price of one unit with the plan's bundles, category discounts, the discount and VAT (defined after PricingPlan)
+    PriceBreakdown calculatePrice() const;
 
-        clearScreen();
-        printHeader("Configuration Comparison");
+    // Total price a customer pays for this configuration: gross with a plan, list minus discount without
+    virtual double calculateTotalPrice() const { return calculatePrice().unitGross; }
 
-        // Basic vehicle info
-        std::cout << std::setw(30) << "Feature" << " | "
-                  << std::setw(30) << "Current Configuration" << " | "
-                  << std::setw(30) << "Saved Configuration" << std::endl;
-        std::cout << std::string(95, '-') << std::endl;
+    // Displaying vehicle information
+    virtual void displayInfo() const {
+        printHeader(getBrand() + " " + getModel() + " (" + getYear() + ")");
 
-        std::cout << std::setw(30) << "Vehicle" << " | "
-                  << std::setw(30) << (currentVehicle->getBrand() + " " + currentVehicle->getModel()) << " | "
-                  << std::setw(30) << (comparisonVehicle->getBrand() + " " + comparisonVehicle->getModel()) << std::endl;
+        console() << COLOR_BOLD << "Color: " << COLOR_RESET << color << std::endl;
+        console() << COLOR_BOLD << "Base price: " << COLOR_RESET << formatPrice(basePrice) << std::endl;
 
-        std::cout << std::setw(30) << "Color" << " | "
-                  << std::setw(30) << currentVehicle->getColor() << " | "
-                  << std::setw(30) << comparisonVehicle->getColor() << std::endl;
+        if (engine) {
+            console() << COLOR_BOLD << "\nEngine: " << COLOR_RESET << engine->getName() << std::endl;
+            console() << "  ├─ Capacity: " << engine->getCapacity() << "L" << std::endl;
+            console() << "  ├─ Power: " << engine->getHorsePower() << " HP" << std::endl;
+            console() << "  ├─ Fuel type: " << engine->getFuelType() << std::endl;
 
-        std::cout << std::setw(30) << "Base Price" << " | "
-                  << std::setw(30) << formatPrice(currentVehicle->getBasePrice()) << " | "
-                  << std::setw(30) << formatPrice(comparisonVehicle->getBasePrice()) << std::endl;
+            if (engine->getCO2Emissions() > 0) {
+                console() << "  ├─ CO2 emissions: " << engine->getCO2Emissions() << " g/km" << std::endl;
+            }
 
-        // Engine comparison
-        std::string currentEngineName = "No engine selected";
-        std::string savedEngineName = "No engine selected";
+            if (engine->getFuelConsumption() > 0) {
+                console() << "  ├─ Fuel consumption: " << engine->getFuelConsumption() << " l/100km" << std::endl;
+            }
 
-        if (currentVehicle->calculateTotalPrice() > currentVehicle->getBasePrice()) {
-            currentEngineName = "Engine selected";
+            console() << "  └─ Price: " << formatPrice(engine->getPrice()) << std::endl;
         }
 
-        if (comparisonVehicle->calculateTotalPrice() > comparisonVehicle->getBasePrice()) {
-            savedEngineName = "Engine selected";
-        }
+        if (!selectedEquipment.empty()) {
+            console() << COLOR_BOLD << "\nSelected equipment:" << COLOR_RESET << std::endl;
 
-        std::cout << std::setw(30) << "Engine" << " | "
-                  << std::setw(30) << currentEngineName << " | "
-                  << std::setw(30) << savedEngineName << std::endl;
+            // Group equipment by category in a stack-backed scratch arena
+            std::array<std::byte, 2048> scratchBuffer;
+            std::pmr::monotonic_buffer_resource scratch(scratchBuffer.data(), scratchBuffer.size());
+            EquipmentGroups equipmentByCategory = groupEquipmentByCategory(selectedEquipment, &scratch);
 
-        // Total price comparison
-        std::cout << std::string(95, '-') << std::endl;
-        std::cout << std::setw(30) << "Total Price" << " | "
-                  << std::setw(30) << formatPrice(currentVehicle->calculateTotalPrice()) << " | "
-                  << std::setw(30) << formatPrice(comparisonVehicle->calculateTotalPrice()) << std::endl;
+            for (const auto& categoryPair : equipmentByCategory) {
+                console() << COLOR_YELLOW << "  " << categoryToString(categoryPair.first) << ":" << COLOR_RESET << std::endl;
 
-        // Price difference
-        double priceDifference = currentVehicle->calculateTotalPrice() - comparisonVehicle->calculateTotalPrice();
-        std::string differenceText = (priceDifference >= 0 ? "+" : "") + formatPrice(priceDifference);
+                double categoryTotal = 0.0;
+                for (const Equipment* equipment : categoryPair.second) {
+                    console() << "    ├─ " << equipment->getName() << ": " << formatPrice(equipment->getPrice()) << std::endl;
+                    console() << "    │  " << equipment->getDescription() << std::endl;
+                    categoryTotal += equipment->getPrice();
+                }
+                console() << "    └─ " << COLOR_BOLD << "Category total: " << formatPrice(categoryTotal) << COLOR_RESET << std::endl;
+            }
+        }
 
-        std::cout << std::setw(30) << "Price Difference" << " | "
-                  << std::setw(30) << differenceText << " | "
-                  << std::setw(30) << "" << std::endl;
+        PriceBreakdown price = calculatePrice();
+        double packageSavings = price.bundleSavings + price.categorySavings;
+        if (packageSavings > 0) {
+            console() << COLOR_BOLD << "\nPackage savings: " << COLOR_RESET << "-" << formatPrice(packageSavings) << std::endl;
+        }
+        if (discount > 0) {
+            console() << COLOR_BOLD << "\nDiscount: " << COLOR_RESET << discount << "% (" << formatPrice(price.discountAmount) << ")" << std::endl;
+        }
+        if (price.unitVat > 0) {
+            console() << COLOR_BOLD << "VAT: " << COLOR_RESET << formatPrice(price.unitVat) << std::endl;
+        }
 
-        std::cout << "\nPress Enter to continue...";
-        std::cin.ignore();
-        std::cin.get();
+        console() << COLOR_BOLD << COLOR_GREEN << "\nTotal price: " << formatPrice(price.unitGross) << COLOR_RESET << std::endl;
     }
-    // Saving configuration to file
-    void saveConfiguration(const std::string& filename) const {
-        if (currentVehicle) {
-            // Create configs directory if it doesn't exist
-            std::filesystem::path dirPath = "configs";
-            if (!std::filesystem::exists(dirPath)) {
-                std::filesystem::create_directory(dirPath);
-            }
 
-            std::string fullPath = filename;
-            if (fullPath.find("configs/") == std::string::npos) {
-                fullPath = "configs/" + fullPath;
+    // Writing the displayInfo content to a report
+    virtual void writeReport(ReportSink& report) const {
+        report.title(getBrand() + " " + getModel() + " (" + getYear() + ")");
+        report.field("Color", getColor());
+        report.field("Base price", formatPrice(basePrice));
+
+        if (engine) {
+            report.section("Engine: " + engine->getName());
+            report.field("Capacity", formatNumber(engine->getCapacity()) + "L");
+            report.field("Power", std::to_string(engine->getHorsePower()) + " HP");
+            report.field("Fuel type", engine->getFuelType());
+            if (engine->getCO2Emissions() > 0) {
+                report.field("CO2 emissions", std::to_string(engine->getCO2Emissions()) + " g/km");
+            }
+            if (engine->getFuelConsumption() > 0) {
+                report.field("Fuel consumption", formatNumber(engine->getFuelConsumption()) + " l/100km");
             }
+            report.field("Price", formatPrice(engine->getPrice()));
+        }
 
-            if (fullPath.find(".txt") == std::string::npos) {
-                fullPath += ".txt";
+        std::array<std::byte, 2048> scratchBuffer;
+        std::pmr::monotonic_buffer_resource scratch(scratchBuffer.data(), scratchBuffer.size());
+        for (const auto& categoryPair : groupEquipmentByCategory(selectedEquipment, &scratch)) {
+            report.section(categoryToString(categoryPair.first) + " equipment");
+
+            double categoryTotal = 0.0;
+            for (const Equipment* equipment : categoryPair.second) {
+                report.field(equipment->getName(), formatPrice(equipment->getPrice()));
+                report.note(equipment->getDescription());
+                categoryTotal += equipment->getPrice();
             }
+            report.total("Category total", formatPrice(categoryTotal));
+        }
 
-            currentVehicle->saveToFile(fullPath);
-        } else {
-            std::cout << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+        report.section("Summary");
+        PriceBreakdown price = calculatePrice();
+        double packageSavings = price.bundleSavings + price.categorySavings;
+        if (packageSavings > 0) {
+            report.field("Package savings", "-" + formatPrice(packageSavings));
+        }
+        if (discount > 0) {
+            report.field("Discount", formatNumber(discount) + "% (" + formatPrice(price.discountAmount) + ")");
         }
+        if (price.unitVat > 0) {
+            report.field("VAT", formatPrice(price.unitVat));
+        }
+        report.total("Total price", formatPrice(price.unitGross));
     }
 
-    // Loading configuration from file with better error handling
-    bool loadConfiguration(const std::string& filename) {
-        std::string fullPath = filename;
-        if (fullPath.find("configs/") == std::string::npos) {
-            fullPath = "configs/" + fullPath;
+    // Vehicle visualization
+    virtual void visualize() const {
+        clearScreen();
+        printHeader("Visualization of " + getBrand() + " " + getModel() + " in " + getColor() + " color");
+
+        // Apply color to ASCII art
+        std::string colorCode;
+        if (color == "Red") colorCode = COLOR_RED;
+        else if (color == "Blue") colorCode = COLOR_BLUE;
+        else if (color == "Green") colorCode = COLOR_GREEN;
+        else if (color == "Yellow") colorCode = COLOR_YELLOW;
+        else if (color == "Black") colorCode = COLOR_BOLD;
+        else colorCode = COLOR_WHITE; // Default for other colors
+
+        for (const auto& line : asciiArt) {
+            console() << colorCode << line << COLOR_RESET << std::endl;
         }
 
-        if (fullPath.find(".txt") == std::string::npos) {
-            fullPath += ".txt";
+        pauseForEnter();
+    }
+    // Saving configuration to file
+    virtual void saveToFile(const std::string& filename) const {
+        // Create directory if it doesn't exist
+        std::filesystem::path dirPath = "configs";
+        if (!std::filesystem::exists(dirPath)) {
+            std::filesystem::create_directory(dirPath);
         }
 
-        std::ifstream file(fullPath);
+        std::ofstream file(filename);
         if (!file.is_open()) {
-            std::cerr << COLOR_RED << "✗ Cannot open file: " << fullPath << COLOR_RESET << std::endl;
-            return false;
+            consoleErrors() << COLOR_RED << "Cannot open file for writing: " << filename << COLOR_RESET << std::endl;
+            return;
         }
 
-        showLoadingAnimation("Loading configuration from " + fullPath);
+        writeConfiguration(file);
+        file.close();
+        console() << COLOR_GREEN << "✓ Configuration saved to " << filename << COLOR_RESET << std::endl;
+    }
 
-        std::string line, version;
+    // Writes the configuration in the saved file format
+    void writeConfiguration(std::ostream& file) const {
+        file << "VEHICLE_CONFIGURATION\n";
+        file << "VERSION 2.0\n";
+        file << "DATE " << getCurrentDateTime() << "\n\n";
 
-        // Read header
-        std::getline(file, line); // VEHICLE_CONFIGURATION
-        std::getline(file, version); // VERSION x.x
-        std::getline(file, line); // DATE
-        std::getline(file, line); // Empty line
+        file << "[VEHICLE]\n";
+        file << "BRAND=" << brand << "\n";
+        file << "MODEL=" << model << "\n";
+        file << "YEAR=" << year << "\n";
+        file << "BASE_PRICE=" << basePrice << "\n";
+        file << "COLOR=" << color << "\n";
+        file << "DISCOUNT=" << discount << "\n\n";
 
-        // Read vehicle section
-        std::getline(file, line); // [VEHICLE]
+        if (engine) {
+            file << "[ENGINE]\n";
+            file << "NAME=" << engine->getName() << "\n";
+            file << "CAPACITY=" << engine->getCapacity() << "\n";
+            file << "HORSEPOWER=" << engine->getHorsePower() << "\n";
+            file << "FUEL_TYPE=" << engine->getFuelType() << "\n";
+            file << "PRICE=" << engine->getPrice() << "\n";
+            file << "CO2_EMISSIONS=" << engine->getCO2Emissions() << "\n";
+            file << "FUEL_CONSUMPTION=" << engine->getFuelConsumption() << "\n\n";
+        }
 
-        std::string brand, model, year, color;
-        double basePrice, discount;
+        file << "[EQUIPMENT]\n";
+        file << "COUNT=" << selectedEquipment.size() << "\n\n";
 
-        std::getline(file, line); // BRAND=xxx
-        brand = line.substr(line.find('=') + 1);
+        for (size_t i = 0; i < selectedEquipment.size(); ++i) {
+            file << "[EQUIPMENT_ITEM_" << i + 1 << "]\n";
+            file << "NAME=" << selectedEquipment[i].getName() << "\n";
+            file << "DESCRIPTION=" << selectedEquipment[i].getDescription() << "\n";
+            file << "PRICE=" << selectedEquipment[i].getPrice() << "\n";
+            file << "CATEGORY=" << static_cast<int>(selectedEquipment[i].getCategory()) << "\n\n";
+        }
 
-        std::getline(file, line); // MODEL=xxx
-        model = line.substr(line.find('=') + 1);
+        // With VAT the total is rarely a round number, so it is written to the cent
+        char total[32];
+        std::snprintf(total, sizeof(total), "%.2f", calculateTotalPrice());
+        file << "[SUMMARY]\n";
+        file << "TOTAL_PRICE=" << total << "\n";
+    }
 
-        std::getline(file, line); // YEAR=xxx
-        year = line.substr(line.find('=') + 1);
+    // Helper function to get current date and time
+    std::string getCurrentDateTime() const {
+        auto now = std::chrono::system_clock::now();
+        auto in_time_t = std::chrono::system_clock::to_time_t(now);
 
-        std::getline(file, line); // BASE_PRICE=xxx
-        basePrice = std::stod(line.substr(line.find('=') + 1));
+        // std::localtime returns a shared buffer, and saves run on several threads at once
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &in_time_t);
+#else
+        localtime_r(&in_time_t, &local);
+#endif
+        std::stringstream ss;
+        ss << std::put_time(&local, "%Y-%m-%d %H:%M:%S");
+        return ss.str();
+    }
+};
+// Static ASCII art shared by all vehicles
+constexpr std::string_view sedanArt[] = {
+    "          ______--------___",
+    "         /|             / |",
+    "        / |  ___      /   |",
+    "       /__|_/   \\____/    |",
+    "      |            |     _|",
+    "      |____________|____/",
+    "      |            |",
+    "      \\____________/",
+    "       O        O"
+};
 
-        std::getline(file, line); // COLOR=xxx
-        color = line.substr(line.find('=') + 1);
+constexpr std::string_view hatchbackArt[] = {
+    "         __---~~~~--__",
+    "       /|             \\",
+    "      / |  ___        |",
+    "     /__|_/   \\____   |",
+    "    |            |   _|",
+    "    |____________|__/",
+    "    |            |",
+    "    \\____________/",
+    "     O        O"
+};
 
-        std::getline(file, line); // DISCOUNT=xxx
-        discount = std::stod(line.substr(line.find('=') + 1));
+constexpr std::string_view suvArt[] = {
+    "         __---~~~~--__",
+    "       /|             \\",
+    "      / |  ___        |",
+    "     /__|_/   \\____   |",
+    "    |            |    |",
+    "    |            |    |",
+    "    |____________|____|",
+    "    |            |",
+    "    \\____________/",
+    "     O        O"
+};
 
-        // Find matching vehicle
-        bool foundVehicle = false;
-        for (size_t i = 0; i < availableVehicles.size(); ++i) {
-            if (availableVehicles[i]->getBrand() == brand &&
-                availableVehicles[i]->getModel() == model) {
-                currentVehicle = availableVehicles[i];
-                currentVehicle->setColor(color);
-                currentVehicle->setDiscount(discount);
-                foundVehicle = true;
-                break;
-            }
-        }
+constexpr std::string_view coupeArt[] = {
+    "    ____",
+    " __/  |_\\_",
+    "|  _     _`-.",
+    "'-(_)---(_)--'"
+};
 
-        if (!foundVehicle) {
-            std::cerr << COLOR_RED << "✗ No matching vehicle found in available vehicles." << COLOR_RESET << std::endl;
-            file.close();
-            return false;
-        }
-        // Skip empty line
-        std::getline(file, line);
+constexpr std::string_view sportBikeArt[] = {
+    "    ,_oo",
+    ".-/c-//:::",
+    "(_)'  \\\\:::",
+    "      `\\:::",
+    "       _\\::",
+    "      /  \\:",
+    "     /    \\",
+    "    (    0 )",
+    "     \\    /",
+    "      \\__/"
+};
 
-        // Read engine section
-        std::getline(file, line); // [ENGINE]
+constexpr std::string_view cruiserArt[] = {
+    "      ,_",
+    "  .-_-' `--'",
+    " /     o   \\",
+    "(_)/-(_)--(_)"
+};
 
-        std::string engineName, fuelType;
-        double capacity, enginePrice, fuelConsumption;
-        int horsePower, co2Emissions;
+constexpr std::string_view motorcycleArt[] = {
+    "    ,_oo",
+    ".-/c-//:::",
+    "(_)'  \\\\:::",
+    "      `\\:::"
+};
 
-        std::getline(file, line); // NAME=xxx
-        engineName = line.substr(line.find('=') + 1);
+constexpr std::string_view electricVehicleArt[] = {
+    "      ____",
+    "    /|    \\",
+    "   / |     \\",
+    "  /__|______\\",
+    " |           |",
+    " |___________|",
+    " |_|       |_|",
+    "   ⚡       ⚡"
+};
 
-        std::getline(file, line); // CAPACITY=xxx
-        capacity = std::stod(line.substr(line.find('=') + 1));
+// Class for passenger cars
+class Car : public Vehicle {
+private:
+    int numberOfDoors;
+    std::pmr::string bodyType; // sedan, hatchback, SUV, etc.
+    int trunkCapacity; // in liters
 
-        std::getline(file, line); // HORSEPOWER=xxx
-        horsePower = std::stoi(line.substr(line.find('=') + 1));
+public:
+    Car(std::string_view brand, std::string_view model, double basePrice,
+        int numberOfDoors, std::string_view bodyType, int trunkCapacity = 0,
+        std::string_view year = "2023", allocator_type alloc = {})
+        : Vehicle(brand, model, basePrice, year, alloc), numberOfDoors(numberOfDoors),
+          bodyType(bodyType, alloc), trunkCapacity(trunkCapacity) {
 
-        std::getline(file, line); // FUEL_TYPE=xxx
-        fuelType = line.substr(line.find('=') + 1);
+        // Enhanced ASCII visualization for car
+        if (bodyType == "Sedan") {
+            asciiArt = sedanArt;
+        } else if (bodyType == "Hatchback") {
+            asciiArt = hatchbackArt;
+        } else if (bodyType == "SUV") {
+            asciiArt = suvArt;
+        } else {
+            asciiArt = coupeArt;
+        }
+    }
 
-        std::getline(file, line); // PRICE=xxx
-        enginePrice = std::stod(line.substr(line.find('=') + 1));
+    Car(const Car& other, allocator_type alloc)
+        : Vehicle(other, alloc), numberOfDoors(other.numberOfDoors),
+          bodyType(other.bodyType, alloc), trunkCapacity(other.trunkCapacity) {}
 
-        std::getline(file, line); // CO2_EMISSIONS=xxx
-        co2Emissions = std::stoi(line.substr(line.find('=') + 1));
+    std::shared_ptr<Vehicle> clone(allocator_type alloc) const override {
+        return std::allocate_shared<Car>(alloc, *this);
+    }
 
-        std::getline(file, line); // FUEL_CONSUMPTION=xxx
-        fuelConsumption = std::stod(line.substr(line.find('=') + 1));
+    int getNumberOfDoors() const { return numberOfDoors; }
+    std::string getBodyType() const { return std::string(bodyType); }
+    int getTrunkCapacity() const { return trunkCapacity; }
 
-        // Find matching engine
-        bool foundEngine = false;
-        for (size_t i = 0; i < availableEngines.size(); ++i) {
-            if (availableEngines[i]->getName() == engineName) {
-                currentVehicle->setEngine(availableEngines[i]);
-                foundEngine = true;
-                break;
-            }
+    void displayInfo() const override {
+        Vehicle::displayInfo();
+        console() << COLOR_BOLD << "\nCar details:" << COLOR_RESET << std::endl;
+        console() << "  ├─ Body type: " << bodyType << std::endl;
+        console() << "  ├─ Number of doors: " << numberOfDoors << std::endl;
+        if (trunkCapacity > 0) {
+            console() << "  └─ Trunk capacity: " << trunkCapacity << " liters" << std::endl;
         }
+    }
 
-        if (!foundEngine) {
-            std::cout << COLOR_YELLOW << "! No matching engine found. Engine will not be configured." << COLOR_RESET << std::endl;
+    void writeReport(ReportSink& report) const override {
+        Vehicle::writeReport(report);
+        report.section("Car details");
+        report.field("Body type", getBodyType());
+        report.field("Number of doors", std::to_string(numberOfDoors));
+        if (trunkCapacity > 0) {
+            report.field("Trunk capacity", std::to_string(trunkCapacity) + " liters");
         }
+    }
+};
+// Class for motorcycles
+class Motorcycle : public Vehicle {
+private:
+    std::pmr::string type; // sport, cruiser, enduro, etc.
+    int engineDisplacement; // in cc
 
-        // Skip empty line
-        std::getline(file, line);
-
-        // Read equipment section
-        std::getline(file, line); // [EQUIPMENT]
-        std::getline(file, line); // COUNT=xxx
-        int equipmentCount = std::stoi(line.substr(line.find('=') + 1));
-
-        // Skip empty line
-        std::getline(file, line);
-
-        // Read each equipment item
-        for (int i = 0; i < equipmentCount; ++i) {
-            std::getline(file, line); // [EQUIPMENT_ITEM_x]
-
-            std::string equipmentName, equipmentDescription;
-            double equipmentPrice;
-            int categoryInt;
+public:
+    Motorcycle(std::string_view brand, std::string_view model, double basePrice,
+              std::string_view type, int engineDisplacement = 0,
+              std::string_view year = "2023", allocator_type alloc = {})
+        : Vehicle(brand, model, basePrice, year, alloc), type(type, alloc), engineDisplacement(engineDisplacement) {
 
-            std::getline(file, line); // NAME=xxx
-            equipmentName = line.substr(line.find('=') + 1);
+        // Enhanced ASCII visualization for motorcycle based on type
+        if (type == "Sport") {
+            asciiArt = sportBikeArt;
+        } else if (type == "Cruiser") {
+            asciiArt = cruiserArt;
+        } else {
+            asciiArt = motorcycleArt;
+        }
+    }
 
-            std::getline(file, line); // DESCRIPTION=xxx
-            equipmentDescription = line.substr(line.find('=') + 1);
+    Motorcycle(const Motorcycle& other, allocator_type alloc)
+        : Vehicle(other, alloc), type(other.type, alloc), engineDisplacement(other.engineDisplacement) {}
 
-            std::getline(file, line); // PRICE=xxx
-            equipmentPrice = std::stod(line.substr(line.find('=') + 1));
+    std::shared_ptr<Vehicle> clone(allocator_type alloc) const override {
+        return std::allocate_shared<Motorcycle>(alloc, *this);
+    }
 
-            std::getline(file, line); // CATEGORY=xxx
-            categoryInt = std::stoi(line.substr(line.find('=') + 1));
+    std::string getType() const { return std::string(type); }
+    int getEngineDisplacement() const { return engineDisplacement; }
 
-            // Find matching equipment
-            bool foundEquipment = false;
-            for (size_t j = 0; j < availableEquipment.size(); ++j) {
-                if (availableEquipment[j].getName() == equipmentName) {
-                    currentVehicle->addEquipment(availableEquipment[j]);
-                    foundEquipment = true;
-                    break;
-                }
-            }
-
-            if (!foundEquipment) {
-                std::cout << COLOR_YELLOW << "! No matching equipment found: " << equipmentName << COLOR_RESET << std::endl;
-            }
+    void displayInfo() const override {
+        Vehicle::displayInfo();
+        console() << COLOR_BOLD << "\nMotorcycle details:" << COLOR_RESET << std::endl;
+        console() << "  ├─ Type: " << type << std::endl;
+        if (engineDisplacement > 0) {
+            console() << "  └─ Engine displacement: " << engineDisplacement << " cc" << std::endl;
+        }
+    }
 
-            // Skip empty line
-            if (i < equipmentCount - 1) {
-                std::getline(file, line);
-            }
+    void writeReport(ReportSink& report) const override {
+        Vehicle::writeReport(report);
+        report.section("Motorcycle details");
+        report.field("Type", getType());
+        if (engineDisplacement > 0) {
+            report.field("Engine displacement", std::to_string(engineDisplacement) + " cc");
         }
+    }
+};
 
-        file.close();
-        std::cout << COLOR_GREEN << "✓ Configuration has been loaded from file: " << fullPath << COLOR_RESET << std::endl;
-        return true;
+// New class for electric vehicles
+class ElectricVehicle : public Vehicle {
+private:
+    int batteryCapacity; // in kWh
+    int range; // in km
+    int chargingTime; // in minutes (for fast charging)
+
+public:
+    ElectricVehicle(std::string_view brand, std::string_view model, double basePrice,
+                    int batteryCapacity, int range, int chargingTime,
+                    std::string_view year = "2023", allocator_type alloc = {})
+        : Vehicle(brand, model, basePrice, year, alloc),
+          batteryCapacity(batteryCapacity), range(range), chargingTime(chargingTime) {
+
+        // ASCII art for electric vehicle
+        asciiArt = electricVehicleArt;
     }
 
-    // Checking if vehicle has been selected
-    bool hasSelectedVehicle() const {
-        return currentVehicle != nullptr;
+    ElectricVehicle(const ElectricVehicle& other, allocator_type alloc)
+        : Vehicle(other, alloc), batteryCapacity(other.batteryCapacity),
+          range(other.range), chargingTime(other.chargingTime) {}
+
+    std::shared_ptr<Vehicle> clone(allocator_type alloc) const override {
+        return std::allocate_shared<ElectricVehicle>(alloc, *this);
     }
 
-    // Generate PDF report of the configuration (simulated)
-    void generateReport() const {
-        if (!currentVehicle) {
-            std::cout << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
-            return;
-        }
+    int getBatteryCapacity() const { return batteryCapacity; }
+    int getRange() const { return range; }
+    int getChargingTime() const { return chargingTime; }
 
-        std::string filename = currentVehicle->getBrand() + "_" + currentVehicle->getModel() + "_report.pdf";
-        showLoadingAnimation("Generating PDF report", 2);
-        std::cout << COLOR_GREEN << "✓ Report has been generated: " << filename << COLOR_RESET << std::endl;
-        std::cout << "  (This is a simulation - no actual PDF was created)" << std::endl;
+    void displayInfo() const override {
+        Vehicle::displayInfo();
+        console() << COLOR_BOLD << "\nElectric vehicle details:" << COLOR_RESET << std::endl;
+        console() << "  ├─ Battery capacity: " << batteryCapacity << " kWh" << std::endl;
+        console() << "  ├─ Range: " << range << " km" << std::endl;
+        console() << "  └─ Fast charging time: " << chargingTime << " minutes" << std::endl;
     }
-    // Show equipment by category
-    void displayEquipmentByCategory() const {
-        if (!currentVehicle) {
-            std::cout << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
-            return;
-        }
 
-        printHeader("Current Equipment by Category");
+    void writeReport(ReportSink& report) const override {
+        Vehicle::writeReport(report);
+        report.section("Electric vehicle details");
+        report.field("Battery capacity", std::to_string(batteryCapacity) + " kWh");
+        report.field("Range", std::to_string(range) + " km");
+        report.field("Fast charging time", std::to_string(chargingTime) + " minutes");
+    }
+};
+// Creates a vehicle from a catalog record in the given memory resource.
+// The allocator is passed on to the constructor by uses-allocator construction.
+std::shared_ptr<Vehicle> makeVehicle(const VehicleRecord& record, Vehicle::allocator_type alloc) {
+    switch (record.kind) {
+        case VehicleKind::CAR:
+            return std::allocate_shared<Car>(alloc, record.brand, record.model, record.basePrice,
+                                             record.numberOfDoors, record.bodyType, record.trunkCapacity, record.year);
+        case VehicleKind::MOTORCYCLE:
+            return std::allocate_shared<Motorcycle>(alloc, record.brand, record.model, record.basePrice,
+                                                    record.bodyType, record.engineDisplacement, record.year);
+        case VehicleKind::ELECTRIC:
+        default:
+            return std::allocate_shared<ElectricVehicle>(alloc, record.brand, record.model, record.basePrice,
+                                                         record.batteryCapacity, record.range, record.chargingTime,
+                                                         record.year);
+    }
+}
 
-        // Create a map to store equipment by category
-        std::map<EquipmentCategory, std::vector<Equipment>> equipmentByCategory;
-        double totalEquipmentCost = 0.0;
+// Creates an engine from a catalog record in the given memory resource
+std::shared_ptr<Engine> makeEngine(const EngineRecord& record, Engine::allocator_type alloc) {
+    return std::allocate_shared<Engine>(alloc, record.name, record.capacity, record.horsePower, record.fuelType,
+                                        record.price, record.co2Emissions, record.fuelConsumption);
+}
 
-        for (const auto& equipment : currentVehicle->getSelectedEquipment()) {
-            equipmentByCategory[equipment.getCategory()].push_back(equipment);
-            totalEquipmentCost += equipment.getPrice();
-        }
+// Pricing rules beyond the flat discount: option packages, per-category discounts, volume tiers and VAT
+struct BundleRule {
+    std::string_view name;
+    double price;
+    std::span<const std::string_view> items;
+};
 
-        if (equipmentByCategory.empty()) {
-            std::cout << COLOR_YELLOW << "No equipment added yet." << COLOR_RESET << std::endl;
-            return;
-        }
+struct CategoryDiscountRule {
+    EquipmentCategory category;
+    double percent;
+};
 
-        for (const auto& categoryPair : equipmentByCategory) {
-            std::cout << COLOR_YELLOW << "\n" << categoryToString(categoryPair.first) << ":" << COLOR_RESET << std::endl;
+struct VolumeTier {
+    unsigned minQuantity;
+    double percent;
+};
 
-            double categoryTotal = 0.0;
-            for (const auto& equipment : categoryPair.second) {
-                std::cout << "  ├─ " << equipment.getName() << ": " << formatPrice(equipment.getPrice()) << std::endl;
-                std::cout << "  │  " << equipment.getDescription() << std::endl;
-                categoryTotal += equipment.getPrice();
-            }
+struct PricingRules {
+    std::span<const BundleRule> bundles;
+    std::span<const CategoryDiscountRule> categoryDiscounts;
+    std::span<const VolumeTier> volumeTiers;
+    double vatPercent;
+};
 
-            std::cout << "  └─ " << COLOR_BOLD << "Category total: " << formatPrice(categoryTotal)
-                      << " (" << std::fixed << std::setprecision(1)
-                      << (categoryTotal / totalEquipmentCost * 100) << "% of equipment cost)"
-                      << COLOR_RESET << std::endl;
-        }
+constexpr std::string_view safetyPackItems[] = {"Parking assistant", "Adaptive cruise control", "Backup camera"};
+constexpr std::string_view comfortPackItems[] = {"Leather upholstery", "Heated seats", "Keyless entry"};
+constexpr std::string_view techPackItems[] = {"Navigation system", "Premium audio system", "Head-up display"};
 
-        std::cout << COLOR_BOLD << COLOR_GREEN << "\nTotal equipment cost: "
-                  << formatPrice(totalEquipmentCost) << COLOR_RESET << std::endl;
-    }
+constexpr BundleRule builtInBundles[] = {
+    {"Safety pack", 8500, safetyPackItems},
+    {"Comfort pack", 7500, comfortPackItems},
+    {"Tech pack", 8900, techPackItems},
+};
 
-    // Show available equipment by category
-    void displayAvailableEquipmentByCategory() const {
-        printHeader("Available Equipment by Category");
+constexpr CategoryDiscountRule builtInCategoryDiscounts[] = {
+    {EquipmentCategory::MULTIMEDIA, 10},
+};
+
+constexpr VolumeTier builtInVolumeTiers[] = {
+    {5, 3},
+    {10, 5},
+    {25, 8},
+};
+
+constexpr PricingRules builtInPricingRules{builtInBundles, builtInCategoryDiscounts, builtInVolumeTiers, 23};
 
-        // Create a map to store equipment by category
-        std::map<EquipmentCategory, std::vector<std::pair<size_t, Equipment>>> equipmentByCategory;
+// Equipment set as bits indexed by catalog position. Sets of up to 256 items are stored inline, so
+// copying one allocates nothing; larger catalogs move the words to the heap.
+class EquipmentMask {
+private:
+    static constexpr size_t INLINE_WORDS = 4;
+    std::array<uint64_t, INLINE_WORDS> inlineWords{};
+    std::vector<uint64_t> heapWords; // Holds every word once more than INLINE_WORDS are needed
+    size_t wordCount = 0;
+
+public:
+    EquipmentMask() = default;
+    explicit EquipmentMask(size_t itemCount) { grow((itemCount + 63) / 64); }
 
-        for (size_t i = 0; i < availableEquipment.size(); ++i) {
-            equipmentByCategory[availableEquipment[i].getCategory()].push_back({i + 1, availableEquipment[i]});
+    // Inline sets copy just their words
+    EquipmentMask(const EquipmentMask& other) : inlineWords(other.inlineWords), wordCount(other.wordCount) {
+        if (!other.heapWords.empty()) heapWords = other.heapWords;
+    }
+    EquipmentMask& operator=(const EquipmentMask& other) {
+        inlineWords = other.inlineWords;
+        wordCount = other.wordCount;
+        if (other.heapWords.empty()) {
+            heapWords.clear();
+        } else {
+            heapWords = other.heapWords;
+        }
+        return *this;
+    }
+    EquipmentMask(EquipmentMask&&) = default;
+    EquipmentMask& operator=(EquipmentMask&&) = default;
+
+    size_t words() const { return wordCount; }
+    uint64_t* data() { return heapWords.empty() ? inlineWords.data() : heapWords.data(); }
+    const uint64_t* data() const { return heapWords.empty() ? inlineWords.data() : heapWords.data(); }
+
+    // Widens the set to at least words words; the new words are empty
+    void grow(size_t words) {
+        if (words <= wordCount) return;
+        if (words > INLINE_WORDS) {
+            if (heapWords.empty()) heapWords.assign(inlineWords.begin(), inlineWords.begin() + wordCount);
+            heapWords.resize(words, 0);
         }
+        wordCount = words;
+    }
 
-        for (const auto& categoryPair : equipmentByCategory) {
-            std::cout << COLOR_YELLOW << "\n" << categoryToString(categoryPair.first) << ":" << COLOR_RESET << std::endl;
+    // Direct word access for w < words()
+    uint64_t& operator[](size_t w) { return data()[w]; }
+    uint64_t operator[](size_t w) const { return data()[w]; }
 
-            for (const auto& indexedEquipment : categoryPair.second) {
-                std::cout << COLOR_CYAN << " [" << indexedEquipment.first << "] " << COLOR_RESET;
-                std::cout << indexedEquipment.second.getName() << " - "
-                          << indexedEquipment.second.getDescription() << " - "
-                          << formatPrice(indexedEquipment.second.getPrice()) << std::endl;
-            }
+    // Word w, or an empty word past the end
+    uint64_t word(size_t w) const { return w < wordCount ? data()[w] : 0; }
+
+    bool test(size_t item) const { return (word(item / 64) >> (item % 64)) & 1; }
+    void set(size_t item) {
+        grow(item / 64 + 1);
+        data()[item / 64] |= uint64_t{1} << (item % 64);
+    }
+    void flip(size_t item) {
+        grow(item / 64 + 1);
+        data()[item / 64] ^= uint64_t{1} << (item % 64);
+    }
+};
+
+// Input of a plan evaluation: everything but the equipment is already a number
+struct PricedConfiguration {
+    double basePrice = 0.0; // Vehicle plus engine
+    EquipmentMask equipment{};
+    double discountPercent = 0.0;
+    unsigned quantity = 1;
+};
+
+// Pricing rules compiled against one catalog version: names are resolved to bit masks, category
+// discounts are folded into per-item prices and bundles are sorted, so evaluation is a few mask
+// tests and a walk over the set bits with no lookups. The masks span the whole catalog, so only
+// catalogs of more than 256 items allocate during evaluation.
+class PricingPlan {
+private:
+    struct CompiledBundle {
+        std::string_view name;
+        EquipmentMask mask{};
+        double price = 0.0;
+        double savings = 0.0;
+    };
+
+    uint64_t catalogVersion;
+    size_t wordCount;
+    std::vector<CompiledBundle> bundles;
+    std::vector<double> listPrices;
+    std::vector<double> netPrices;
+    std::vector<VolumeTier> volumeTiers; // Ascending by minimum quantity
+    double vatRate;
+    CatalogIndex index;
+    EquipmentMask bundleItems{}; // Items that take part in at least one bundle
+
+    static bool covers(const uint64_t* set, const uint64_t* subset, size_t words) {
+        for (size_t w = 0; w < words; ++w) {
+            if ((set[w] & subset[w]) != subset[w]) return false;
         }
+        return true;
     }
 
-    // Remove equipment from current vehicle
-    void removeEquipmentMenu() {
-        if (!currentVehicle) {
-            std::cout << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
-            return;
+    // Takes every bundle the set completes out of it, larger savings first, and reports each one;
+    // words must hold wordCount words
+    template <typename OnBundle>
+    void resolveBundles(uint64_t* words, OnBundle&& onBundle) const {
+        for (const auto& bundle : bundles) {
+            const uint64_t* mask = bundle.mask.data();
+            if (covers(words, mask, wordCount)) {
+                for (size_t w = 0; w < wordCount; ++w) words[w] &= ~mask[w];
+                onBundle(bundle);
+            }
         }
+    }
 
-        const auto& selectedEquipment = currentVehicle->getSelectedEquipment();
+public:
+    PricingPlan(const CatalogView& catalog, uint64_t version, const PricingRules& rules)
+        : catalogVersion(version),
+          wordCount((catalog.equipment.size() + 63) / 64),
+          vatRate(rules.vatPercent / 100.0),
+          index(catalog),
+          bundleItems(catalog.equipment.size()) {
+        size_t itemCount = catalog.equipment.size();
+        listPrices.resize(itemCount);
+        netPrices.resize(itemCount);
+        for (size_t i = 0; i < itemCount; ++i) {
+            const EquipmentRecord& item = catalog.equipment[i];
+            listPrices[i] = item.price;
+            netPrices[i] = item.price;
+            for (const auto& rule : rules.categoryDiscounts) {
+                if (rule.category == item.category) {
+                    netPrices[i] = discountedPrice(item.price, rule.percent);
+                }
+            }
+        }
 
-        if (selectedEquipment.empty()) {
-            std::cout << COLOR_YELLOW << "! No equipment to remove." << COLOR_RESET << std::endl;
-            return;
+        // Bundles whose items are missing from this catalog version are dropped
+        for (const auto& rule : rules.bundles) {
+            CompiledBundle bundle{rule.name, EquipmentMask(itemCount), rule.price, 0.0};
+            double itemsPrice = 0.0;
+            bool complete = !rule.items.empty();
+            for (std::string_view name : rule.items) {
+                auto item = index.findEquipment(name);
+                if (!item || *item >= itemCount) {
+                    complete = false;
+                    break;
+                }
+                bundle.mask.set(*item);
+                itemsPrice += listPrices[*item];
+            }
+            bundle.savings = itemsPrice - rule.price;
+            if (complete && bundle.savings > 0) {
+                bundles.push_back(bundle);
+            }
+        }
+        // Larger savings first, so overlapping bundles resolve in the customer's favor
+        std::sort(bundles.begin(), bundles.end(),
+                  [](const CompiledBundle& a, const CompiledBundle& b) { return a.savings > b.savings; });
+        for (const auto& bundle : bundles) {
+            for (size_t w = 0; w < wordCount; ++w) bundleItems[w] |= bundle.mask[w];
         }
 
-        printHeader("Remove Equipment");
+        volumeTiers.assign(rules.volumeTiers.begin(), rules.volumeTiers.end());
+        std::sort(volumeTiers.begin(), volumeTiers.end(),
+                  [](const VolumeTier& a, const VolumeTier& b) { return a.minQuantity < b.minQuantity; });
+    }
 
-        for (size_t i = 0; i < selectedEquipment.size(); ++i) {
-            std::cout << COLOR_CYAN << " [" << i + 1 << "] " << COLOR_RESET;
-            std::cout << selectedEquipment[i].getName() << " - "
-                      << formatPrice(selectedEquipment[i].getPrice()) << std::endl;
+    uint64_t getCatalogVersion() const { return catalogVersion; }
+    size_t getItemCount() const { return netPrices.size(); }
+    double getNetPrice(size_t item) const { return netPrices[item]; }
+    bool inBundle(size_t item) const { return bundleItems.test(item); }
+    const EquipmentMask& getBundleItems() const { return bundleItems; }
+
+    double volumePercent(unsigned quantity) const {
+        double percent = 0.0;
+        for (const auto& tier : volumeTiers) {
+            if (quantity < tier.minQuantity) break;
+            percent = tier.percent;
         }
+        return percent;
+    }
 
-        std::cout << COLOR_CYAN << " [0] " << COLOR_RESET << "Cancel" << std::endl;
-
-        size_t choice;
-        std::cout << "\nSelect equipment to remove: ";
-        std::cin >> choice;
+    // Share of the subtotal that reaches the gross unit price: what is left after the percentage
+    // discount and the volume tier, plus VAT on it. Every rule past bundles and category discounts
+    // scales the subtotal, so the displayed total moves by this share of any subtotal change.
+    double grossShare(double discountPercent, unsigned quantity) const {
+        return discountedPrice(discountedPrice(1.0, discountPercent), volumePercent(quantity)) * (1.0 + vatRate);
+    }
 
-        if (choice == 0) {
-            return;
+    // Options of an equipment set after bundles and category discounts
+    double optionsPrice(const EquipmentMask& equipment) const {
+        EquipmentMask remaining = equipment;
+        remaining.grow(wordCount);
+        uint64_t* words = remaining.data();
+        double options = 0.0;
+        resolveBundles(words, [&options](const CompiledBundle& bundle) { options += bundle.price; });
+        for (size_t w = 0; w < wordCount; ++w) {
+            for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                options += netPrices[w * 64 + std::countr_zero(bits)];
+            }
         }
+        return options;
+    }
 
-        if (choice >= 1 && choice <= selectedEquipment.size()) {
-            currentVehicle->removeEquipment(selectedEquipment[choice - 1].getName());
+    // Adds an equipment item at price to an evaluation input. Items unknown to this catalog version,
+    // or priced differently than it lists them, are priced at their own list price, so a quote never
+    // mixes a configuration's prices with a newer catalog's.
+    void addEquipment(PricedConfiguration& config, std::string_view name, double price) const {
+        auto item = index.findEquipment(name);
+        if (item && listPrices[*item] == price) {
+            config.equipment.set(*item);
         } else {
-            std::cout << COLOR_RED << "✗ Invalid selection." << COLOR_RESET << std::endl;
+            config.basePrice += price;
         }
     }
-};
-// Main user interface function with enhanced UI
-void runUserInterface() {
-    VehicleConfigurator configurator;
-    bool running = true;
 
-    clearScreen();
-    std::cout << COLOR_BOLD << COLOR_BLUE;
-    std::cout << R"(
- __      __   _     _      _        _____             __ _                       _
- \ \    / /__| |__ (_)__ _| |___   / / __| ___  _ _  / _(_)__ _ _  _ _ _ __ _ _| |_ ___ _ _ _
-  \ \/\/ / -_) '_ \| / _` | / -_) / / (__/ _ \| ' \| |_| / _` | || | '_/ _` |_  _/ _ \ '_| '_|
-   \_/\_/\___|_.__// \__,_|_\___| /_/\___\___/|_||_|_| |_\__, |\_,_|_| \__,_| \__\___/_| |_|
-                 |__/                                     |___/
-)" << COLOR_RESET << std::endl;
+    // Builds the evaluation input for a configured vehicle
+    PricedConfiguration describe(const Vehicle& vehicle, unsigned quantity = 1) const {
+        PricedConfiguration config;
+        config.basePrice = vehicle.getBasePrice() + (vehicle.getEngine() ? vehicle.getEngine()->getPrice() : 0.0);
+        config.discountPercent = vehicle.getDiscount();
+        config.quantity = quantity;
+        config.equipment.grow(wordCount);
+        for (const auto& equipment : vehicle.getSelectedEquipment()) {
+            addEquipment(config, equipment.getName(), equipment.getPrice());
+        }
+        return config;
+    }
 
-    std::cout << COLOR_YELLOW << "Welcome to the enhanced Vehicle Configurator!" << COLOR_RESET << std::endl;
-    std::cout << "This application allows you to configure your dream vehicle with various options.\n" << std::endl;
+    // Builds the evaluation input for catalog records, as batch quotes resolve them
+    PricedConfiguration describe(const VehicleRecord& vehicle, const EngineRecord* engine,
+                                 std::span<const EquipmentRecord* const> equipment, double discount) const {
+        PricedConfiguration config;
+        config.basePrice = vehicle.basePrice + (engine ? engine->price : 0.0);
+        config.discountPercent = discount;
+        config.equipment.grow(wordCount);
+        for (const EquipmentRecord* item : equipment) addEquipment(config, item->name, item->price);
+        return config;
+    }
 
-    while (running) {
-        printHeader("Main Menu");
+    // Names of the bundles applied to an equipment set, for display
+    std::vector<std::string_view> appliedBundles(const EquipmentMask& equipment) const {
+        std::vector<std::string_view> names;
+        EquipmentMask remaining = equipment;
+        remaining.grow(wordCount);
+        resolveBundles(remaining.data(), [&names](const CompiledBundle& bundle) { names.push_back(bundle.name); });
+        return names;
+    }
 
-        printMenuItem(1, "Select vehicle");
-        printMenuItem(2, "Select engine");
-        printMenuItem(3, "Add equipment");
-        printMenuItem(4, "Remove equipment");
-        printMenuItem(5, "Select color");
-        printMenuItem(6, "Apply discount");
-        printMenuItem(7, "Display current configuration");
-        printMenuItem(8, "Visualize vehicle");
-        printMenuItem(9, "Save configuration");
-        printMenuItem(10, "Load configuration");
-        printMenuItem(11, "Save for comparison");
-        printMenuItem(12, "Compare configurations");
-        printMenuItem(13, "Generate PDF report");
-        printMenuItem(0, "Exit");
+    PriceBreakdown evaluate(const PricedConfiguration& config) const {
+        PriceBreakdown result;
+        EquipmentMask remaining = config.equipment;
+        remaining.grow(wordCount);
+        uint64_t* words = remaining.data();
+        double options = 0.0;
+
+        resolveBundles(words, [&options, &result](const CompiledBundle& bundle) {
+            options += bundle.price;
+            result.bundleSavings += bundle.savings;
+        });
+
+        for (size_t w = 0; w < wordCount; ++w) {
+            for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                size_t item = w * 64 + std::countr_zero(bits);
+                options += netPrices[item];
+                result.categorySavings += listPrices[item] - netPrices[item];
+            }
+        }
 
-        int choice;
-        std::cout << "\n" << COLOR_BOLD << "Your choice: " << COLOR_RESET;
-        std::cin >> choice;
+        double subtotal = config.basePrice + options;
+        result.listPrice = subtotal + result.bundleSavings + result.categorySavings;
 
-        switch (choice) {
-            case 1: {
-                clearScreen();
-                configurator.displayAvailableVehicles();
-                std::cout << "\nSelect vehicle number (0 to cancel): ";
-                size_t vehicleIndex;
-                std::cin >> vehicleIndex;
+        double discounted = discountedPrice(subtotal, config.discountPercent);
+        result.discountAmount = subtotal - discounted;
 
-                if (vehicleIndex == 0) break;
+        result.unitNet = discountedPrice(discounted, volumePercent(config.quantity));
+        result.volumeSavings = discounted - result.unitNet;
 
-                if (!configurator.selectVehicle(vehicleIndex)) {
-                    std::cout << "Press Enter to continue...";
-                    std::cin.ignore();
-                    std::cin.get();
-                }
-                break;
-            }
-            case 2: {
-                if (!configurator.hasSelectedVehicle()) {
-                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
-                    std::cout << "Press Enter to continue...";
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
-                }
+        result.unitVat = result.unitNet * vatRate;
+        result.unitGross = result.unitNet + result.unitVat;
+        result.totalGross = result.unitGross * config.quantity;
+        return result;
+    }
 
-                clearScreen();
-                configurator.displayAvailableEngines();
-                std::cout << "\nSelect engine number (0 to cancel): ";
-                size_t engineIndex;
-                std::cin >> engineIndex;
+    // Scores many configurations at once; results[i] belongs to configs[i]
+    void evaluateBatch(std::span<const PricedConfiguration> configs, std::span<PriceBreakdown> results) const {
+        size_t count = std::min(configs.size(), results.size());
+        for (size_t i = 0; i < count; ++i) {
+            results[i] = evaluate(configs[i]);
+        }
+    }
+};
 
-                if (engineIndex == 0) break;
+PriceBreakdown Vehicle::calculatePrice() const {
+    if (pricingPlan) return pricingPlan->evaluate(pricingPlan->describe(*this));
 
-                if (!configurator.selectEngine(engineIndex)) {
-                    std::cout << "Press Enter to continue...";
-                    std::cin.ignore();
-                    std::cin.get();
-                }
-                break;
-            }
-            case 3: {
-                if (!configurator.hasSelectedVehicle()) {
-                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
-                    std::cout << "Press Enter to continue...";
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
-                }
+    // No plan: list price minus the discount, without rules or VAT
+    PriceBreakdown price;
+    price.listPrice = basePrice + (engine ? engine->getPrice() : 0.0);
+    for (const auto& equipment : selectedEquipment) {
+        price.listPrice += equipment.getPrice();
+    }
+    price.unitNet = discountedPrice(price.listPrice, discount);
+    price.discountAmount = price.listPrice - price.unitNet;
+    price.unitGross = price.unitNet;
+    price.totalGross = price.unitNet;
+    return price;
+}
 
-                clearScreen();
-                configurator.displayAvailableEquipmentByCategory();
-                std::cout << "\nSelect equipment number (0 to finish): ";
-                size_t equipmentIndex;
-                std::cin >> equipmentIndex;
+// Price change of every single edit to a configuration: toggling any one equipment item or swapping
+// the engine, as a change of the gross total. Past bundles, the rules only scale the subtotal, so most
+// deltas are an item's net price times the share left after discounts and VAT, and only bundle items
+// re-resolve the bundles. update() works out what changed since the last call and recomputes just the
+// items that edit can have affected.
+class WhatIfPricing {
+private:
+    const PricingPlan* plan = nullptr;
+    uint64_t planVersion = 0;
+    EquipmentMask equipment{};
+    double share = 1.0;
+    double enginePrice = 0.0;
+    std::vector<double> itemDeltas; // Change of the subtotal when the item is toggled
 
-                while (equipmentIndex != 0) {
-                    if (!configurator.addEquipment(equipmentIndex)) {
-                        std::cout << "Invalid equipment selection." << std::endl;
-                    }
-                    std::cout << "Select next equipment (0 to finish): ";
-                    std::cin >> equipmentIndex;
+public:
+    // Brings the deltas up to date with config; returns how many items had to be recomputed
+    size_t update(const PricingPlan& current, const PricedConfiguration& config, double currentEnginePrice) {
+        size_t itemCount = current.getItemCount();
+        size_t words = (itemCount + 63) / 64;
+        bool rebuild = plan != &current || planVersion != current.getCatalogVersion();
+        plan = &current;
+        planVersion = current.getCatalogVersion();
+        share = current.grossShare(config.discountPercent, config.quantity);
+        enginePrice = currentEnginePrice;
+
+        EquipmentMask dirty(itemCount);
+        bool bundleChanged = false;
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t valid = (w + 1) * 64 <= itemCount ? ~uint64_t{0} : (uint64_t{1} << (itemCount % 64)) - 1;
+            dirty[w] = rebuild ? valid : (equipment.word(w) ^ config.equipment.word(w)) & valid;
+            bundleChanged |= (dirty[w] & current.getBundleItems()[w]) != 0;
+        }
+        // A bundle item coming or going can complete or break a bundle for every other bundle item
+        if (bundleChanged) {
+            for (size_t w = 0; w < words; ++w) dirty[w] |= current.getBundleItems()[w];
+        }
+        equipment = config.equipment;
+        equipment.grow(words);
+        if (rebuild) itemDeltas.assign(itemCount, 0.0);
+
+        // Items outside bundles price the same either way, so bundle items are resolved on their own
+        EquipmentMask bundled(itemCount);
+        for (size_t w = 0; w < words; ++w) bundled[w] = equipment[w] & current.getBundleItems()[w];
+        double options = bundleChanged ? current.optionsPrice(bundled) : 0.0;
+        size_t recomputed = 0;
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t bits = dirty[w]; bits != 0; bits &= bits - 1) {
+                size_t item = w * 64 + std::countr_zero(bits);
+                uint64_t bit = uint64_t{1} << (item % 64);
+                if (current.inBundle(item)) {
+                    EquipmentMask toggled = bundled;
+                    toggled[w] ^= bit;
+                    itemDeltas[item] = current.optionsPrice(toggled) - options;
+                } else {
+                    itemDeltas[item] = (equipment[w] & bit) ? -current.getNetPrice(item) : current.getNetPrice(item);
                 }
-                break;
-            }
-            case 4: {
-                clearScreen();
-                configurator.removeEquipmentMenu();
-                std::cout << "\nPress Enter to continue...";
-                std::cin.ignore();
-                std::cin.get();
-                break;
+                ++recomputed;
             }
-            case 5: {
-                if (!configurator.hasSelectedVehicle()) {
-                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
-                    std::cout << "Press Enter to continue...";
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
-                }
+        }
+        return recomputed;
+    }
 
-                clearScreen();
-                configurator.displayAvailableColors();
-                std::cout << "\nSelect color number (0 to cancel): ";
-                size_t colorIndex;
-                std::cin >> colorIndex;
+    bool isSelected(size_t item) const {
+        return item < itemDeltas.size() && equipment.test(item);
+    }
 
-                if (colorIndex == 0) break;
+    // Total change when the item is added, or removed if selected. Items the plan does not cover
+    // are priced at their list price.
+    double toggleDelta(size_t item, double listPrice) const {
+        return (item < itemDeltas.size() ? itemDeltas[item] : listPrice) * share;
+    }
 
-                if (!configurator.selectColor(colorIndex)) {
-                    std::cout << "Press Enter to continue...";
-                    std::cin.ignore();
-                    std::cin.get();
-                }
-                break;
-            }
-            case 6: {
-                if (!configurator.hasSelectedVehicle()) {
-                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
-                    std::cout << "Press Enter to continue...";
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
-                }
+    // Total change when the current engine is replaced by one at price
+    double engineDelta(double price) const { return (price - enginePrice) * share; }
 
-                clearScreen();
-                printHeader("Apply Discount");
-                std::cout << "Enter discount percentage (0-30): ";
-                double discountPercent;
-                std::cin >> discountPercent;
+    size_t getItemCount() const { return itemDeltas.size(); }
+    size_t getMemoryBytes() const { return itemDeltas.capacity() * sizeof(double); }
+};
 
-                if (!configurator.applyDiscount(discountPercent)) {
-                    std::cout << "Press Enter to continue...";
+// Configuration as stored by Vehicle::saveToFile
+struct SavedEquipmentItem {
+    std::string name;
+    std::string description;
+    double price = 0.0;
+    int category = 0;
+};
+
+struct SavedConfiguration {
+    std::string version;
+    std::string date;
+    std::string brand;
+    std::string model;
+    std::string year;
+    std::string color;
+    double basePrice = 0.0;
+    double discount = 0.0;
+
+    bool hasEngine = false;
+    std::string engineName;
+    std::string fuelType;
+    double engineCapacity = 0.0;
+    int horsePower = 0;
+    double enginePrice = 0.0;
+    int co2Emissions = 0;
+    double fuelConsumption = 0.0;
+
+    std::vector<SavedEquipmentItem> equipment;
+    double totalPrice = 0.0;
+};
+
+// Parses a saved configuration section by section from text already in memory, without console output
+bool parseSavedConfiguration(std::string_view contents, SavedConfiguration& config, std::string& error) {
+    size_t position = 0;
+    auto nextLine = [&contents, &position](std::string_view& line) {
+        if (position >= contents.size()) return false;
+        size_t end = contents.find('\n', position);
+        if (end == std::string_view::npos) end = contents.size();
+        line = contents.substr(position, end - position);
+        position = end + 1;
+        return true;
+    };
+
+    std::string_view line;
+    if (!nextLine(line) || trimView(line) != "VEHICLE_CONFIGURATION") {
+        error = "not a vehicle configuration file";
+        return false;
+    }
+
+    std::string_view section;
+    size_t lineNumber = 1;
+    while (nextLine(line)) {
+        ++lineNumber;
+        std::string_view text = trimView(line);
+        if (text.empty()) continue;
+
+        if (text.front() == '[') {
+            section = text;
+            if (section == "[ENGINE]") {
+                config.hasEngine = true;
+            } else if (section.rfind("[EQUIPMENT_ITEM_", 0) == 0) {
+                config.equipment.emplace_back();
+            }
+            continue;
+        }
+
+        if (section.empty()) {
+            if (text.rfind("VERSION ", 0) == 0) config.version = std::string(text.substr(8));
+            else if (text.rfind("DATE ", 0) == 0) config.date = std::string(text.substr(5));
+            continue;
+        }
+
+        size_t separator = text.find('=');
+        if (separator == std::string_view::npos) continue;
+        std::string_view key = text.substr(0, separator);
+        std::string_view value = text.substr(separator + 1);
+        bool valid = true;
+
+        if (section == "[VEHICLE]") {
+            if (key == "BRAND") config.brand = value;
+            else if (key == "MODEL") config.model = value;
+            else if (key == "YEAR") config.year = value;
+            else if (key == "BASE_PRICE") valid = parseNumber(value, config.basePrice);
+            else if (key == "COLOR") config.color = value;
+            else if (key == "DISCOUNT") valid = parseNumber(value, config.discount);
+        } else if (section == "[ENGINE]") {
+            if (key == "NAME") config.engineName = value;
+            else if (key == "CAPACITY") valid = parseNumber(value, config.engineCapacity);
+            else if (key == "HORSEPOWER") valid = parseNumber(value, config.horsePower);
+            else if (key == "FUEL_TYPE") config.fuelType = value;
+            else if (key == "PRICE") valid = parseNumber(value, config.enginePrice);
+            else if (key == "CO2_EMISSIONS") valid = parseNumber(value, config.co2Emissions);
+            else if (key == "FUEL_CONSUMPTION") valid = parseNumber(value, config.fuelConsumption);
+        } else if (!config.equipment.empty() && section.rfind("[EQUIPMENT_ITEM_", 0) == 0) {
+            SavedEquipmentItem& item = config.equipment.back();
+            if (key == "NAME") item.name = value;
+            else if (key == "DESCRIPTION") item.description = value;
+            else if (key == "PRICE") valid = parseNumber(value, item.price);
+            else if (key == "CATEGORY") valid = parseNumber(value, item.category);
+        } else if (section == "[SUMMARY]") {
+            if (key == "TOTAL_PRICE") valid = parseNumber(value, config.totalPrice);
+        }
+
+        if (!valid) {
+            error = "line " + std::to_string(lineNumber) + ": invalid value for " + std::string(key);
+            return false;
+        }
+    }
+
+    if (config.brand.empty() || config.model.empty()) {
+        error = "missing [VEHICLE] section";
+        return false;
+    }
+    return true;
+}
+
+bool readSavedConfiguration(std::istream& input, SavedConfiguration& config, std::string& error) {
+    std::string contents(std::istreambuf_iterator<char>(input), {});
+    return parseSavedConfiguration(contents, config, error);
+}
+
+// Rebuilds a saved configuration against the catalog. Returns nullptr if the vehicle is unknown;
+// engine and equipment that no longer exist are skipped and reported in warnings.
+std::shared_ptr<Vehicle> resolveSavedConfiguration(const SavedConfiguration& config, const CatalogView& catalog,
+                                                   Vehicle::allocator_type alloc, std::vector<std::string>& warnings) {
+    auto vehicleRecord = std::find_if(catalog.vehicles.begin(), catalog.vehicles.end(),
+        [&config](const VehicleRecord& record) { return record.brand == config.brand && record.model == config.model; });
+    if (vehicleRecord == catalog.vehicles.end()) {
+        return nullptr;
+    }
+
+    auto vehicle = makeVehicle(*vehicleRecord, alloc);
+    vehicle->setColor(config.color);
+    vehicle->setDiscount(config.discount);
+
+    if (config.hasEngine) {
+        auto engineRecord = std::find_if(catalog.engines.begin(), catalog.engines.end(),
+            [&config](const EngineRecord& record) { return record.name == config.engineName; });
+        if (engineRecord != catalog.engines.end()) {
+            vehicle->setEngine(makeEngine(*engineRecord, alloc));
+        } else {
+            warnings.push_back("No matching engine found. Engine will not be configured.");
+        }
+    }
+
+    for (const auto& item : config.equipment) {
+        auto equipmentRecord = std::find_if(catalog.equipment.begin(), catalog.equipment.end(),
+            [&item](const EquipmentRecord& record) { return record.name == item.name; });
+        if (equipmentRecord != catalog.equipment.end()) {
+            vehicle->attachEquipment(*equipmentRecord);
+        } else {
+            warnings.push_back("No matching equipment found: " + item.name);
+        }
+    }
+    return vehicle;
+}
+
+// Lists the saved configuration files (*.txt) in a directory, sorted by name
+std::vector<std::filesystem::path> listSavedConfigurations(const std::string& directory) {
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            files.push_back(entry.path());
+        }
+    }
+    // All files share the directory, so comparing the plain strings gives the same order as
+    // comparing paths component by component, at a fraction of the cost
+    std::sort(files.begin(), files.end(), [](const std::filesystem::path& a, const std::filesystem::path& b) {
+        return a.native() < b.native();
+    });
+    return files;
+}
+
+// Canonical text of a configuration (vehicle, engine, equipment set, color, discount) and its hash.
+// Equipment is sorted, so the same choices made in any order give the same key.
+struct ConfigurationKey {
+    std::string canonical;
+    uint64_t hash = 0;
+
+    bool operator==(const ConfigurationKey& other) const { return canonical == other.canonical; }
+};
+
+ConfigurationKey makeConfigurationKey(std::string_view brand, std::string_view model, std::string_view engine,
+                                      std::vector<std::string_view> equipment, std::string_view color,
+                                      double discount) {
+    std::sort(equipment.begin(), equipment.end());
+    equipment.erase(std::unique(equipment.begin(), equipment.end()), equipment.end());
+
+    ConfigurationKey key;
+    auto append = [&key](std::string_view field) {
+        key.canonical += field;
+        key.canonical += '\x1f'; // Unit separator cannot appear in catalog names
+    };
+    append(brand);
+    append(model);
+    append(engine);
+    for (std::string_view item : equipment) append(item);
+    key.canonical += '\x1e';
+    append(color);
+
+    // Cents precision, so 10 and 10.000001 percent are the same offer
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), discount, std::chars_format::fixed, 2);
+    key.canonical.append(buffer, result.ptr);
+
+    // FNV-1a, 64-bit
+    key.hash = 14695981039346656037ull;
+    for (unsigned char c : key.canonical) {
+        key.hash = (key.hash ^ c) * 1099511628211ull;
+    }
+    return key;
+}
+
+ConfigurationKey configurationKey(const Vehicle& vehicle) {
+    std::vector<std::string_view> equipment;
+    equipment.reserve(vehicle.getSelectedEquipment().size());
+    std::vector<std::string> names;
+    names.reserve(vehicle.getSelectedEquipment().size());
+    for (const auto& item : vehicle.getSelectedEquipment()) {
+        names.push_back(item.getName());
+        equipment.push_back(names.back());
+    }
+    std::string engine = vehicle.getEngine() ? vehicle.getEngine()->getName() : "";
+    return makeConfigurationKey(vehicle.getBrand(), vehicle.getModel(), engine, std::move(equipment),
+                                vehicle.getColor(), vehicle.getDiscount());
+}
+
+ConfigurationKey configurationKey(const SavedConfiguration& config) {
+    std::vector<std::string_view> equipment;
+    equipment.reserve(config.equipment.size());
+    for (const auto& item : config.equipment) {
+        equipment.push_back(item.name);
+    }
+    return makeConfigurationKey(config.brand, config.model, config.hasEngine ? config.engineName : "",
+                                std::move(equipment), config.color, config.discount);
+}
+
+// Price of a configuration split the way it is displayed
+constexpr size_t EQUIPMENT_CATEGORY_COUNT = static_cast<size_t>(EquipmentCategory::PERFORMANCE) + 1;
+
+struct QuoteBreakdown {
+    double basePrice = 0.0;
+    double enginePrice = 0.0;
+    std::array<double, EQUIPMENT_CATEGORY_COUNT> categoryTotals{};
+    double listPrice = 0.0;
+    double packageSavings = 0.0; // Bundles and category discounts
+    double discountAmount = 0.0;
+    double vat = 0.0;
+    double total = 0.0;
+};
+
+// Category totals at list price; the total is the vehicle's own, through its pricing plan
+QuoteBreakdown computeQuote(const Vehicle& vehicle) {
+    QuoteBreakdown quote;
+    quote.basePrice = vehicle.getBasePrice();
+    quote.enginePrice = vehicle.getEngine() ? vehicle.getEngine()->getPrice() : 0.0;
+    for (const auto& item : vehicle.getSelectedEquipment()) {
+        quote.categoryTotals[static_cast<size_t>(item.getCategory())] += item.getPrice();
+    }
+    PriceBreakdown price = vehicle.calculatePrice();
+    quote.listPrice = price.listPrice;
+    quote.packageSavings = price.bundleSavings + price.categorySavings;
+    quote.discountAmount = price.discountAmount;
+    quote.vat = price.unitVat;
+    quote.total = price.unitGross;
+    return quote;
+}
+
+// The same for catalog records, priced by the plan of their catalog version
+QuoteBreakdown computeQuote(const PricingPlan& plan, const VehicleRecord& vehicle, const EngineRecord* engine,
+                            std::span<const EquipmentRecord* const> equipment, double discount) {
+    QuoteBreakdown quote;
+    quote.basePrice = vehicle.basePrice;
+    quote.enginePrice = engine ? engine->price : 0.0;
+    for (const EquipmentRecord* item : equipment) {
+        quote.categoryTotals[static_cast<size_t>(item->category)] += item->price;
+    }
+    PriceBreakdown price = plan.evaluate(plan.describe(vehicle, engine, equipment, discount));
+    quote.listPrice = price.listPrice;
+    quote.packageSavings = price.bundleSavings + price.categorySavings;
+    quote.discountAmount = price.discountAmount;
+    quote.vat = price.unitVat;
+    quote.total = price.unitGross;
+    return quote;
+}
+
+// Bounded LRU from configuration keys to derived results (quotes, simulations), split into
+// independently locked shards so concurrent threads rarely contend. Entries belong to one catalog
+// version: the first access with a newer version empties the shard.
+template <typename Value>
+class ConfigurationCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t invalidations = 0;
+        size_t entries = 0;
+
+        double hitRate() const { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+    };
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct Entry {
+        uint64_t hash;
+        std::string canonical;
+        Value value;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        uint64_t catalogVersion = 0;
+        std::list<Entry> order; // Most recently used first
+        std::unordered_map<uint64_t, typename std::list<Entry>::iterator> entries;
+    };
+
+    std::array<Shard, SHARD_COUNT> shards;
+    size_t shardCapacity;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> evictions{0};
+    std::atomic<uint64_t> invalidations{0};
+
+    Shard& shardFor(uint64_t hash) { return shards[(hash >> 59) % SHARD_COUNT]; }
+
+    // Called with the shard locked; returns false if the caller holds an older catalog than the shard
+    bool syncVersion(Shard& shard, uint64_t catalogVersion) {
+        if (catalogVersion < shard.catalogVersion) return false;
+        if (catalogVersion > shard.catalogVersion) {
+            if (!shard.entries.empty()) ++invalidations;
+            shard.order.clear();
+            shard.entries.clear();
+            shard.catalogVersion = catalogVersion;
+        }
+        return true;
+    }
+
+public:
+    explicit ConfigurationCache(size_t capacity = 4096)
+        : shardCapacity(std::max<size_t>(1, capacity / SHARD_COUNT)) {}
+
+    std::optional<Value> find(const ConfigurationKey& key, uint64_t catalogVersion) {
+        Shard& shard = shardFor(key.hash);
+        std::lock_guard lock(shard.mutex);
+        if (syncVersion(shard, catalogVersion)) {
+            auto it = shard.entries.find(key.hash);
+            if (it != shard.entries.end() && it->second->canonical == key.canonical) {
+                shard.order.splice(shard.order.begin(), shard.order, it->second);
+                ++hits;
+                return it->second->value;
+            }
+        }
+        ++misses;
+        return std::nullopt;
+    }
+
+    void insert(const ConfigurationKey& key, uint64_t catalogVersion, const Value& value) {
+        Shard& shard = shardFor(key.hash);
+        std::lock_guard lock(shard.mutex);
+        if (!syncVersion(shard, catalogVersion)) return;
+
+        auto it = shard.entries.find(key.hash);
+        if (it != shard.entries.end()) {
+            // Same hash: refresh, or replace a colliding configuration
+            it->second->canonical = key.canonical;
+            it->second->value = value;
+            shard.order.splice(shard.order.begin(), shard.order, it->second);
+            return;
+        }
+
+        if (shard.entries.size() >= shardCapacity) {
+            shard.entries.erase(shard.order.back().hash);
+            shard.order.pop_back();
+            ++evictions;
+        }
+        shard.order.push_front(Entry{key.hash, key.canonical, value});
+        shard.entries.emplace(key.hash, shard.order.begin());
+    }
+
+    // Computes outside the shard lock, so a slow computation does not block other threads
+    template <typename Compute>
+    Value getOrCompute(const ConfigurationKey& key, uint64_t catalogVersion, Compute&& compute) {
+        if (auto cached = find(key, catalogVersion)) {
+            return *cached;
+        }
+        Value value = compute();
+        insert(key, catalogVersion, value);
+        return value;
+    }
+
+    Stats getStats() {
+        Stats stats{hits.load(), misses.load(), evictions.load(), invalidations.load(), 0};
+        for (auto& shard : shards) {
+            std::lock_guard lock(shard.mutex);
+            stats.entries += shard.entries.size();
+        }
+        return stats;
+    }
+
+    // Heap held by the entries: list and hash nodes, bucket arrays and canonical keys
+    size_t getMemoryBytes() {
+        constexpr size_t listNode = sizeof(Entry) + 2 * sizeof(void*);
+        constexpr size_t hashNode = sizeof(typename decltype(Shard::entries)::value_type) + sizeof(void*);
+        const size_t inlineCapacity = std::string().capacity();
+        size_t bytes = 0;
+        for (auto& shard : shards) {
+            std::lock_guard lock(shard.mutex);
+            if (!shard.entries.empty()) bytes += shard.entries.bucket_count() * sizeof(void*);
+            for (const Entry& entry : shard.order) {
+                bytes += listNode + hashNode;
+                if (entry.canonical.capacity() > inlineCapacity) bytes += entry.canonical.capacity() + 1;
+            }
+        }
+        return bytes;
+    }
+};
+
+using QuoteCache = ConfigurationCache<QuoteBreakdown>;
+
+// Saved configurations grouped by configuration hash, used to point out and find duplicate saves
+class SavedConfigurationIndex {
+private:
+    std::unordered_map<uint64_t, std::vector<std::pair<std::string, std::filesystem::path>>> files;
+
+public:
+    void scan(const std::string& directory) {
+        files.clear();
+        for (const auto& path : listSavedConfigurations(directory)) {
+            std::ifstream input(path);
+            SavedConfiguration config;
+            std::string error;
+            if (input.is_open() && readSavedConfiguration(input, config, error)) {
+                add(configurationKey(config), path);
+            }
+        }
+    }
+
+    // Records the configuration a path now holds, replacing what the path held before
+    void add(const ConfigurationKey& key, const std::filesystem::path& path) {
+        remove(path);
+        files[key.hash].emplace_back(key.canonical, path.lexically_normal());
+    }
+
+    void remove(const std::filesystem::path& path) {
+        std::filesystem::path normal = path.lexically_normal();
+        for (auto it = files.begin(); it != files.end();) {
+            std::erase_if(it->second, [&normal](const auto& entry) { return entry.second == normal; });
+            it = it->second.empty() ? files.erase(it) : std::next(it);
+        }
+    }
+
+    // First saved file with exactly this configuration
+    std::optional<std::filesystem::path> find(const ConfigurationKey& key) const {
+        auto it = files.find(key.hash);
+        if (it != files.end()) {
+            for (const auto& [canonical, path] : it->second) {
+                if (canonical == key.canonical) return path;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Groups of files holding the same configuration, each sorted by path
+    std::vector<std::vector<std::filesystem::path>> duplicates() const {
+        std::vector<std::vector<std::filesystem::path>> groups;
+        for (const auto& [hash, entries] : files) {
+            std::map<std::string, std::vector<std::filesystem::path>> byCanonical;
+            for (const auto& [canonical, path] : entries) byCanonical[canonical].push_back(path);
+            for (auto& [canonical, paths] : byCanonical) {
+                if (paths.size() > 1) {
+                    std::sort(paths.begin(), paths.end());
+                    groups.push_back(std::move(paths));
+                }
+            }
+        }
+        std::sort(groups.begin(), groups.end());
+        return groups;
+    }
+};
+
+// HTML report, written to disk as the content arrives
+class HtmlReportSink : public ReportSink {
+private:
+    std::ofstream out;
+    bool tableOpen = false;
+
+    static std::string escape(const std::string& text) {
+        std::string result;
+        result.reserve(text.size());
+        for (char c : text) {
+            switch (c) {
+                case '&': result += "&amp;"; break;
+                case '<': result += "&lt;"; break;
+                case '>': result += "&gt;"; break;
+                case '"': result += "&quot;"; break;
+                default: result += c;
+            }
+        }
+        return result;
+    }
+
+    void openTable() {
+        if (!tableOpen) {
+            out << "<table>\n";
+            tableOpen = true;
+        }
+    }
+
+    void closeTable() {
+        if (tableOpen) {
+            out << "</table>\n";
+            tableOpen = false;
+        }
+    }
+
+public:
+    explicit HtmlReportSink(const std::string& path) : out(path) {
+        out << "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n"
+            << "<title>Vehicle configuration report</title>\n"
+            << "<style>body{font-family:sans-serif;margin:2em}table{border-collapse:collapse;min-width:32em}"
+            << "th{text-align:left;font-weight:normal;padding:2px 1em 2px 0}td{text-align:right}"
+            << "td.note{text-align:left;color:#666;font-size:90%;padding-left:1em}"
+            << "tr.total th,tr.total td{font-weight:bold;border-top:1px solid #999}</style>\n"
+            << "</head>\n<body>\n";
+    }
+
+    bool isOpen() const { return out.is_open(); }
+
+    void title(const std::string& text) override {
+        closeTable();
+        out << "<h1>" << escape(text) << "</h1>\n";
+    }
+
+    void section(const std::string& text) override {
+        closeTable();
+        out << "<h2>" << escape(text) << "</h2>\n";
+    }
+
+    void field(const std::string& label, const std::string& value) override {
+        openTable();
+        out << "<tr><th>" << escape(label) << "</th><td>" << escape(value) << "</td></tr>\n";
+    }
+
+    void note(const std::string& text) override {
+        openTable();
+        out << "<tr><td class=\"note\" colspan=\"2\">" << escape(text) << "</td></tr>\n";
+    }
+
+    void total(const std::string& label, const std::string& value) override {
+        openTable();
+        out << "<tr class=\"total\"><th>" << escape(label) << "</th><td>" << escape(value) << "</td></tr>\n";
+    }
+
+    bool finish() override {
+        closeTable();
+        out << "</body>\n</html>\n";
+        out.close();
+        return !out.fail();
+    }
+};
+
+// Minimal PDF 1.4 writer using the standard Helvetica fonts. Each page's content stream is
+// written as it is produced; only the object offsets are kept for the cross-reference table.
+class PdfReportSink : public ReportSink {
+private:
+    static constexpr int CATALOG_OBJECT = 1;
+    static constexpr int PAGES_OBJECT = 2;
+    static constexpr int REGULAR_FONT_OBJECT = 3;
+    static constexpr int BOLD_FONT_OBJECT = 4;
+    static constexpr double PAGE_WIDTH = 595.0;
+    static constexpr double PAGE_HEIGHT = 842.0;
+    static constexpr double MARGIN = 50.0;
+    static constexpr double VALUE_COLUMN = 320.0;
+
+    std::ofstream out;
+    std::vector<std::streamoff> offsets; // Indexed by object number
+    std::vector<int> pageObjects;
+    int contentObject = 0;
+    std::streamoff contentStart = 0;
+    double cursorY = 0.0;
+    bool pageOpen = false;
+
+    int reserveObject() {
+        offsets.push_back(0);
+        return static_cast<int>(offsets.size() - 1);
+    }
+
+    void beginObject(int number) {
+        offsets[number] = out.tellp();
+        out << number << " 0 obj\n";
+    }
+
+    // PDF string literal; non-ASCII characters are replaced since the base fonts only cover Latin-1
+    static std::string escape(const std::string& text) {
+        std::string result;
+        for (unsigned char c : text) {
+            if (c == '(' || c == ')' || c == '\\') {
+                result += '\\';
+                result += static_cast<char>(c);
+            } else if (c >= 0x80) {
+                if (c >= 0xC0) result += '?'; // Skip UTF-8 continuation bytes
+            } else {
+                result += static_cast<char>(c);
+            }
+        }
+        return result;
+    }
+
+    void beginPage() {
+        contentObject = reserveObject();
+        beginObject(contentObject);
+        out << "<< /Length " << contentObject + 1 << " 0 R >>\nstream\n";
+        contentStart = out.tellp();
+        cursorY = PAGE_HEIGHT - MARGIN;
+        pageOpen = true;
+    }
+
+    void endPage() {
+        if (!pageOpen) return;
+        std::streamoff length = out.tellp() - contentStart;
+        out << "endstream\nendobj\n";
+
+        int lengthObject = reserveObject();
+        beginObject(lengthObject);
+        out << length << "\nendobj\n";
+
+        int pageObject = reserveObject();
+        beginObject(pageObject);
+        out << "<< /Type /Page /Parent " << PAGES_OBJECT << " 0 R /MediaBox [0 0 " << PAGE_WIDTH << " " << PAGE_HEIGHT
+            << "] /Resources << /Font << /F1 " << REGULAR_FONT_OBJECT << " 0 R /F2 " << BOLD_FONT_OBJECT
+            << " 0 R >> >> /Contents " << contentObject << " 0 R >>\nendobj\n";
+        pageObjects.push_back(pageObject);
+        pageOpen = false;
+    }
+
+    // Reserves vertical space for a line, starting a new page when the current one is full
+    void advance(double height) {
+        if (!pageOpen || cursorY - height < MARGIN) {
+            endPage();
+            beginPage();
+        }
+        cursorY -= height;
+    }
+
+    void text(const std::string& value, double x, bool bold, double size) {
+        out << "BT /" << (bold ? "F2 " : "F1 ") << size << " Tf " << x << " " << cursorY
+            << " Td (" << escape(value) << ") Tj ET\n";
+    }
+
+public:
+    explicit PdfReportSink(const std::string& path) : out(path, std::ios::binary), offsets(5, 0) {
+        out << "%PDF-1.4\n";
+        beginObject(CATALOG_OBJECT);
+        out << "<< /Type /Catalog /Pages " << PAGES_OBJECT << " 0 R >>\nendobj\n";
+        beginObject(REGULAR_FONT_OBJECT);
+        out << "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica /Encoding /WinAnsiEncoding >>\nendobj\n";
+        beginObject(BOLD_FONT_OBJECT);
+        out << "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica-Bold /Encoding /WinAnsiEncoding >>\nendobj\n";
+    }
+
+    bool isOpen() const { return out.is_open(); }
+
+    void title(const std::string& value) override {
+        advance(24);
+        text(value, MARGIN, true, 16);
+    }
+
+    void section(const std::string& value) override {
+        advance(24);
+        text(value, MARGIN, true, 12);
+    }
+
+    void field(const std::string& label, const std::string& value) override {
+        advance(14);
+        text(label, MARGIN + 10, false, 10);
+        text(value, VALUE_COLUMN, false, 10);
+    }
+
+    void note(const std::string& value) override {
+        advance(12);
+        text(value, MARGIN + 20, false, 8);
+    }
+
+    void total(const std::string& label, const std::string& value) override {
+        advance(16);
+        text(label, MARGIN + 10, true, 10);
+        text(value, VALUE_COLUMN, true, 10);
+    }
+
+    bool finish() override {
+        if (pageObjects.empty()) advance(0);
+        endPage();
+
+        beginObject(PAGES_OBJECT);
+        out << "<< /Type /Pages /Count " << pageObjects.size() << " /Kids [";
+        for (int page : pageObjects) {
+            out << " " << page << " 0 R";
+        }
+        out << " ] >>\nendobj\n";
+
+        std::streamoff xrefOffset = out.tellp();
+        out << "xref\n0 " << offsets.size() << "\n0000000000 65535 f \n";
+        for (size_t i = 1; i < offsets.size(); ++i) {
+            out << std::setw(10) << std::setfill('0') << offsets[i] << " 00000 n \n";
+        }
+        out << std::setfill(' ');
+        out << "trailer\n<< /Size " << offsets.size() << " /Root " << CATALOG_OBJECT << " 0 R >>\n"
+            << "startxref\n" << xrefOffset << "\n%%EOF\n";
+        out.close();
+        return !out.fail();
+    }
+};
+
+// Streams a vehicle report to disk; the format follows the file extension (.pdf or .html)
+bool renderReport(const Vehicle& vehicle, const std::filesystem::path& path) {
+    if (path.extension() == ".pdf") {
+        PdfReportSink report(path.string());
+        if (!report.isOpen()) return false;
+        vehicle.writeReport(report);
+        return report.finish();
+    }
+
+    HtmlReportSink report(path.string());
+    if (!report.isOpen()) return false;
+    vehicle.writeReport(report);
+    return report.finish();
+}
+
+// Fixed-size worker pool for batch jobs
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable allDone;
+    size_t activeTasks = 0;
+    bool stopping = false;
+
+    void workerLoop() {
+        AllocationScope scope(MemorySubsystem::BATCH);
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+                ++activeTasks;
+            }
+
+            task();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--activeTasks == 0 && tasks.empty()) {
+                allDone.notify_all();
+            }
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t threadCount) {
+        threadCount = std::max<size_t>(1, threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        taskAvailable.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t size() const { return workers.size(); }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        taskAvailable.notify_one();
+    }
+
+    // Blocks until every submitted task has finished
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        allDone.wait(lock, [this] { return tasks.empty() && activeTasks == 0; });
+    }
+};
+
+// Blocking FIFO with a fixed capacity; connects the stages of streaming pipelines
+template <typename T>
+class BoundedQueue {
+private:
+    std::deque<T> items;
+    size_t capacity;
+    bool closed = false;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(std::max<size_t>(1, capacity)) {}
+
+    // Waits for free space; returns false if the queue was closed
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+        if (closed) return false;
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Waits for an item; returns nothing once the queue is closed and drained
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+        if (items.empty()) return std::nullopt;
+        T item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return item;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+};
+
+// Starts worker threads that take items from one queue, process them and pass them on.
+// The output queue is closed when the last worker sees the input drained.
+template <typename T, typename Process>
+void startPipelineStage(std::vector<std::thread>& threads, size_t workers,
+                        BoundedQueue<T>& input, BoundedQueue<T>& output, Process process) {
+    auto remaining = std::make_shared<std::atomic<size_t>>(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        threads.emplace_back([&input, &output, process, remaining] {
+            while (auto item = input.pop()) {
+                process(*item);
+                output.push(std::move(*item));
+            }
+            if (remaining->fetch_sub(1) == 1) {
+                output.close();
+            }
+        });
+    }
+}
+
+// Progress and outcome of a background I/O job. The worker updates it; the UI thread only reads it.
+struct IoJob {
+    std::string description;
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> total{0}; // Units of work (bytes, files); 0 while unknown
+    std::atomic<bool> finished{false};
+    bool succeeded = false; // Valid once finished
+    std::string message;
+    std::function<void()> onSuccess; // Run by whoever takes the outcome of a successful job
+
+    double progress() const {
+        uint64_t units = total.load(std::memory_order_relaxed);
+        if (units == 0) return 0.0;
+        return std::min(1.0, static_cast<double>(completed.load(std::memory_order_relaxed)) / static_cast<double>(units));
+    }
+};
+
+// Single thread that runs file reads and writes in submission order, off the UI thread.
+// Jobs stay listed until the UI has taken their outcome; queued jobs finish before shutdown.
+class BackgroundIoWorker {
+private:
+    using Work = std::function<bool(IoJob&)>;
+
+    std::deque<std::pair<std::shared_ptr<IoJob>, Work>> queue;
+    std::vector<std::shared_ptr<IoJob>> jobs;
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable jobFinished;
+    bool stopping = false;
+    std::thread thread;
+
+    void run() {
+        AllocationScope scope(MemorySubsystem::BACKGROUND_IO);
+        while (true) {
+            std::pair<std::shared_ptr<IoJob>, Work> next;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                workAvailable.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (queue.empty()) return;
+                next = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            IoJob& job = *next.first;
+            job.succeeded = next.second(job);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                job.finished.store(true, std::memory_order_release);
+            }
+            jobFinished.notify_all();
+        }
+    }
+
+public:
+    BackgroundIoWorker() : thread([this] { run(); }) {}
+
+    ~BackgroundIoWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        thread.join();
+    }
+
+    std::shared_ptr<IoJob> submit(std::string description, Work work, std::function<void()> onSuccess = {}) {
+        auto job = std::make_shared<IoJob>();
+        job->description = std::move(description);
+        job->onSuccess = std::move(onSuccess);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(job);
+            queue.emplace_back(job, std::move(work));
+        }
+        workAvailable.notify_one();
+        return job;
+    }
+
+    // Drops a job whose outcome the caller handles itself
+    void release(const std::shared_ptr<IoJob>& job) {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.erase(std::remove(jobs.begin(), jobs.end(), job), jobs.end());
+    }
+
+    // Jobs whose outcome has not been taken yet, oldest first
+    std::vector<std::shared_ptr<IoJob>> pendingJobs() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return jobs;
+    }
+
+    // Removes finished jobs from the list and returns them, after running the success callbacks
+    // on the calling thread
+    std::vector<std::shared_ptr<IoJob>> takeFinished() {
+        std::vector<std::shared_ptr<IoJob>> finished;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto unfinished = std::stable_partition(jobs.begin(), jobs.end(),
+                [](const std::shared_ptr<IoJob>& job) { return !job->finished.load(std::memory_order_acquire); });
+            finished.assign(unfinished, jobs.end());
+            jobs.erase(unfinished, jobs.end());
+        }
+        for (const auto& job : finished) {
+            if (job->succeeded && job->onSuccess) job->onSuccess();
+        }
+        return finished;
+    }
+
+    // Waits up to timeout for the job; returns true if it has finished
+    bool waitFor(const IoJob& job, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return jobFinished.wait_for(lock, timeout, [&job] { return job.finished.load(std::memory_order_acquire); });
+    }
+};
+
+// Writes text to a file in chunks, reporting bytes written as progress
+bool writeFileWithProgress(const std::string& path, std::string_view contents, IoJob& job) {
+    constexpr size_t CHUNK = 64 * 1024;
+    job.total = std::max<size_t>(1, contents.size());
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        job.message = "Cannot open file for writing: " + path;
+        return false;
+    }
+    for (size_t offset = 0; offset < contents.size(); offset += CHUNK) {
+        size_t size = std::min(CHUNK, contents.size() - offset);
+        file.write(contents.data() + offset, static_cast<std::streamsize>(size));
+        job.completed += size;
+    }
+    file.close();
+    if (file.fail()) {
+        job.message = "Cannot write " + path;
+        return false;
+    }
+    job.completed = job.total.load();
+    return true;
+}
+
+// Reads a whole file in chunks, reporting bytes read as progress
+bool readFileWithProgress(const std::string& path, std::string& contents, IoJob& job) {
+    constexpr size_t CHUNK = 64 * 1024;
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        job.message = "Cannot open file: " + path;
+        return false;
+    }
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    job.total = ec ? 1 : std::max<uintmax_t>(1, size);
+    contents.clear();
+    char chunk[CHUNK];
+    while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0) {
+        contents.append(chunk, static_cast<size_t>(file.gcount()));
+        job.completed += static_cast<uint64_t>(file.gcount());
+    }
+    job.completed = job.total.load();
+    return true;
+}
+
+// True once stdin has input to read, or after the timeout. Reading still goes through std::cin;
+// this only tells whether that read would block.
+bool waitForInput(std::chrono::milliseconds timeout) {
+    if (std::cin.rdbuf()->in_avail() > 0) return true;
+#ifdef _WIN32
+    return true;
+#else
+    pollfd input{STDIN_FILENO, POLLIN, 0};
+    return poll(&input, 1, static_cast<int>(timeout.count())) > 0;
+#endif
+}
+
+// One line of spinner: the frame advances with a timer, the percentage comes from the job itself
+std::string spinnerLine(const IoJob& job, size_t frame) {
+    static constexpr std::string_view frames[] = {"|", "/", "-", "\\"};
+    std::ostringstream line;
+    line << COLOR_CYAN << frames[frame % std::size(frames)] << COLOR_RESET << " " << job.description;
+    if (job.total.load(std::memory_order_relaxed) > 0) {
+        line << " " << static_cast<int>(job.progress() * 100) << "%";
+    }
+    return line.str();
+}
+
+void printJobOutcome(const IoJob& job) {
+    if (job.succeeded) {
+        console() << COLOR_GREEN << "✓ " << job.message << COLOR_RESET << std::endl;
+    } else {
+        console() << COLOR_RED << "✗ " << job.message << COLOR_RESET << std::endl;
+    }
+}
+
+// Prints the outcome of background jobs that finished since the last call
+void reportFinishedJobs(BackgroundIoWorker& worker) {
+    for (const auto& job : worker.takeFinished()) {
+        printJobOutcome(*job);
+    }
+}
+
+// Shows a spinner with the job's progress until it finishes
+void waitForJob(BackgroundIoWorker& worker, const IoJob& job) {
+    for (size_t frame = 0; !worker.waitFor(job, std::chrono::milliseconds(100)); ++frame) {
+        console() << "\r\033[K" << spinnerLine(job, frame) << std::flush;
+    }
+    console() << "\r\033[K" << std::flush;
+}
+
+// Waits for the user to type while background jobs run: the prompt line shows a spinner for the
+// oldest running job and outcomes are printed as they arrive
+void waitForInputWithStatus(BackgroundIoWorker& worker, const std::string& prompt) {
+    bool statusShown = false;
+    for (size_t frame = 0; !waitForInput(std::chrono::milliseconds(100)); ++frame) {
+        auto finished = worker.takeFinished();
+        auto pending = worker.pendingJobs();
+        if (finished.empty() && pending.empty() && !statusShown) continue;
+
+        console() << "\r\033[K";
+        for (const auto& job : finished) printJobOutcome(*job);
+        if (!pending.empty()) {
+            console() << spinnerLine(*pending.front(), frame) << "  ";
+        }
+        console() << prompt << std::flush;
+        statusShown = !pending.empty();
+    }
+}
+
+// Replaces a file by writing a temporary file next to it and renaming it over the original, so
+// readers and crashes see either the old or the new contents, never a partial write
+bool writeFileAtomically(const std::string& path, std::string_view contents, std::string& error) {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        file.close();
+        if (file.fail()) {
+            error = "Cannot write " + temporary;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        error = "Cannot replace " + path + ": " + ec.message();
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+// Writes the latest configuration text once changes have been quiet for a while: a burst of
+// changes becomes a single write, done on the autosaver's own thread
+class Autosaver {
+private:
+    std::string path;
+    std::chrono::milliseconds quietPeriod;
+
+    std::mutex mutex;
+    std::condition_variable_any changed;
+    std::string pendingText;
+    bool pending = false;
+    std::chrono::steady_clock::time_point deadline;
+    uint64_t generation = 0; // Bumped by discard, so a write already on its way is dropped
+    size_t requests = 0;
+    size_t writes = 0;
+    bool written = false; // Whether the file at path is one this autosaver wrote
+    std::string lastError;
+
+    std::mutex writeMutex; // Serializes writes with discard
+    std::jthread thread; // Last, so it stops before the state above goes away
+
+    void write(const std::string& text, uint64_t textGeneration) {
+        std::lock_guard<std::mutex> writeLock(writeMutex);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (textGeneration != generation) return;
+        }
+        std::string error;
+        bool ok = writeFileAtomically(path, text, error);
+        std::lock_guard<std::mutex> lock(mutex);
+        ++writes;
+        written = written || ok;
+        lastError = ok ? std::string() : error;
+    }
+
+    void run(std::stop_token stopToken) {
+        AllocationScope scope(MemorySubsystem::BACKGROUND_IO);
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopToken.stop_requested()) {
+            if (!pending) {
+                changed.wait(lock, stopToken, [this] { return pending; });
+                continue;
+            }
+            // Each new change moves the deadline, so only a quiet period lets the write through
+            changed.wait_until(lock, stopToken, deadline, [] { return false; });
+            if (stopToken.stop_requested() || std::chrono::steady_clock::now() < deadline) continue;
+
+            std::string text = std::move(pendingText);
+            uint64_t textGeneration = generation;
+            pending = false;
+            lock.unlock();
+            write(text, textGeneration);
+            lock.lock();
+        }
+    }
+
+public:
+    explicit Autosaver(std::string path, std::chrono::milliseconds quietPeriod = std::chrono::milliseconds(1500))
+        : path(std::move(path)), quietPeriod(quietPeriod),
+          thread([this](std::stop_token stopToken) { run(stopToken); }) {}
+
+    // Anything still waiting for its quiet period is written before the autosaver goes away
+    ~Autosaver() {
+        thread.request_stop();
+        thread.join();
+        if (pending) write(pendingText, generation);
+    }
+
+    const std::string& getPath() const { return path; }
+
+    // Replaces the text waiting to be written and restarts the quiet period
+    void schedule(std::string text) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingText = std::move(text);
+            pending = true;
+            deadline = std::chrono::steady_clock::now() + quietPeriod;
+            ++requests;
+        }
+        changed.notify_one();
+    }
+
+    // Drops any pending write and deletes the autosave, once the work is safely saved elsewhere.
+    // A file this autosaver never wrote is left alone.
+    void discard() {
+        std::lock_guard<std::mutex> writeLock(writeMutex);
+        std::lock_guard<std::mutex> lock(mutex);
+        ++generation;
+        pending = false;
+        pendingText.clear();
+        if (written) {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            written = false;
+        }
+    }
+
+    size_t getRequestCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return requests;
+    }
+
+    size_t getWriteCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return writes;
+    }
+
+    std::string getLastError() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return lastError;
+    }
+};
+
+// Default worker count for batch jobs
+size_t defaultThreadCount() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+// Total cost of ownership: purchase price plus simulated energy and CO2 tax over the years of use
+struct TcoAssumptions {
+    unsigned years = 5;
+    double annualKm = 15000;
+    double mileageSpread = 0.25;        // Relative standard deviation of a year's mileage
+    double fuelPrice = 1.60;            // Per liter
+    double electricityPrice = 0.35;     // Per kWh
+    double energyPriceDrift = 0.03;     // Expected yearly change
+    double energyPriceVolatility = 0.15;
+    double co2TaxPerGram = 5.0;         // Yearly tax per g/km above the threshold
+    double co2TaxThreshold = 95;
+    double co2TaxRiseChance = 0.2;      // Chance per year that the tax rate rises by a quarter
+    size_t paths = 20000;
+    uint64_t seed = 2024;
+};
+
+// What a configuration costs to buy and to drive one kilometer
+struct TcoProfile {
+    std::string label;
+    double purchasePrice = 0.0;
+    double energyPerKm = 0.0; // Liters or kWh
+    bool electric = false;
+    double co2PerKm = 0.0;    // g/km
+};
+
+// Builds the profile from the configured engine, or from battery and range for electric vehicles
+bool makeTcoProfile(const Vehicle& vehicle, TcoProfile& profile, std::string& error) {
+    constexpr double ELECTRIC_MOTOR_KWH_PER_KM = 0.18;
+
+    profile.label = vehicle.getBrand() + " " + vehicle.getModel();
+    profile.purchasePrice = vehicle.calculateTotalPrice();
+
+    if (auto electricVehicle = dynamic_cast<const ElectricVehicle*>(&vehicle)) {
+        profile.electric = true;
+        profile.co2PerKm = 0.0;
+        profile.energyPerKm = electricVehicle->getRange() > 0
+            ? static_cast<double>(electricVehicle->getBatteryCapacity()) / electricVehicle->getRange()
+            : ELECTRIC_MOTOR_KWH_PER_KM;
+        return true;
+    }
+
+    const auto& engine = vehicle.getEngine();
+    if (!engine) {
+        error = "Select an engine to estimate running costs.";
+        return false;
+    }
+    profile.label += " " + engine->getName();
+    profile.co2PerKm = engine->getCO2Emissions();
+    if (engine->getFuelType() == "Electric") {
+        profile.electric = true;
+        profile.energyPerKm = ELECTRIC_MOTOR_KWH_PER_KM;
+    } else {
+        profile.energyPerKm = engine->getFuelConsumption() / 100.0;
+    }
+    return true;
+}
+
+struct TcoResult {
+    double purchase = 0.0;
+    double meanEnergy = 0.0;
+    double meanTax = 0.0;
+    double mean = 0.0;
+    double p5 = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    std::vector<double> totals; // Sorted, one per path
+};
+
+// Small, fast generator for Monte Carlo paths (SplitMix64)
+class SimulationRandom {
+private:
+    uint64_t state;
+
+public:
+    explicit SimulationRandom(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in (0, 1]
+    double uniform() { return ((next() >> 11) + 1) * 0x1.0p-53; }
+
+    // Two independent standard normals (Box-Muller)
+    std::pair<double, double> normalPair() {
+        double radius = std::sqrt(-2.0 * std::log(uniform()));
+        double angle = 2.0 * 3.14159265358979323846 * uniform();
+        return {radius * std::cos(angle), radius * std::sin(angle)};
+    }
+};
+
+// Monte Carlo TCO over many price paths for several candidates at once.
+// Paths are simulated in blocks spread over a thread pool. Each block draws its random factors once
+// into flat arrays (mileage, fuel and electricity price moves, tax rises) and every candidate is
+// evaluated against the same draws, so differences between candidates are not sampling noise.
+// The per-path accumulation is a branch-free loop over fixed-size arrays that the compiler vectorizes.
+// Blocks are seeded by index, so results do not depend on the number of threads.
+std::vector<TcoResult> simulateTco(std::span<const TcoProfile> profiles, const TcoAssumptions& assumptions,
+                                   size_t threadCount) {
+    constexpr size_t BLOCK = 256;
+    const size_t years = std::max(1u, assumptions.years);
+    const size_t blockCount = (std::max<size_t>(1, assumptions.paths) + BLOCK - 1) / BLOCK;
+    const size_t pathCount = blockCount * BLOCK;
+
+    // energy[profile][path] and tax[profile][path]
+    std::vector<std::vector<double>> energy(profiles.size(), std::vector<double>(pathCount));
+    std::vector<std::vector<double>> tax(profiles.size(), std::vector<double>(pathCount));
+
+    auto simulateBlock = [&](size_t block) {
+        SimulationRandom random(assumptions.seed ^ (0x632be59bd9b4e019ull * (block + 1)));
+
+        // Random factors for every year of every path in the block
+        std::vector<double> mileage(years * BLOCK);
+        std::vector<double> fuelMove(years * BLOCK);
+        std::vector<double> electricityMove(years * BLOCK);
+        std::vector<double> taxRise(years * BLOCK);
+        const double drift = assumptions.energyPriceDrift - 0.5 * assumptions.energyPriceVolatility * assumptions.energyPriceVolatility;
+        for (size_t i = 0; i < years * BLOCK; ++i) {
+            auto [z1, z2] = random.normalPair();
+            double z3 = random.normalPair().first;
+            mileage[i] = assumptions.annualKm * std::max(0.0, 1.0 + assumptions.mileageSpread * z1);
+            fuelMove[i] = std::exp(drift + assumptions.energyPriceVolatility * z2);
+            electricityMove[i] = std::exp(drift + assumptions.energyPriceVolatility * z3);
+            taxRise[i] = random.uniform() <= assumptions.co2TaxRiseChance ? 1.25 : 1.0;
+        }
+
+        alignas(64) double price[BLOCK];
+        alignas(64) double taxRate[BLOCK];
+        alignas(64) double energyCost[BLOCK];
+        alignas(64) double taxCost[BLOCK];
+
+        for (size_t p = 0; p < profiles.size(); ++p) {
+            const TcoProfile& profile = profiles[p];
+            const double* move = profile.electric ? electricityMove.data() : fuelMove.data();
+            const double startPrice = profile.electric ? assumptions.electricityPrice : assumptions.fuelPrice;
+            const double excessCo2 = std::max(0.0, profile.co2PerKm - assumptions.co2TaxThreshold);
+            const double energyPerKm = profile.energyPerKm;
+
+            std::fill(std::begin(price), std::end(price), startPrice);
+            std::fill(std::begin(taxRate), std::end(taxRate), assumptions.co2TaxPerGram);
+            std::fill(std::begin(energyCost), std::end(energyCost), 0.0);
+            std::fill(std::begin(taxCost), std::end(taxCost), 0.0);
+
+            for (size_t year = 0; year < years; ++year) {
+                const double* km = &mileage[year * BLOCK];
+                const double* priceMove = &move[year * BLOCK];
+                const double* rise = &taxRise[year * BLOCK];
+                for (size_t i = 0; i < BLOCK; ++i) {
+                    price[i] *= priceMove[i];
+                    taxRate[i] *= rise[i];
+                    energyCost[i] += km[i] * energyPerKm * price[i];
+                    taxCost[i] += excessCo2 * taxRate[i];
+                }
+            }
+
+            std::copy(std::begin(energyCost), std::end(energyCost), energy[p].begin() + block * BLOCK);
+            std::copy(std::begin(taxCost), std::end(taxCost), tax[p].begin() + block * BLOCK);
+        }
+    };
+
+    ThreadPool pool(std::min(threadCount, blockCount));
+    for (size_t block = 0; block < blockCount; ++block) {
+        pool.submit([&simulateBlock, block] { simulateBlock(block); });
+    }
+    pool.wait();
+
+    std::vector<TcoResult> results(profiles.size());
+    for (size_t p = 0; p < profiles.size(); ++p) {
+        TcoResult& result = results[p];
+        result.purchase = profiles[p].purchasePrice;
+        result.totals.resize(pathCount);
+        double energySum = 0.0;
+        double taxSum = 0.0;
+        for (size_t i = 0; i < pathCount; ++i) {
+            energySum += energy[p][i];
+            taxSum += tax[p][i];
+            result.totals[i] = result.purchase + energy[p][i] + tax[p][i];
+        }
+        result.meanEnergy = energySum / pathCount;
+        result.meanTax = taxSum / pathCount;
+        result.mean = result.purchase + result.meanEnergy + result.meanTax;
+
+        std::sort(result.totals.begin(), result.totals.end());
+        auto percentile = [&result](double q) {
+            return result.totals[std::min(result.totals.size() - 1, static_cast<size_t>(q * result.totals.size()))];
+        };
+        result.p5 = percentile(0.05);
+        result.p50 = percentile(0.50);
+        result.p95 = percentile(0.95);
+    }
+    return results;
+}
+
+// Text histogram of a TCO distribution
+void printTcoHistogram(const TcoResult& result, size_t bins = 10, size_t width = 40) {
+    if (result.totals.empty()) return;
+    double low = result.totals.front();
+    double high = result.totals.back();
+    double step = high > low ? (high - low) / bins : 1.0;
+
+    std::vector<size_t> counts(bins);
+    for (double total : result.totals) {
+        counts[std::min(bins - 1, static_cast<size_t>((total - low) / step))]++;
+    }
+    size_t largest = *std::max_element(counts.begin(), counts.end());
+    for (size_t bin = 0; bin < bins; ++bin) {
+        size_t bar = largest ? counts[bin] * width / largest : 0;
+        console() << std::right << std::setw(18) << formatPrice(low + bin * step) << " │"
+                  << COLOR_CYAN << std::string(bar, '#') << COLOR_RESET << std::endl;
+    }
+}
+
+// Financing of a configuration's total price. A loan pays off the price after the down payment in
+// equal monthly installments; a balloon loan leaves a share of the price due with the last one; a
+// lease leaves the modeled residual value, against which the customer returns or buys the vehicle.
+enum class FinanceKind : uint8_t {
+    LOAN,
+    BALLOON,
+    LEASE
+};
+
+std::string_view financeKindName(FinanceKind kind) {
+    switch (kind) {
+        case FinanceKind::LOAN: return "loan";
+        case FinanceKind::BALLOON: return "balloon";
+        case FinanceKind::LEASE: return "lease";
+    }
+    return "unknown";
+}
+
+bool parseFinanceKind(std::string_view text, FinanceKind& kind) {
+    if (text == "loan") kind = FinanceKind::LOAN;
+    else if (text == "balloon") kind = FinanceKind::BALLOON;
+    else if (text == "lease") kind = FinanceKind::LEASE;
+    else return false;
+    return true;
+}
+
+struct FinanceOffer {
+    FinanceKind kind = FinanceKind::LOAN;
+    unsigned months = 48;
+    double downPayment = 0.0;
+    double annualRate = 4.9;      // Nominal, percent
+    double balloonPercent = 30.0; // Of the price, due with the last installment
+    double annualKm = 15000;      // Drives the residual value of a lease
+};
+
+// Keeps offers typed by customers within what the calculator handles
+void clampFinanceOffer(FinanceOffer& offer) {
+    offer.months = std::clamp(offer.months, 1u, 120u);
+    offer.downPayment = std::max(0.0, offer.downPayment);
+    offer.annualRate = std::clamp(offer.annualRate, 0.0, 30.0);
+    offer.balloonPercent = std::clamp(offer.balloonPercent, 0.0, 80.0);
+    offer.annualKm = std::clamp(offer.annualKm, 0.0, 100000.0);
+}
+
+VehicleKind vehicleKindOf(const Vehicle& vehicle) {
+    if (dynamic_cast<const ElectricVehicle*>(&vehicle)) return VehicleKind::ELECTRIC;
+    if (dynamic_cast<const Motorcycle*>(&vehicle)) return VehicleKind::MOTORCYCLE;
+    return VehicleKind::CAR;
+}
+
+// Value left after a lease as a share of the price: a yearly loss by vehicle type, a steeper first
+// year, and two points per year for every 5,000 km a year above (or below) 15,000
+double leaseResidualShare(VehicleKind kind, unsigned months, double annualKm) {
+    constexpr double FIRST_YEAR_LOSS = 0.10;
+    double yearlyLoss = kind == VehicleKind::ELECTRIC ? 0.17 : kind == VehicleKind::MOTORCYCLE ? 0.14 : 0.12;
+    double years = months / 12.0;
+    double share = (1.0 - FIRST_YEAR_LOSS * std::min(years, 1.0)) * std::pow(1.0 - yearlyLoss, years);
+    share -= 0.02 * years * (annualKm - 15000.0) / 5000.0;
+    return std::clamp(share, 0.05, 0.90);
+}
+
+// Share of the price still owed after the last regular installment
+double financeFinalShare(const FinanceOffer& offer, VehicleKind kind) {
+    switch (offer.kind) {
+        case FinanceKind::LOAN: return 0.0;
+        case FinanceKind::BALLOON: return offer.balloonPercent / 100.0;
+        case FinanceKind::LEASE: return leaseResidualShare(kind, offer.months, offer.annualKm);
+    }
+    return 0.0;
+}
+
+// For n months at monthly rate r: payment = (financed - final * discount) * factor, with
+// discount = (1 + r)^-n and annuity factor = r / (1 - discount)
+struct AnnuityTerms {
+    double factor;
+    double discount;
+};
+
+AnnuityTerms annuityTerms(unsigned months, double annualRate) {
+    double rate = annualRate / 1200.0;
+    if (rate <= 0.0) return {1.0 / months, 1.0};
+    double discount = std::pow(1.0 + rate, -static_cast<double>(months));
+    return {rate / (1.0 - discount), discount};
+}
+
+struct AmortizationRow {
+    unsigned month;
+    double payment;
+    double interest;
+    double principal;
+    double balance;
+};
+
+struct FinancePlan {
+    double price = 0.0;
+    double financed = 0.0;
+    double monthlyPayment = 0.0;
+    double finalAmount = 0.0; // Balloon due, or residual value of a lease
+    bool finalCapped = false; // The balloon or residual was more than the financed amount
+    double totalInterest = 0.0;
+    double totalPaid = 0.0;   // Down payment, installments and balloon; a lease excludes the residual
+    std::vector<AmortizationRow> schedule;
+};
+
+FinancePlan planFinancing(double price, const FinanceOffer& offer, VehicleKind kind) {
+    FinancePlan plan;
+    plan.price = price;
+    plan.financed = std::max(0.0, price - offer.downPayment);
+    // Nothing more than was financed can be due at the end; a larger share would mean negative payments
+    plan.finalAmount = financeFinalShare(offer, kind) * price;
+    plan.finalCapped = plan.finalAmount > plan.financed;
+    plan.finalAmount = std::min(plan.finalAmount, plan.financed);
+    AnnuityTerms terms = annuityTerms(offer.months, offer.annualRate);
+    plan.monthlyPayment = (plan.financed - plan.finalAmount * terms.discount) * terms.factor;
+
+    double balance = plan.financed;
+    double rate = offer.annualRate / 1200.0;
+    plan.schedule.reserve(offer.months);
+    for (unsigned month = 1; month <= offer.months; ++month) {
+        double interest = balance * rate;
+        double principal = plan.monthlyPayment - interest;
+        balance -= principal;
+        plan.totalInterest += interest;
+        plan.schedule.push_back({month, plan.monthlyPayment, interest, principal, balance});
+    }
+    plan.totalPaid = offer.downPayment + plan.monthlyPayment * offer.months +
+                     (offer.kind == FinanceKind::BALLOON ? plan.finalAmount : 0.0);
+    return plan;
+}
+
+// Monthly payments for every term x down payment x rate combination on one price, laid out
+// [term][rate][down]. The inner loop is a branch-free pass over fixed-size blocks that the compiler
+// vectorizes; the amount due at the end is capped at the financed amount as in planFinancing.
+std::vector<double> financeGrid(double price, const FinanceOffer& offer, VehicleKind kind, std::span<const unsigned> terms,
+                                std::span<const double> downPayments, std::span<const double> rates) {
+    constexpr size_t BLOCK = 64;
+    std::vector<double> payments(terms.size() * rates.size() * downPayments.size());
+    double* out = payments.data();
+    for (unsigned months : terms) {
+        FinanceOffer termOffer = offer;
+        termOffer.months = months;
+        const double owedAtEnd = financeFinalShare(termOffer, kind) * price;
+        for (double rate : rates) {
+            const AnnuityTerms annuity = annuityTerms(months, rate);
+            const double discount = annuity.discount;
+            const double factor = annuity.factor;
+            for (size_t first = 0; first < downPayments.size(); first += BLOCK) {
+                const size_t count = std::min(BLOCK, downPayments.size() - first);
+                const double* down = downPayments.data() + first;
+                for (size_t i = 0; i < count; ++i) {
+                    const double financed = std::max(0.0, price - down[i]);
+                    out[first + i] = (financed - std::min(owedAtEnd, financed) * discount) * factor;
+                }
+            }
+            out += downPayments.size();
+        }
+    }
+    return payments;
+}
+
+// One offer across many configurations: the down payment is a share of each price and finalShares
+// holds each configuration's balloon or residual share, capped at the financed share
+void financeAcrossPrices(std::span<const double> prices, std::span<const double> finalShares, double downShare,
+                         unsigned months, double annualRate, std::span<double> payments) {
+    const AnnuityTerms annuity = annuityTerms(months, annualRate);
+    const double factor = annuity.factor;
+    const double discount = annuity.discount;
+    const double kept = std::max(0.0, 1.0 - downShare);
+    const size_t count = std::min({prices.size(), finalShares.size(), payments.size()});
+    const double* price = prices.data();
+    const double* share = finalShares.data();
+    double* out = payments.data();
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = price[i] * (kept - std::min(share[i], kept) * discount) * factor;
+    }
+}
+
+// A trip an EV owner might take
+struct TripProfile {
+    double distanceKm;
+    double speedKmh; // Average
+    double temperatureC;
+    double chargerKw; // Fast chargers available on the way
+};
+
+// Mix of commutes, regional and long-distance trips in all seasons, reproducible from the seed
+std::vector<TripProfile> generateTripProfiles(size_t count, uint64_t seed = 7) {
+    constexpr double chargerPowers[] = {50, 100, 150, 250};
+    SimulationRandom random(seed);
+    std::vector<TripProfile> trips(count);
+    for (auto& trip : trips) {
+        double kind = random.uniform();
+        if (kind < 0.6) {
+            trip.distanceKm = 5 + 55 * random.uniform();
+            trip.speedKmh = 30 + 30 * random.uniform();
+        } else if (kind < 0.9) {
+            trip.distanceKm = 60 + 240 * random.uniform();
+            trip.speedKmh = 60 + 40 * random.uniform();
+        } else {
+            trip.distanceKm = 300 + 700 * random.uniform();
+            trip.speedKmh = 90 + 40 * random.uniform();
+        }
+        trip.temperatureC = -15 + 50 * random.uniform();
+        trip.chargerKw = chargerPowers[random.next() % std::size(chargerPowers)];
+    }
+    return trips;
+}
+
+// Weight and constant power draw that equipment adds, by category
+struct EquipmentLoad {
+    EquipmentCategory category;
+    double massKg;
+    double powerKw;
+};
+
+constexpr EquipmentLoad equipmentLoads[] = {
+    {EquipmentCategory::COMFORT, 15, 0.10},
+    {EquipmentCategory::SAFETY, 4, 0.04},
+    {EquipmentCategory::MULTIMEDIA, 3, 0.05},
+    {EquipmentCategory::EXTERIOR, 20, 0.0},
+    {EquipmentCategory::PERFORMANCE, 25, 0.0},
+};
+
+// Energy-relevant properties of an electric vehicle configuration
+struct EvModel {
+    std::string label;
+    double batteryKwh = 0.0;
+    double ratedRangeKm = 0.0;
+    double ratedKwhPerKm = 0.0;
+    double massKg = 0.0;
+    double extraMassKg = 0.0;
+    double auxiliaryKw = 0.25; // Electronics and pumps without equipment
+    double maxChargeKw = 0.0;
+};
+
+bool makeEvModel(const Vehicle& vehicle, EvModel& model, std::string& error) {
+    auto electricVehicle = dynamic_cast<const ElectricVehicle*>(&vehicle);
+    if (!electricVehicle || electricVehicle->getRange() <= 0 || electricVehicle->getBatteryCapacity() <= 0) {
+        error = "Range simulation needs an electric vehicle.";
+        return false;
+    }
+
+    model.label = vehicle.getBrand() + " " + vehicle.getModel();
+    model.batteryKwh = electricVehicle->getBatteryCapacity();
+    model.ratedRangeKm = electricVehicle->getRange();
+    model.ratedKwhPerKm = model.batteryKwh / model.ratedRangeKm;
+    model.massKg = 1500 + 5 * model.batteryKwh;
+
+    // The rated fast charging time covers 10% to 80%
+    double chargingHours = std::max(1, electricVehicle->getChargingTime()) / 60.0;
+    model.maxChargeKw = 0.7 * model.batteryKwh / chargingHours;
+
+    for (const auto& item : vehicle.getSelectedEquipment()) {
+        for (const auto& load : equipmentLoads) {
+            if (load.category == item.getCategory()) {
+                model.extraMassKg += load.massKg;
+                model.auxiliaryKw += load.powerKw;
+            }
+        }
+    }
+    return true;
+}
+
+struct TripOutcome {
+    double rangeKm;
+    unsigned chargingStops;
+    double chargingMinutes;
+    double tripMinutes;
+};
+
+// Closed-form trip estimate: consumption grows with speed and weight, heating or cooling and
+// equipment draw a constant power, and cold reduces usable capacity and charging speed.
+// Trips start at 90% charge and fast charging runs from 10% to at most 80%.
+TripOutcome simulateTrip(const EvModel& model, const TripProfile& trip) {
+    constexpr double REFERENCE_SPEED = 70.0;
+    constexpr double STOP_OVERHEAD_MINUTES = 5.0;
+
+    double speed = std::max(5.0, trip.speedKmh);
+    double t = trip.temperatureC;
+    double climateKw = t < 18 ? std::min(4.0, 0.18 * (18 - t)) : t > 26 ? std::min(2.5, 0.12 * (t - 26)) : 0.0;
+    double speedFactor = 0.55 + 0.45 * (speed / REFERENCE_SPEED) * (speed / REFERENCE_SPEED);
+    double massFactor = 1.0 + 0.5 * model.extraMassKg / model.massKg;
+    double kwhPerKm = model.ratedKwhPerKm * speedFactor * massFactor + (model.auxiliaryKw + climateKw) / speed;
+
+    double usableKwh = model.batteryKwh * (t < 20 ? std::max(0.75, 1.0 - 0.008 * (20 - t)) : 1.0);
+    double chargeKw = std::min(trip.chargerKw, model.maxChargeKw) * (t < 5 ? 0.6 : 0.85);
+
+    TripOutcome outcome{};
+    outcome.rangeKm = usableKwh / kwhPerKm;
+
+    double firstLegKm = 0.8 * usableKwh / kwhPerKm;
+    double legKm = 0.7 * usableKwh / kwhPerKm;
+    if (trip.distanceKm > firstLegKm) {
+        outcome.chargingStops = static_cast<unsigned>(std::ceil((trip.distanceKm - firstLegKm) / legKm));
+        double missingKwh = (trip.distanceKm - firstLegKm) * kwhPerKm;
+        outcome.chargingMinutes = missingKwh / chargeKw * 60.0 + outcome.chargingStops * STOP_OVERHEAD_MINUTES;
+    }
+    outcome.tripMinutes = trip.distanceKm / speed * 60.0 + outcome.chargingMinutes;
+    return outcome;
+}
+
+struct EvSimulationSummary {
+    size_t trips = 0;
+    double ratedRangeKm = 0.0;
+    double meanRangeKm = 0.0;
+    double p10RangeKm = 0.0;
+    double p90RangeKm = 0.0;
+    double tripsWithoutStop = 0.0; // Fraction
+    size_t longTrips = 0;          // Over 300 km
+    double longTripStops = 0.0;    // Mean
+    double longTripChargingMinutes = 0.0;
+};
+
+using EvSimulationCache = ConfigurationCache<EvSimulationSummary>;
+
+// Runs every trip profile for one configuration, in blocks on a thread pool
+EvSimulationSummary simulateEvTrips(const EvModel& model, std::span<const TripProfile> trips, size_t threadCount) {
+    constexpr size_t BLOCK = 1024;
+    std::vector<TripOutcome> outcomes(trips.size());
+
+    size_t blockCount = (trips.size() + BLOCK - 1) / BLOCK;
+    ThreadPool pool(std::min(threadCount, std::max<size_t>(1, blockCount)));
+    for (size_t block = 0; block < blockCount; ++block) {
+        pool.submit([&, block] {
+            size_t end = std::min(trips.size(), (block + 1) * BLOCK);
+            for (size_t i = block * BLOCK; i < end; ++i) {
+                outcomes[i] = simulateTrip(model, trips[i]);
+            }
+        });
+    }
+    pool.wait();
+
+    EvSimulationSummary summary;
+    summary.trips = trips.size();
+    summary.ratedRangeKm = model.ratedRangeKm;
+    if (trips.empty()) return summary;
+
+    std::vector<double> ranges(trips.size());
+    size_t withoutStop = 0;
+    for (size_t i = 0; i < trips.size(); ++i) {
+        ranges[i] = outcomes[i].rangeKm;
+        summary.meanRangeKm += outcomes[i].rangeKm;
+        if (outcomes[i].chargingStops == 0) ++withoutStop;
+        if (trips[i].distanceKm > 300) {
+            ++summary.longTrips;
+            summary.longTripStops += outcomes[i].chargingStops;
+            summary.longTripChargingMinutes += outcomes[i].chargingMinutes;
+        }
+    }
+    summary.meanRangeKm /= trips.size();
+    summary.tripsWithoutStop = static_cast<double>(withoutStop) / trips.size();
+    if (summary.longTrips > 0) {
+        summary.longTripStops /= summary.longTrips;
+        summary.longTripChargingMinutes /= summary.longTrips;
+    }
+
+    std::sort(ranges.begin(), ranges.end());
+    summary.p10RangeKm = ranges[ranges.size() / 10];
+    summary.p90RangeKm = ranges[std::min(ranges.size() - 1, ranges.size() * 9 / 10)];
+    return summary;
+}
+
+// Only what changes energy use identifies an EV configuration: the model and its equipment
+ConfigurationKey evConfigurationKey(const Vehicle& vehicle) {
+    std::vector<std::string> names;
+    names.reserve(vehicle.getSelectedEquipment().size());
+    for (const auto& item : vehicle.getSelectedEquipment()) {
+        names.push_back(item.getName());
+    }
+    return makeConfigurationKey(vehicle.getBrand(), vehicle.getModel(), "",
+                                std::vector<std::string_view>(names.begin(), names.end()), "", 0.0);
+}
+
+// Catalog search: a trie over the distinct words of all names for as-you-type prefix queries, and a
+// trigram index with bounded edit distance for typos
+enum class SearchKind {
+    VEHICLE,
+    ENGINE,
+    EQUIPMENT
+};
+
+struct SearchHit {
+    SearchKind kind;
+    size_t index; // Position in its catalog table
+    std::string_view title;
+    double score;
+};
+
+// Lowercase words of a text; '.' is kept between digits so "1.4" stays one word
+std::vector<std::string> searchTokens(std::string_view text) {
+    std::vector<std::string> tokens;
+    std::string current;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        bool digitDot = c == '.' && !current.empty() && std::isdigit(static_cast<unsigned char>(current.back())) &&
+                        i + 1 < text.size() && std::isdigit(static_cast<unsigned char>(text[i + 1]));
+        if (std::isalnum(c) || c >= 0x80 || digitDot) {
+            current += static_cast<char>(std::tolower(c));
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) tokens.push_back(std::move(current));
+    return tokens;
+}
+
+// Edit distance counting a swap of adjacent letters as one edit (optimal string alignment),
+// giving up (returning limit + 1) once it must exceed limit
+size_t boundedEditDistance(std::string_view a, std::string_view b, size_t limit) {
+    constexpr size_t MAX_LENGTH = 64;
+    if (a.size() > b.size() + limit || b.size() > a.size() + limit) return limit + 1;
+    if (b.size() >= MAX_LENGTH) return a == b ? 0 : limit + 1;
+
+    // Three rotating rows of the distance matrix
+    std::array<std::array<uint8_t, MAX_LENGTH>, 3> rows;
+    uint8_t* beforePrevious = rows[0].data();
+    uint8_t* previous = rows[1].data();
+    uint8_t* current = rows[2].data();
+    std::iota(previous, previous + b.size() + 1, 0);
+    for (size_t i = 1; i <= a.size(); ++i) {
+        current[0] = static_cast<uint8_t>(std::min<size_t>(i, 255));
+        size_t rowMinimum = i;
+        for (size_t j = 1; j <= b.size(); ++j) {
+            size_t cost = std::min<size_t>({previous[j] + 1u, current[j - 1] + 1u, previous[j - 1] + (a[i - 1] == b[j - 1] ? 0u : 1u)});
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                cost = std::min<size_t>(cost, beforePrevious[j - 2] + 1u);
+            }
+            current[j] = static_cast<uint8_t>(std::min<size_t>(cost, 255));
+            rowMinimum = std::min<size_t>(rowMinimum, current[j]);
+        }
+        if (rowMinimum > limit) return limit + 1;
+        std::swap(beforePrevious, previous);
+        std::swap(previous, current);
+    }
+    return std::min<size_t>(previous[b.size()], limit + 1);
+}
+
+class SearchIndex {
+private:
+    static constexpr size_t TOP_PER_NODE = 16;
+    static constexpr size_t MAX_CANDIDATES = 20000;
+    static constexpr size_t MAX_FUZZY_CHECKS = 256;
+
+    // Kept small: queries touch thousands of entries, titles only for the results
+    struct Entry {
+        SearchKind kind;
+        uint32_t index;
+        uint32_t wordBegin; // Range in entryWords
+        uint32_t wordEnd;
+    };
+
+    // A word of an entry; title words weigh more than description words
+    struct EntryWord {
+        uint32_t word;
+        bool inTitle;
+    };
+
+    // Trie node: words with this prefix have ids [wordBegin, wordEnd) because ids follow sorted order
+    struct Node {
+        std::vector<std::pair<char, uint32_t>> children;
+        uint32_t wordBegin = 0;
+        uint32_t wordEnd = 0;
+        std::vector<uint32_t> top; // Best entries below this node, by static rank
+    };
+
+    std::vector<Entry> entries;
+    std::vector<std::string> titles;
+    std::vector<EntryWord> entryWords;
+    std::vector<std::string> words;           // Sorted; index is the word id
+    std::vector<uint32_t> postingOffsets;      // Entries containing word w: postings[offsets[w], offsets[w + 1])
+    std::vector<uint32_t> postings;
+    std::vector<Node> nodes;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> trigrams; // Packed trigram -> word ids
+
+    std::vector<std::pair<std::string, std::string>> pendingTexts; // Title, description until build()
+
+    // build() numbers entries in the default result order, so posting lists are sorted best first
+    static bool ranksBefore(uint32_t a, uint32_t b) { return a < b; }
+
+    static std::vector<uint32_t> wordTrigrams(std::string_view word) {
+        std::string padded = "^" + std::string(word);
+        std::vector<uint32_t> result;
+        for (size_t i = 0; i + 3 <= padded.size(); ++i) {
+            result.push_back(static_cast<unsigned char>(padded[i]) << 16 |
+                             static_cast<unsigned char>(padded[i + 1]) << 8 |
+                             static_cast<unsigned char>(padded[i + 2]));
+        }
+        return result;
+    }
+
+    const Node* findNode(std::string_view prefix) const {
+        uint32_t current = 0;
+        for (char c : prefix) {
+            const auto& children = nodes[current].children;
+            auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(c, uint32_t{0}));
+            if (it == children.end() || it->first != c) return nullptr;
+            current = it->second;
+        }
+        return &nodes[current];
+    }
+
+    // Words within a small edit distance of the token, or of a word's beginning while it is being typed
+    std::vector<uint32_t> fuzzyWords(std::string_view token) const {
+        std::vector<uint32_t> result;
+        if (token.size() < 3) return result;
+        size_t limit = token.size() <= 4 ? 1 : 2;
+
+        // Count shared trigrams per word; words sharing the most are checked first. Trigrams found in
+        // a large part of the vocabulary say little and are skipped unless nothing rarer is left.
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (uint32_t trigram : wordTrigrams(token)) {
+            auto it = trigrams.find(trigram);
+            if (it != trigrams.end()) lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+        size_t common = std::max<size_t>(1024, words.size() / 32);
+        while (lists.size() > 2 && lists.back()->size() > common) lists.pop_back();
+
+        std::vector<uint8_t> shared(words.size());
+        std::vector<uint32_t> touched;
+        for (const auto* list : lists) {
+            for (uint32_t word : *list) {
+                if (shared[word]++ == 0) touched.push_back(word);
+            }
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>> candidates;
+        candidates.reserve(touched.size());
+        for (uint32_t word : touched) {
+            // The word must be long enough to be within reach of the token
+            if (words[word].size() + limit >= token.size()) candidates.emplace_back(word, shared[word]);
+        }
+        size_t checks = std::min(candidates.size(), MAX_FUZZY_CHECKS);
+        std::partial_sort(candidates.begin(), candidates.begin() + checks, candidates.end(),
+                          [](const auto& a, const auto& b) { return a.second > b.second || (a.second == b.second && a.first < b.first); });
+        for (size_t i = 0; i < checks; ++i) {
+            std::string_view word = words[candidates[i].first];
+            size_t distance = boundedEditDistance(token, word, limit);
+            if (distance > limit && word.size() > token.size()) {
+                distance = boundedEditDistance(token, word.substr(0, token.size()), limit);
+            }
+            if (distance <= limit) result.push_back(candidates[i].first);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+public:
+    void add(SearchKind kind, size_t index, std::string_view title, std::string_view description = {}) {
+        entries.push_back(Entry{kind, static_cast<uint32_t>(index), 0, 0});
+        titles.emplace_back(title);
+        pendingTexts.emplace_back(title, description);
+    }
+
+    size_t size() const { return entries.size(); }
+
+    void build() {
+        // Default result order: vehicles first, then engines, then equipment; shorter titles first
+        std::vector<uint32_t> order(entries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+            if (entries[a].kind != entries[b].kind) return entries[a].kind < entries[b].kind;
+            return titles[a].size() < titles[b].size();
+        });
+        {
+            std::vector<Entry> sortedEntries;
+            std::vector<std::string> sortedTitles;
+            std::vector<std::pair<std::string, std::string>> sortedTexts;
+            for (uint32_t e : order) {
+                sortedEntries.push_back(entries[e]);
+                sortedTitles.push_back(std::move(titles[e]));
+                sortedTexts.push_back(std::move(pendingTexts[e]));
+            }
+            entries = std::move(sortedEntries);
+            titles = std::move(sortedTitles);
+            pendingTexts = std::move(sortedTexts);
+        }
+
+        // Vocabulary in sorted order, so every trie node covers a contiguous range of word ids
+        std::vector<std::vector<std::pair<std::string, bool>>> entryTokens(entries.size());
+        std::vector<std::string> vocabulary;
+        for (size_t e = 0; e < entries.size(); ++e) {
+            for (auto& token : searchTokens(pendingTexts[e].first)) entryTokens[e].emplace_back(std::move(token), true);
+            for (auto& token : searchTokens(pendingTexts[e].second)) entryTokens[e].emplace_back(std::move(token), false);
+            for (const auto& [token, inTitle] : entryTokens[e]) vocabulary.push_back(token);
+        }
+        pendingTexts.clear();
+        std::sort(vocabulary.begin(), vocabulary.end());
+        vocabulary.erase(std::unique(vocabulary.begin(), vocabulary.end()), vocabulary.end());
+        words = std::move(vocabulary);
+
+        auto wordId = [this](const std::string& token) {
+            return static_cast<uint32_t>(std::lower_bound(words.begin(), words.end(), token) - words.begin());
+        };
+
+        std::vector<std::vector<uint32_t>> wordEntries(words.size());
+        entryWords.clear();
+        for (size_t e = 0; e < entries.size(); ++e) {
+            entries[e].wordBegin = static_cast<uint32_t>(entryWords.size());
+            for (const auto& [token, inTitle] : entryTokens[e]) {
+                uint32_t id = wordId(token);
+                entryWords.push_back(EntryWord{id, inTitle});
+                if (wordEntries[id].empty() || wordEntries[id].back() != e) wordEntries[id].push_back(static_cast<uint32_t>(e));
+            }
+            entries[e].wordEnd = static_cast<uint32_t>(entryWords.size());
+        }
+
+        postingOffsets.assign(1, 0);
+        postings.clear();
+        for (const auto& list : wordEntries) {
+            postings.insert(postings.end(), list.begin(), list.end());
+            postingOffsets.push_back(static_cast<uint32_t>(postings.size()));
+        }
+
+        // Trie; nodes are created parent first, so a reverse pass sees children before parents
+        nodes.assign(1, Node{});
+        std::vector<std::vector<uint32_t>> ownEntries(1);
+        for (uint32_t id = 0; id < words.size(); ++id) {
+            uint32_t current = 0;
+            nodes[0].wordEnd = id + 1;
+            for (char c : words[id]) {
+                auto& children = nodes[current].children;
+                auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(c, uint32_t{0}));
+                if (it == children.end() || it->first != c) {
+                    uint32_t child = static_cast<uint32_t>(nodes.size());
+                    it = children.insert(it, {c, child});
+                    nodes.emplace_back();
+                    nodes.back().wordBegin = id;
+                    ownEntries.emplace_back();
+                }
+                current = it->second;
+                nodes[current].wordEnd = id + 1;
+            }
+            ownEntries[current].assign(postings.begin() + postingOffsets[id], postings.begin() + postingOffsets[id + 1]);
+        }
+
+        auto byRank = [this](uint32_t a, uint32_t b) { return ranksBefore(a, b); };
+        for (size_t n = nodes.size(); n-- > 0;) {
+            std::vector<uint32_t> candidates = std::move(ownEntries[n]);
+            for (const auto& [c, child] : nodes[n].children) {
+                candidates.insert(candidates.end(), nodes[child].top.begin(), nodes[child].top.end());
+            }
+            std::sort(candidates.begin(), candidates.end(), byRank);
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            if (candidates.size() > TOP_PER_NODE) candidates.resize(TOP_PER_NODE);
+            nodes[n].top = std::move(candidates);
+        }
+
+        trigrams.clear();
+        for (uint32_t id = 0; id < words.size(); ++id) {
+            for (uint32_t trigram : wordTrigrams(words[id])) {
+                auto& list = trigrams[trigram];
+                if (list.empty() || list.back() != id) list.push_back(id);
+            }
+        }
+    }
+
+    // Ranked entries matching every word of the query. Each query word matches entry words it
+    // begins (the last one may be half typed) or, failing that, words within a small edit distance.
+    std::vector<SearchHit> search(std::string_view query, size_t limit = 10) const {
+        std::vector<SearchHit> hits;
+        std::vector<std::string> tokens = searchTokens(query);
+        if (tokens.empty() || entries.empty()) return hits;
+
+        // Matching words per token: a prefix range, or a sorted list of fuzzy matches
+        struct TokenMatch {
+            const Node* node = nullptr;
+            std::vector<uint32_t> fuzzy;
+            uint32_t exactWord = UINT32_MAX;
+
+            bool matches(uint32_t word) const {
+                return node ? word >= node->wordBegin && word < node->wordEnd
+                            : std::binary_search(fuzzy.begin(), fuzzy.end(), word);
+            }
+        };
+        // Number of postings behind a token's words; word ids are contiguous in the posting offsets
+        auto postingCount = [this](const TokenMatch& match) {
+            if (match.node) return size_t{postingOffsets[match.node->wordEnd] - postingOffsets[match.node->wordBegin]};
+            size_t count = 0;
+            for (uint32_t word : match.fuzzy) count += postingOffsets[word + 1] - postingOffsets[word];
+            return count;
+        };
+        std::vector<TokenMatch> matches(tokens.size());
+        for (size_t t = 0; t < tokens.size(); ++t) {
+            matches[t].node = findNode(tokens[t]);
+            if (matches[t].node) {
+                auto exact = std::lower_bound(words.begin() + matches[t].node->wordBegin,
+                                              words.begin() + matches[t].node->wordEnd, tokens[t]);
+                if (exact != words.end() && *exact == tokens[t]) matches[t].exactWord = static_cast<uint32_t>(exact - words.begin());
+            } else {
+                matches[t].fuzzy = fuzzyWords(tokens[t]);
+                if (matches[t].fuzzy.empty()) return hits;
+            }
+        }
+
+        // Candidates come from the most selective token; a single prefix uses the node's precomputed best
+        size_t driver = 0;
+        for (size_t t = 1; t < tokens.size(); ++t) {
+            if (postingCount(matches[t]) < postingCount(matches[driver])) driver = t;
+        }
+        std::vector<uint32_t> gathered;
+        std::span<const uint32_t> candidates;
+        const TokenMatch& driving = matches[driver];
+        bool singleWord = driving.node ? driving.node->wordEnd - driving.node->wordBegin == 1 : driving.fuzzy.size() == 1;
+        if (tokens.size() == 1 && driving.node) {
+            gathered = driving.node->top;
+            // Entries with the exact word rank first even if their static rank is low
+            if (driving.exactWord != UINT32_MAX) {
+                size_t id = driving.exactWord;
+                size_t count = std::min<size_t>(postingOffsets[id + 1] - postingOffsets[id], TOP_PER_NODE);
+                gathered.insert(gathered.end(), postings.begin() + postingOffsets[id],
+                                postings.begin() + postingOffsets[id] + count);
+            }
+        } else if (singleWord) {
+            // One posting list is already in rank order and can be scanned in place
+            uint32_t word = driving.node ? driving.node->wordBegin : driving.fuzzy.front();
+            candidates = std::span<const uint32_t>(postings).subspan(postingOffsets[word], postingOffsets[word + 1] - postingOffsets[word]);
+        } else {
+            auto addWord = [&](uint32_t word) {
+                for (uint32_t p = postingOffsets[word]; p < postingOffsets[word + 1] && gathered.size() < MAX_CANDIDATES; ++p) {
+                    gathered.push_back(postings[p]);
+                }
+            };
+            if (driving.node) {
+                for (uint32_t word = driving.node->wordBegin; word < driving.node->wordEnd && gathered.size() < MAX_CANDIDATES; ++word) addWord(word);
+            } else {
+                for (uint32_t word : driving.fuzzy) addWord(word);
+            }
+        }
+        if (candidates.empty()) {
+            std::sort(gathered.begin(), gathered.end());
+            gathered.erase(std::unique(gathered.begin(), gathered.end()), gathered.end());
+            candidates = gathered;
+        }
+
+        // Score: per token 3 for an exact word, 2 for a prefix, 1 for a fuzzy match, +0.5 in the title.
+        // Candidates arrive best ranked first, so once enough of them reach the highest possible
+        // score no later candidate can displace them.
+        double bestPossible = 0.0;
+        for (const auto& match : matches) {
+            bestPossible += (match.exactWord != UINT32_MAX ? 3.0 : match.node ? 2.0 : 1.0) + 0.5;
+        }
+        size_t perfect = 0;
+        std::vector<std::pair<double, uint32_t>> scored;
+        for (uint32_t candidate : candidates) {
+            if (perfect >= limit) break;
+            const Entry& entry = entries[candidate];
+            double score = 0.0;
+            bool all = true;
+            for (size_t t = 0; t < tokens.size() && all; ++t) {
+                double best = 0.0;
+                for (uint32_t w = entry.wordBegin; w < entry.wordEnd; ++w) {
+                    const EntryWord& word = entryWords[w];
+                    if (!matches[t].matches(word.word)) continue;
+                    double value = matches[t].node ? (word.word == matches[t].exactWord ? 3.0 : 2.0) : 1.0;
+                    best = std::max(best, value + (word.inTitle ? 0.5 : 0.0));
+                }
+                all = best > 0.0;
+                score += best;
+            }
+            if (all) {
+                scored.emplace_back(score, candidate);
+                if (score >= bestPossible) ++perfect;
+            }
+        }
+
+        size_t count = std::min(limit, scored.size());
+        std::partial_sort(scored.begin(), scored.begin() + count, scored.end(), [](const auto& a, const auto& b) {
+            return a.first > b.first || (a.first == b.first && ranksBefore(a.second, b.second));
+        });
+        for (size_t i = 0; i < count; ++i) {
+            const Entry& entry = entries[scored[i].second];
+            hits.push_back(SearchHit{entry.kind, entry.index, titles[scored[i].second], scored[i].first});
+        }
+        return hits;
+    }
+};
+
+// Index over one catalog version: vehicles by brand and model, engines by name and fuel, equipment by name and description
+SearchIndex buildCatalogSearchIndex(const CatalogView& catalog) {
+    SearchIndex index;
+    for (size_t i = 0; i < catalog.vehicles.size(); ++i) {
+        const VehicleRecord& vehicle = catalog.vehicles[i];
+        index.add(SearchKind::VEHICLE, i, std::string(vehicle.brand) + " " + std::string(vehicle.model),
+                  std::string(vehicle.bodyType) + " " + std::string(vehicle.year));
+    }
+    for (size_t i = 0; i < catalog.engines.size(); ++i) {
+        index.add(SearchKind::ENGINE, i, catalog.engines[i].name, catalog.engines[i].fuelType);
+    }
+    for (size_t i = 0; i < catalog.equipment.size(); ++i) {
+        index.add(SearchKind::EQUIPMENT, i, catalog.equipment[i].name, catalog.equipment[i].description);
+    }
+    index.build();
+    return index;
+}
+
+// Catalog items in display order: grouped under headings, catalog order within a group. Items are
+// numbered by catalog position + 1, the id selectVehicle, selectEngine and addEquipment take, so a
+// number stays valid on every page. Printing a page formats only the items on it.
+constexpr size_t LISTING_PAGE_SIZE = 20;
+
+class CatalogListing {
+private:
+    struct Group {
+        std::string title;
+        size_t first; // Display position of the group's first item
+    };
+
+    std::vector<uint32_t> order; // Catalog positions in display order
+    std::vector<Group> groups;
+
+public:
+    // Groups items 0..count-1 by key(i), ordered by key; title(i) names the group of item i
+    template <typename Key, typename Title>
+    static CatalogListing build(size_t count, Key key, Title title) {
+        CatalogListing listing;
+        listing.order.resize(count);
+        std::iota(listing.order.begin(), listing.order.end(), 0u);
+        std::stable_sort(listing.order.begin(), listing.order.end(),
+                         [&key](uint32_t a, uint32_t b) { return key(a) < key(b); });
+        for (size_t i = 0; i < count; ++i) {
+            if (i == 0 || key(listing.order[i]) != key(listing.order[i - 1])) {
+                listing.groups.push_back({std::string(title(listing.order[i])), i});
+            }
+        }
+        return listing;
+    }
+
+    size_t size() const { return order.size(); }
+
+    size_t pageCount(size_t pageSize) const { return order.empty() ? 1 : (order.size() - 1) / pageSize + 1; }
+
+    // Prints one page, clamping page to the last one: the heading of each group on it and
+    // printItem(position) per item. Groups cut by the page break are marked as continued.
+    template <typename PrintItem>
+    void printPage(size_t& page, size_t pageSize, PrintItem printItem) const {
+        size_t pages = pageCount(pageSize);
+        page = std::min(page, pages - 1);
+        size_t begin = page * pageSize;
+        size_t end = begin + std::min(pageSize, order.size() - begin);
+
+        // The group holding the first item on the page
+        size_t group = std::upper_bound(groups.begin(), groups.end(), begin,
+                                        [](size_t position, const Group& g) { return position < g.first; }) -
+                       groups.begin() - 1;
+        for (size_t i = begin; i < end; ++i) {
+            if (i == begin || (group + 1 < groups.size() && groups[group + 1].first == i)) {
+                if (i != begin) ++group;
+                console() << COLOR_YELLOW << "\n" << groups[group].title
+                          << (groups[group].first == i ? ":" : " (continued):") << COLOR_RESET << std::endl;
+            }
+            printItem(order[i]);
+        }
+
+        if (pages > 1) {
+            console() << "\nPage " << page + 1 << " of " << pages << " (" << begin + 1 << "-" << end << " of "
+                      << order.size() << ") - n: next page, p: previous page" << std::endl;
+        }
+    }
+};
+
+std::string_view vehicleGroupTitle(VehicleKind kind) {
+    switch (kind) {
+        case VehicleKind::CAR: return "Cars";
+        case VehicleKind::MOTORCYCLE: return "Motorcycles";
+        case VehicleKind::ELECTRIC: return "Electric Vehicles";
+    }
+    return "Other";
+}
+
+CatalogListing buildVehicleListing(const CatalogView& catalog) {
+    auto title = [&catalog](size_t i) { return vehicleGroupTitle(catalog.vehicles[i].kind); };
+    return CatalogListing::build(catalog.vehicles.size(), title, title);
+}
+
+CatalogListing buildEngineListing(const CatalogView& catalog) {
+    return CatalogListing::build(
+        catalog.engines.size(), [&catalog](size_t i) { return catalog.engines[i].fuelType; },
+        [&catalog](size_t i) { return std::string(catalog.engines[i].fuelType) + " engines"; });
+}
+
+CatalogListing buildEquipmentListing(const CatalogView& catalog) {
+    return CatalogListing::build(
+        catalog.equipment.size(), [&catalog](size_t i) { return catalog.equipment[i].category; },
+        [&catalog](size_t i) { return categoryToString(catalog.equipment[i].category); });
+}
+
+// Hashed timer wheel: deadlines are rounded up to whole ticks and filed in slot tick % slot count.
+// A slot also holds entries of later revolutions, which stay there until their tick comes round.
+class TimerWheel {
+private:
+    struct Entry {
+        uint64_t id;
+        uint64_t tick;
+    };
+
+    struct Slot {
+        std::mutex mutex;
+        std::vector<Entry> entries;
+    };
+
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    std::chrono::milliseconds tickLength;
+    std::vector<Slot> slots;
+    std::atomic<uint64_t> nextTick{0}; // First tick not expired yet; moves only under that tick's slot lock
+    std::mutex advanceMutex;
+    std::mutex lateMutex;
+    std::vector<uint64_t> late; // Scheduled for a tick that had already been expired
+
+    uint64_t ticksUntil(std::chrono::steady_clock::time_point time, bool roundUp) const {
+        if (time <= origin) return 0;
+        auto elapsed = std::chrono::ceil<std::chrono::milliseconds>(time - origin).count();
+        return (elapsed + (roundUp ? tickLength.count() - 1 : 0)) / tickLength.count();
+    }
+
+public:
+    TimerWheel(std::chrono::milliseconds tickLength, size_t slotCount)
+        : tickLength(std::max(tickLength, std::chrono::milliseconds(1))), slots(std::max<size_t>(1, slotCount)) {}
+
+    std::chrono::milliseconds getTickLength() const { return tickLength; }
+
+    void schedule(uint64_t id, std::chrono::steady_clock::time_point deadline) {
+        uint64_t tick = ticksUntil(deadline, true);
+        {
+            Slot& slot = slots[tick % slots.size()];
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            if (tick >= nextTick.load(std::memory_order_relaxed)) {
+                slot.entries.push_back({id, tick});
+                return;
+            }
+        }
+        std::lock_guard<std::mutex> lock(lateMutex);
+        late.push_back(id);
+    }
+
+    // Calls expire(id) for every entry due by now, outside of the slot locks; returns how many
+    template <typename Expire>
+    size_t advance(std::chrono::steady_clock::time_point now, Expire expire) {
+        std::lock_guard<std::mutex> advancing(advanceMutex);
+        std::vector<uint64_t> due;
+        uint64_t last = ticksUntil(now, false);
+        for (uint64_t tick = nextTick.load(std::memory_order_relaxed); tick <= last; ++tick) {
+            Slot& slot = slots[tick % slots.size()];
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            auto split = std::partition(slot.entries.begin(), slot.entries.end(),
+                                        [tick](const Entry& entry) { return entry.tick > tick; });
+            for (auto it = split; it != slot.entries.end(); ++it) due.push_back(it->id);
+            slot.entries.erase(split, slot.entries.end());
+            nextTick.store(tick + 1, std::memory_order_relaxed);
+        }
+        {
+            std::lock_guard<std::mutex> lock(lateMutex);
+            due.insert(due.end(), late.begin(), late.end());
+            late.clear();
+        }
+        for (uint64_t id : due) expire(id);
+        return due.size();
+    }
+};
+
+// How long a configured vehicle or option stays reserved for its session
+constexpr std::chrono::minutes INVENTORY_HOLD_TIME{15};
+
+// Stock per SKU with tentative holds tied to a session. Stock counters change by compare-and-swap
+// only; holds live in a sharded table, and a timer wheel hands back the ones that are neither
+// committed nor released before they expire.
+class Inventory {
+public:
+    using ReservationId = uint64_t; // 0 is never issued
+
+    struct Stats {
+        uint64_t reserved = 0;
+        uint64_t rejected = 0;
+        uint64_t committed = 0;
+        uint64_t released = 0;
+        uint64_t expired = 0;
+    };
+
+private:
+    struct alignas(64) Sku {
+        std::atomic<int64_t> received{0}; // Initial stock plus deliveries
+        std::atomic<int64_t> available{0};
+        std::atomic<int64_t> held{0};
+        std::atomic<int64_t> sold{0};
+        std::atomic<uint64_t> rejected{0};
+    };
+
+    struct Reservation {
+        uint32_t sku;
+        uint32_t quantity;
+        uint64_t session;
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<ReservationId, Reservation> reservations;
+        Stats stats;
+    };
+
+    static constexpr size_t SHARD_COUNT = 64;
+
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint32_t> skuByName;
+    std::unique_ptr<Sku[]> skus;
+    std::array<Shard, SHARD_COUNT> shards;
+    std::atomic<ReservationId> nextId{1};
+    std::atomic<uint64_t> nextSession{1};
+    TimerWheel expiry;
+    std::jthread reaper;
+
+    Shard& shardOf(ReservationId id) { return shards[id % SHARD_COUNT]; }
+
+    // Removes a hold, if it still exists and belongs to session (any session when null)
+    std::optional<Reservation> take(ReservationId id, const uint64_t* session, uint64_t Stats::*outcome) {
+        Shard& shard = shardOf(id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.reservations.find(id);
+        if (it == shard.reservations.end() || (session && it->second.session != *session)) return std::nullopt;
+        Reservation reservation = it->second;
+        shard.reservations.erase(it);
+        ++(shard.stats.*outcome);
+        return reservation;
+    }
+
+    bool giveBack(ReservationId id, const uint64_t* session, uint64_t Stats::*outcome) {
+        auto reservation = take(id, session, outcome);
+        if (!reservation) return false;
+        Sku& sku = skus[reservation->sku];
+        sku.held.fetch_sub(reservation->quantity, std::memory_order_relaxed);
+        sku.available.fetch_add(reservation->quantity, std::memory_order_release);
+        return true;
+    }
+
+public:
+    explicit Inventory(const std::vector<std::pair<std::string, int64_t>>& stock,
+                       std::chrono::milliseconds tickLength = std::chrono::milliseconds(100), size_t wheelSlots = 1024)
+        : skus(std::make_unique<Sku[]>(stock.size())), expiry(tickLength, wheelSlots) {
+        for (const auto& [name, count] : stock) {
+            uint32_t index = static_cast<uint32_t>(names.size());
+            skus[index].received.store(count, std::memory_order_relaxed);
+            skus[index].available.store(count, std::memory_order_relaxed);
+            skuByName.emplace(name, index);
+            names.push_back(name);
+        }
+        reaper = std::jthread([this](std::stop_token stopToken) {
+            std::mutex mutex;
+            std::condition_variable_any wakeUp;
+            while (!stopToken.stop_requested()) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wakeUp.wait_for(lock, stopToken, expiry.getTickLength(), [] { return false; });
+                }
+                expireDue(std::chrono::steady_clock::now());
+            }
+        });
+    }
+
+    size_t getSkuCount() const { return names.size(); }
+    const std::string& getSkuName(uint32_t sku) const { return names[sku]; }
+
+    // Items without a SKU are not stocked and never run out
+    std::optional<uint32_t> findSku(const std::string& name) const {
+        auto it = skuByName.find(name);
+        if (it == skuByName.end()) return std::nullopt;
+        return it->second;
+    }
+
+    uint64_t openSession() { return nextSession.fetch_add(1, std::memory_order_relaxed); }
+
+    // Takes quantity items out of stock for session until holdTime passes; returns 0 when short
+    ReservationId reserve(uint32_t sku, uint32_t quantity, uint64_t session, std::chrono::milliseconds holdTime) {
+        Sku& item = skus[sku];
+        int64_t available = item.available.load(std::memory_order_relaxed);
+        do {
+            if (available < quantity) {
+                item.rejected.fetch_add(1, std::memory_order_relaxed);
+                return 0;
+            }
+        } while (!item.available.compare_exchange_weak(available, available - quantity, std::memory_order_acquire,
+                                                       std::memory_order_relaxed));
+        item.held.fetch_add(quantity, std::memory_order_relaxed);
+
+        ReservationId id = nextId.fetch_add(1, std::memory_order_relaxed);
+        {
+            Shard& shard = shardOf(id);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.reservations.emplace(id, Reservation{sku, quantity, session});
+            ++shard.stats.reserved;
+        }
+        expiry.schedule(id, std::chrono::steady_clock::now() + holdTime);
+        return id;
+    }
+
+    // Adds a delivery to stock
+    void restock(uint32_t sku, int64_t quantity) {
+        skus[sku].received.fetch_add(quantity, std::memory_order_relaxed);
+        skus[sku].available.fetch_add(quantity, std::memory_order_release);
+    }
+
+    // Turns a hold into a sale
+    bool commit(ReservationId id, uint64_t session) {
+        auto reservation = take(id, &session, &Stats::committed);
+        if (!reservation) return false;
+        Sku& sku = skus[reservation->sku];
+        sku.held.fetch_sub(reservation->quantity, std::memory_order_relaxed);
+        sku.sold.fetch_add(reservation->quantity, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Returns a hold to stock; false when it was already committed, released or expired
+    bool release(ReservationId id, uint64_t session) { return giveBack(id, &session, &Stats::released); }
+
+    bool isHeld(ReservationId id) {
+        Shard& shard = shardOf(id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.reservations.count(id) > 0;
+    }
+
+    // Returns every hold due by now to stock; the reaper thread calls this once per tick
+    size_t expireDue(std::chrono::steady_clock::time_point now) {
+        return expiry.advance(now, [this](ReservationId id) { giveBack(id, nullptr, &Stats::expired); });
+    }
+
+    int64_t getAvailable(uint32_t sku) const { return skus[sku].available.load(std::memory_order_relaxed); }
+    int64_t getHeld(uint32_t sku) const { return skus[sku].held.load(std::memory_order_relaxed); }
+    int64_t getSold(uint32_t sku) const { return skus[sku].sold.load(std::memory_order_relaxed); }
+    int64_t getReceived(uint32_t sku) const { return skus[sku].received.load(std::memory_order_relaxed); }
+
+    Stats getStats() {
+        Stats total;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total.reserved += shard.stats.reserved;
+            total.committed += shard.stats.committed;
+            total.released += shard.stats.released;
+            total.expired += shard.stats.expired;
+        }
+        for (size_t i = 0; i < names.size(); ++i) total.rejected += skus[i].rejected.load(std::memory_order_relaxed);
+        return total;
+    }
+};
+
+// Reads a stock file: one "name | count" line per SKU, where name is "Brand Model" for vehicles and
+// the equipment name for options; '#' starts a comment
+bool loadInventoryFile(const std::string& path, std::vector<std::pair<std::string, int64_t>>& stock, std::string& error) {
+    std::ifstream input(path);
+    if (!input.is_open()) {
+        error = "cannot open inventory file " + path;
+        return false;
+    }
+    std::string line;
+    for (size_t lineNumber = 1; std::getline(input, line); ++lineNumber) {
+        std::string_view text = trimView(line);
+        if (text.empty() || text.front() == '#') continue;
+        size_t separator = text.rfind('|');
+        int64_t count = 0;
+        if (separator == std::string_view::npos || !parseNumber(trimView(text.substr(separator + 1)), count) || count < 0) {
+            error = path + ":" + std::to_string(lineNumber) + ": expected \"name | count\"";
+            return false;
+        }
+        stock.emplace_back(std::string(trimView(text.substr(0, separator))), count);
+    }
+    return true;
+}
+
+// Configuration as a feature vector for similarity search: the equipment set as bits plus price,
+// power and CO2 scaled to 0..1 of the catalog maximum, and the body type as a small id
+struct ConfigurationFeatures {
+    std::vector<uint64_t> equipment; // One bit per catalog item, as many words as the encoder's catalog needs
+    float price = 0.0f;
+    float horsePower = 0.0f;
+    float co2 = 0.0f;
+    uint8_t bodyType = 0;
+};
+
+// Encodes vehicles and saved configurations against one catalog version
+class ConfigurationFeatureEncoder {
+private:
+    CatalogIndex index;
+    size_t equipmentCount;
+    std::vector<uint8_t> vehicleBodyTypes;
+    std::vector<std::string> bodyTypeNames;
+    double maxPrice = 1.0;
+    double maxHorsePower = 1.0;
+    double maxCo2 = 1.0;
+
+    // Electric vehicles have no body type of their own and form one group
+    static std::string bodyTypeOf(const VehicleRecord& record) {
+        return record.kind == VehicleKind::ELECTRIC ? "Electric" : std::string(record.bodyType);
+    }
+
+    static float scale(double value, double max) {
+        return static_cast<float>(std::clamp(value / max, 0.0, 1.0));
+    }
+
+    uint8_t bodyTypeFor(const std::string& brandAndModel) const {
+        auto vehicle = index.findVehicle(brandAndModel);
+        return vehicle ? vehicleBodyTypes[*vehicle] : 0;
+    }
+
+    void setEquipment(ConfigurationFeatures& features, std::string_view name) const {
+        auto item = index.findEquipment(name);
+        if (item && *item < equipmentCount) {
+            features.equipment[*item / 64] |= uint64_t{1} << (*item % 64);
+        }
+    }
+
+public:
+    explicit ConfigurationFeatureEncoder(const CatalogView& catalog)
+        : index(catalog), equipmentCount(catalog.equipment.size()) {
+        // Id 0 is kept for vehicles missing from the catalog
+        bodyTypeNames.push_back("Unknown");
+        double maxBase = 0.0;
+        for (const auto& vehicle : catalog.vehicles) {
+            std::string name = bodyTypeOf(vehicle);
+            auto known = std::find(bodyTypeNames.begin(), bodyTypeNames.end(), name);
+            if (known == bodyTypeNames.end() && bodyTypeNames.size() < 256) {
+                known = bodyTypeNames.insert(known, name);
+            }
+            vehicleBodyTypes.push_back(known == bodyTypeNames.end() ? 0 : static_cast<uint8_t>(known - bodyTypeNames.begin()));
+            maxBase = std::max(maxBase, vehicle.basePrice);
+        }
+
+        double maxEngine = 0.0;
+        for (const auto& engine : catalog.engines) {
+            maxEngine = std::max(maxEngine, engine.price);
+            maxHorsePower = std::max(maxHorsePower, static_cast<double>(engine.horsePower));
+            maxCo2 = std::max(maxCo2, static_cast<double>(engine.co2Emissions));
+        }
+        double allEquipment = 0.0;
+        for (const auto& item : catalog.equipment) allEquipment += item.price;
+        maxPrice = std::max(1.0, maxBase + maxEngine + allEquipment);
+    }
+
+    size_t getWordCount() const { return std::max<size_t>(1, (equipmentCount + 63) / 64); }
+
+    ConfigurationFeatures encode(const Vehicle& vehicle) const {
+        ConfigurationFeatures features;
+        features.equipment.assign(getWordCount(), 0);
+        for (const auto& item : vehicle.getSelectedEquipment()) setEquipment(features, item.getName());
+        features.price = scale(vehicle.calculateTotalPrice(), maxPrice);
+        if (const auto& engine = vehicle.getEngine()) {
+            features.horsePower = scale(engine->getHorsePower(), maxHorsePower);
+            features.co2 = scale(engine->getCO2Emissions(), maxCo2);
+        }
+        features.bodyType = bodyTypeFor(vehicle.getBrand() + " " + vehicle.getModel());
+        return features;
+    }
+
+    ConfigurationFeatures encode(const SavedConfiguration& config) const {
+        ConfigurationFeatures features;
+        features.equipment.assign(getWordCount(), 0);
+        for (const auto& item : config.equipment) setEquipment(features, item.name);
+        features.price = scale(config.totalPrice, maxPrice);
+        if (config.hasEngine) {
+            features.horsePower = scale(config.horsePower, maxHorsePower);
+            features.co2 = scale(config.co2Emissions, maxCo2);
+        }
+        features.bodyType = bodyTypeFor(config.brand + " " + config.model);
+        return features;
+    }
+};
+
+// Share of each feature in the distance; they add up to 1, so distances are in 0..1
+struct SimilarityWeights {
+    float equipment = 0.5f; // Jaccard distance of the equipment sets
+    float price = 0.2f;
+    float horsePower = 0.1f;
+    float co2 = 0.1f;
+    float bodyType = 0.1f; // Applied in full when body types differ
+};
+
+struct SimilarConfiguration {
+    size_t id = 0;
+    float distance = 0.0f;
+    float jaccard = 0.0f; // Equipment overlap, 1 for identical sets
+};
+
+// Bit count without a popcnt instruction: only shifts, masks and adds, so the compiler can run
+// it over several words per SIMD register on any x86-64 or ARM target
+inline uint64_t popcountSwar(uint64_t x) {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x += x >> 8;
+    x += x >> 16;
+    x += x >> 32;
+    return x & 0x7F;
+}
+
+// k-nearest-neighbor index over configuration features. Columns are stored separately (one array
+// per equipment word, price, power, CO2, body type), so the distance kernel walks every column
+// with unit stride in fixed-size blocks and each loop vectorizes on its own.
+class SimilarityIndex {
+private:
+    static constexpr size_t BLOCK_SIZE = 1024;
+    static constexpr size_t MIN_TASK_SIZE = 65536;
+
+    size_t wordCount;
+    SimilarityWeights weights;
+    std::vector<std::vector<uint64_t>> equipmentWords; // wordCount columns
+    std::vector<uint32_t> bitCounts;
+    std::vector<float> prices;
+    std::vector<float> horsePowers;
+    std::vector<float> co2s;
+    std::vector<float> bodyTypes; // Ids as floats, so the kernel compares them alongside the other columns
+    size_t entryCount = 0;
+
+    using Candidate = std::pair<float, uint32_t>; // Distance, id; max-heap keeps the worst on top
+
+    // Word w of an entry or query; features from a smaller catalog have no bits past their own words
+    static uint64_t featureWord(const ConfigurationFeatures& features, size_t w) {
+        return w < features.equipment.size() ? features.equipment[w] : 0;
+    }
+
+    // Distances of one full block of entries to the query. Columns are padded to whole blocks, so
+    // every loop has a fixed trip count and vectorizes. Words is the equipment word count for the
+    // common small catalogs, or 0 to take it from the index.
+    template <size_t Words>
+    void scoreBlock(const ConfigurationFeatures& query, uint32_t queryBits, size_t begin, float* out) const {
+        alignas(64) uint32_t shared[BLOCK_SIZE] = {};
+        const size_t words = Words ? Words : wordCount;
+        for (size_t w = 0; w < words; ++w) {
+            const uint64_t* column = equipmentWords[w].data() + begin;
+            uint64_t bits = featureWord(query, w);
+            for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+                shared[i] += static_cast<uint32_t>(popcountSwar(column[i] & bits));
+            }
+        }
+
+        const uint32_t* counts = bitCounts.data() + begin;
+        const float* price = prices.data() + begin;
+        const float* power = horsePowers.data() + begin;
+        const float* co2 = co2s.data() + begin;
+        const float* body = bodyTypes.data() + begin;
+        const float queryPrice = query.price;
+        const float queryPower = query.horsePower;
+        const float queryCo2 = query.co2;
+        const float queryBody = query.bodyType;
+        const SimilarityWeights w = weights;
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            // Integer counts keep this free of branches; two empty sets count as identical (1 / 1)
+            uint32_t unionBits = counts[i] + queryBits - shared[i];
+            int32_t bothEmpty = unionBits == 0;
+            float jaccard = static_cast<float>(static_cast<int32_t>(shared[i]) + bothEmpty) /
+                            static_cast<float>(static_cast<int32_t>(unionBits) + bothEmpty);
+            out[i] = w.equipment * (1.0f - jaccard) +
+                     w.price * std::fabs(price[i] - queryPrice) +
+                     w.horsePower * std::fabs(power[i] - queryPower) +
+                     w.co2 * std::fabs(co2[i] - queryCo2) +
+                     (body[i] == queryBody ? 0.0f : w.bodyType);
+        }
+    }
+
+    template <size_t Words>
+    void scanRange(const ConfigurationFeatures& query, size_t begin, size_t end, size_t k,
+                   std::vector<Candidate>& heap) const {
+        uint32_t queryBits = 0;
+        for (size_t w = 0; w < wordCount; ++w) queryBits += static_cast<uint32_t>(popcountSwar(featureWord(query, w)));
+
+        alignas(64) float distances[BLOCK_SIZE];
+        for (size_t block = begin; block < end; block += BLOCK_SIZE) {
+            size_t count = std::min(BLOCK_SIZE, end - block);
+            scoreBlock<Words>(query, queryBits, block, distances);
+
+            // Once the heap is full most blocks hold nothing better than the current k-th best;
+            // a vectorized count finds those and skips the per-entry selection
+            if (heap.size() == k) {
+                const float worst = heap.front().first;
+                uint32_t better = 0;
+                for (size_t i = 0; i < BLOCK_SIZE; ++i) better += distances[i] <= worst;
+                if (better == 0) continue;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                Candidate candidate{distances[i], static_cast<uint32_t>(block + i)};
+                if (heap.size() < k) {
+                    heap.push_back(candidate);
+                    std::push_heap(heap.begin(), heap.end());
+                } else if (candidate < heap.front()) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = candidate;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+        }
+    }
+
+    void scan(const ConfigurationFeatures& query, size_t begin, size_t end, size_t k, std::vector<Candidate>& heap) const {
+        switch (wordCount) {
+            case 1: scanRange<1>(query, begin, end, k, heap); break;
+            case 2: scanRange<2>(query, begin, end, k, heap); break;
+            case 3: scanRange<3>(query, begin, end, k, heap); break;
+            case 4: scanRange<4>(query, begin, end, k, heap); break;
+            default: scanRange<0>(query, begin, end, k, heap); break;
+        }
+    }
+
+public:
+    explicit SimilarityIndex(size_t wordCount, SimilarityWeights weights = {})
+        : wordCount(std::max<size_t>(wordCount, 1)), weights(weights), equipmentWords(this->wordCount) {}
+
+    size_t size() const { return entryCount; }
+
+    void reserve(size_t count) {
+        count = (count + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        for (size_t w = 0; w < wordCount; ++w) equipmentWords[w].reserve(count);
+        bitCounts.reserve(count);
+        prices.reserve(count);
+        horsePowers.reserve(count);
+        co2s.reserve(count);
+        bodyTypes.reserve(count);
+    }
+
+    // Returns the id of the new entry; ids are assigned in insertion order
+    size_t add(const ConfigurationFeatures& features) {
+        if (entryCount % BLOCK_SIZE == 0) {
+            size_t padded = entryCount + BLOCK_SIZE;
+            for (size_t w = 0; w < wordCount; ++w) equipmentWords[w].resize(padded);
+            bitCounts.resize(padded);
+            prices.resize(padded);
+            horsePowers.resize(padded);
+            co2s.resize(padded);
+            bodyTypes.resize(padded);
+        }
+
+        size_t id = entryCount++;
+        uint32_t bits = 0;
+        for (size_t w = 0; w < wordCount; ++w) {
+            equipmentWords[w][id] = featureWord(features, w);
+            bits += static_cast<uint32_t>(popcountSwar(featureWord(features, w)));
+        }
+        bitCounts[id] = bits;
+        prices[id] = features.price;
+        horsePowers[id] = features.horsePower;
+        co2s[id] = features.co2;
+        bodyTypes[id] = features.bodyType;
+        return id;
+    }
+
+    // The k entries closest to the query, nearest first; ties go to the lower id. Large indexes are
+    // split into ranges scanned on the pool, each keeping its own top k.
+    std::vector<SimilarConfiguration> nearest(const ConfigurationFeatures& query, size_t k, ThreadPool* pool = nullptr) const {
+        k = std::min(k, size());
+        if (k == 0) return {};
+
+        size_t taskCount = 1;
+        if (pool && pool->size() > 1) {
+            taskCount = std::clamp<size_t>(size() / MIN_TASK_SIZE, 1, pool->size() * 4);
+        }
+        size_t rangeSize = (size() + taskCount - 1) / taskCount;
+        rangeSize = (rangeSize + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+
+        std::vector<std::vector<Candidate>> heaps(taskCount);
+        if (taskCount == 1) {
+            scan(query, 0, size(), k, heaps[0]);
+        } else {
+            for (size_t task = 0; task < taskCount; ++task) {
+                size_t begin = std::min(size(), task * rangeSize);
+                size_t end = std::min(size(), begin + rangeSize);
+                pool->submit([this, &query, &heaps, task, begin, end, k] { scan(query, begin, end, k, heaps[task]); });
+            }
+            pool->wait();
+        }
+
+        std::vector<Candidate> merged;
+        for (const auto& heap : heaps) merged.insert(merged.end(), heap.begin(), heap.end());
+        std::partial_sort(merged.begin(), merged.begin() + k, merged.end());
+
+        std::vector<SimilarConfiguration> results;
+        for (size_t i = 0; i < k; ++i) {
+            SimilarConfiguration result;
+            result.id = merged[i].second;
+            result.distance = merged[i].first;
+            result.jaccard = jaccard(query, result.id);
+            results.push_back(result);
+        }
+        return results;
+    }
+
+    float jaccard(const ConfigurationFeatures& query, size_t id) const {
+        uint64_t shared = 0;
+        uint64_t either = 0;
+        for (size_t w = 0; w < wordCount; ++w) {
+            shared += popcountSwar(equipmentWords[w][id] & featureWord(query, w));
+            either += popcountSwar(equipmentWords[w][id] | featureWord(query, w));
+        }
+        return either == 0 ? 1.0f : static_cast<float>(shared) / static_cast<float>(either);
+    }
+};
+
+// One line of a memory footprint: what holds the memory, how many items, and where the bytes live
+struct FootprintEntry {
+    std::string_view group; // catalog, session or allocations
+    std::string_view part;
+    size_t count = 0;
+    size_t bytes = 0;
+    std::string_view storage; // read-only, mapped, shared, heap or arena
+};
+
+// Bytes held by a catalog: record tables and text where they live, plus the static ASCII art every
+// catalog shares. A mapped catalog's text is part of its image and is counted with it.
+std::vector<FootprintEntry> catalogFootprint(const CatalogSnapshot& snapshot) {
+    const CatalogView& catalog = snapshot.getView();
+    std::string_view tables = snapshot.getTableStorage();
+
+    size_t strings = 0;
+    size_t textBytes = 0;
+    auto text = [&](std::string_view value) {
+        ++strings;
+        textBytes += value.size();
+    };
+    for (const auto& vehicle : catalog.vehicles) {
+        text(vehicle.brand);
+        text(vehicle.model);
+        text(vehicle.year);
+        text(vehicle.bodyType);
+    }
+    for (const auto& engine : catalog.engines) {
+        text(engine.name);
+        text(engine.fuelType);
+    }
+    for (const auto& item : catalog.equipment) {
+        text(item.name);
+        text(item.description);
+    }
+    for (std::string_view color : catalog.colors) text(color);
+
+    using Art = std::span<const std::string_view>;
+    size_t artLines = 0;
+    size_t artBytes = 0;
+    for (Art art : {Art(sedanArt), Art(hatchbackArt), Art(suvArt), Art(coupeArt), Art(sportBikeArt), Art(cruiserArt),
+                    Art(motorcycleArt), Art(electricVehicleArt)}) {
+        artLines += art.size();
+        artBytes += art.size_bytes();
+        for (std::string_view line : art) artBytes += line.size();
+    }
+
+    std::vector<FootprintEntry> entries = {
+        {"catalog", "vehicle records", catalog.vehicles.size(), catalog.vehicles.size_bytes(), tables},
+        {"catalog", "engine records", catalog.engines.size(), catalog.engines.size_bytes(), tables},
+        {"catalog", "equipment records", catalog.equipment.size(), catalog.equipment.size_bytes(), tables},
+        {"catalog", "color names", catalog.colors.size(), catalog.colors.size_bytes(), tables},
+    };
+    if (snapshot.getImageBytes() > 0) {
+        entries.push_back({"catalog", "catalog image", strings, snapshot.getImageBytes(), snapshot.getTextStorage()});
+    } else {
+        entries.push_back({"catalog", "strings", strings, textBytes, snapshot.getTextStorage()});
+    }
+    entries.push_back({"catalog", "ASCII art", artLines, artBytes, "read-only"});
+    return entries;
+}
+
+// Heap allocations since start, and heap still in use, by subsystem over every session and worker thread
+std::vector<FootprintEntry> allocationFootprint() {
+    std::vector<FootprintEntry> entries;
+    for (size_t i = 0; i < MEMORY_SUBSYSTEMS; ++i) {
+        AllocationTotals totals = allocationTotals(static_cast<MemorySubsystem>(i));
+        entries.push_back({"allocations", memorySubsystemNames[i], totals.allocations, totals.bytes, "heap"});
+        entries.push_back({"heap in use", memorySubsystemNames[i], totals.liveBlocks, totals.liveBytes, "heap"});
+    }
+    return entries;
+}
+
+// Heap a configured vehicle holds: the object with its shared_ptr control block, strings and
+// equipment, and its engine. Measured by copying it into a counting resource.
+FootprintEntry configurationFootprint(std::string_view part, const Vehicle& vehicle) {
+    CountingResource counter;
+    {
+        auto copy = vehicle.clone(&counter);
+        if (vehicle.getEngine()) {
+            copy->setEngine(std::allocate_shared<Engine>(Engine::allocator_type(&counter), *vehicle.getEngine()));
+        }
+    }
+    return {"session", part, vehicle.getSelectedEquipment().size(), counter.getBytesAllocated(), "arena"};
+}
+
+// Table per group; totals leave out arena lines, whose bytes are already in the arena chunks
+void printFootprint(std::span<const FootprintEntry> entries) {
+    static constexpr std::pair<std::string_view, std::string_view> groups[] = {
+        {"catalog", "Catalog (shared by every session on this catalog version)"},
+        {"session", "This session"},
+        {"allocations", "Heap allocations since start, by subsystem"},
+        {"heap in use", "Heap in use now, by subsystem"},
+    };
+    for (const auto& [group, title] : groups) {
+        console() << COLOR_BOLD << "\n" << title << COLOR_RESET << std::endl;
+        console() << std::left << std::setw(28) << "Part" << std::right << std::setw(12) << "Count" << std::setw(14)
+                  << "Bytes" << "  Storage" << std::endl;
+        console() << std::string(66, '-') << std::endl;
+        size_t total = 0;
+        for (const auto& entry : entries) {
+            if (entry.group != group) continue;
+            console() << std::left << std::setw(28) << entry.part << std::right << std::setw(12) << entry.count
+                      << std::setw(14) << entry.bytes << "  " << entry.storage << std::endl;
+            if (entry.storage != "arena") total += entry.bytes;
+        }
+        console() << COLOR_GREEN << std::left << std::setw(28) << "Total" << std::right << std::setw(26) << total
+                  << COLOR_RESET << std::endl;
+    }
+}
+
+// Machine-readable footprint, one entry per line, for tracking footprint regressions
+std::string formatFootprintJson(std::span<const FootprintEntry> entries, uint64_t catalogVersion) {
+    std::string out = "{\"catalog_version\":" + std::to_string(catalogVersion) + ",\"entries\":[";
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const FootprintEntry& entry = entries[i];
+        out += i ? ",\n  {\"group\":" : "\n  {\"group\":";
+        appendJsonString(out, entry.group);
+        out += ",\"part\":";
+        appendJsonString(out, entry.part);
+        out += ",\"count\":" + std::to_string(entry.count) + ",\"bytes\":" + std::to_string(entry.bytes) +
+               ",\"storage\":";
+        appendJsonString(out, entry.storage);
+        out += '}';
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+// Class for configuring vehicles
+class VehicleConfigurator {
+private:
+    // Per-session pool: every vehicle and engine configured in this session lives here. Replaced vehicles,
+    // engines and loads go back to the pool, so a long session holds only what it still uses.
+    // The chunks it reserves are counted below it, the objects placed in it above it.
+    CountingResource sessionChunks;
+    std::pmr::unsynchronized_pool_resource sessionArena{&sessionChunks};
+    CountingResource sessionObjects{&sessionArena};
+
+    // Directory holding this session's configs/ and reports/; empty for the current directory
+    std::filesystem::path workDirectory;
+
+    // Catalog snapshot this session works against, and where newer versions are published
+    const CatalogStore* catalogStore;
+    std::shared_ptr<const CatalogSnapshot> catalogSnapshot;
+    CatalogView catalog;
+
+    // Pricing rules compiled for the bound catalog version
+    std::shared_ptr<const PricingPlan> pricingPlan;
+
+    // Heap retained by the indexes this session built, measured while building them
+    size_t pricingPlanBytes = 0;
+    mutable size_t searchIndexBytes = 0;
+    mutable size_t listingBytes = 0;
+
+    // Price change of every single edit to the current vehicle, and the revision and catalog it reflects
+    mutable WhatIfPricing whatIf;
+    mutable const Vehicle* whatIfVehicle = nullptr;
+    mutable uint64_t whatIfRevision = 0;
+    mutable uint64_t whatIfCatalogVersion = 0;
+
+    // Quotes of configurations seen in this session, and the saved configurations by hash
+    mutable QuoteCache quoteCache{256};
+    mutable std::optional<SavedConfigurationIndex> savedConfigurations;
+
+    // Trip profiles for EV range estimates, and the results per configuration
+    static constexpr size_t EV_TRIP_PROFILES = 5000;
+    mutable std::vector<TripProfile> tripProfiles;
+    mutable EvSimulationCache evSimulations{64};
+
+    // Search over the bound catalog, built on first use
+    mutable std::optional<SearchIndex> searchIndex;
+
+    // Listings of the bound catalog in display order, built on first use
+    mutable std::optional<CatalogListing> vehicleListing;
+    mutable std::optional<CatalogListing> engineListing;
+    mutable std::optional<CatalogListing> equipmentListing;
+
+    std::shared_ptr<Vehicle> currentVehicle;
+    std::shared_ptr<Vehicle> comparisonVehicle; // For comparing configurations
+
+    // Stock holds of this session by item name, when the configurator sells from an inventory
+    Inventory* inventory = nullptr;
+    uint64_t inventorySession = 0;
+    std::unordered_map<std::string, Inventory::ReservationId> heldItems;
+
+    // Unsaved work is written here in the background; the vehicle and revision last handed over
+    std::optional<Autosaver> autosaver;
+    std::shared_ptr<const Vehicle> autosavedVehicle;
+    uint64_t autosavedRevision = 0;
+
+    // Saves, loads and reports run here; declared last so queued writes finish before anything else goes away
+    mutable BackgroundIoWorker ioWorker;
+
+public:
+    explicit VehicleConfigurator(const CatalogStore* store = nullptr, std::filesystem::path workDirectory = {})
+        : workDirectory(std::move(workDirectory)), catalogStore(store) {
+        initializeData();
+    }
+
+    std::filesystem::path getConfigDirectory() const { return workDirectory / "configs"; }
+
+    // Saved configuration path for a name typed by the user: inside the config directory, .txt added
+    std::string configurationPath(const std::string& filename) const {
+        std::string name = filename;
+        if (name.starts_with("configs/")) name.erase(0, std::string_view("configs/").size());
+        std::string fullPath = (getConfigDirectory() / name).string();
+        if (fullPath.find(".txt") == std::string::npos) {
+            fullPath += ".txt";
+        }
+        return fullPath;
+    }
+
+    ~VehicleConfigurator() {
+        for (const auto& [name, reservation] : heldItems) inventory->release(reservation, inventorySession);
+    }
+
+    // Data initialization - binds the current catalog snapshot; nothing is allocated or copied
+    void initializeData() {
+        catalogSnapshot = catalogStore ? catalogStore->snapshot() : CatalogSnapshot::builtIn();
+        catalog = catalogSnapshot->getView();
+        if (!pricingPlan || pricingPlan->getCatalogVersion() != catalogSnapshot->getVersion()) {
+            AllocationScope scope(MemorySubsystem::PRICING);
+            auto plan = std::make_shared<const PricingPlan>(catalog, catalogSnapshot->getVersion(), builtInPricingRules);
+            pricingPlanBytes = scope.retainedBytes();
+            pricingPlan = std::move(plan);
+        }
+        if (currentVehicle) currentVehicle->setPricingPlan(pricingPlan);
+        searchIndex.reset();
+        vehicleListing.reset();
+        engineListing.reset();
+        equipmentListing.reset();
+        searchIndexBytes = 0;
+        listingBytes = 0;
+    }
+
+    // Switches to the latest published catalog; the vehicles being configured keep their own copies
+    bool refreshCatalog() {
+        if (!catalogStore || catalogStore->snapshot() == catalogSnapshot) {
+            return false;
+        }
+        initializeData();
+        return true;
+    }
+
+    uint64_t getCatalogVersion() const { return catalogSnapshot->getVersion(); }
+
+    QuoteBreakdown quote(const Vehicle& vehicle) const {
+        AllocationScope scope(MemorySubsystem::PRICING);
+        return quoteCache.getOrCompute(configurationKey(vehicle), getCatalogVersion(),
+                                       [&vehicle] { return computeQuote(vehicle); });
+    }
+
+    QuoteCache::Stats getQuoteCacheStats() const { return quoteCache.getStats(); }
+
+    // Whether the bound catalog lists the vehicle, its engine or any of its equipment at another price
+    bool hasCatalogPriceChanges(const Vehicle& vehicle) const {
+        for (const auto& record : catalog.vehicles) {
+            if (record.brand == vehicle.getBrand() && record.model == vehicle.getModel() &&
+                record.basePrice != vehicle.getBasePrice()) {
+                return true;
+            }
+        }
+        if (const auto& engine = vehicle.getEngine()) {
+            for (const auto& record : catalog.engines) {
+                if (record.name == engine->getName() && record.price != engine->getPrice()) return true;
+            }
+        }
+        for (const auto& equipment : vehicle.getSelectedEquipment()) {
+            for (const auto& record : catalog.equipment) {
+                if (record.name == equipment.getName() && record.price != equipment.getPrice()) return true;
+            }
+        }
+        return false;
+    }
+
+    // Builds every index a session builds on first use, so a footprint shows what a busy session holds
+    void buildIndexes() const {
+        ensureSearchIndex();
+        ensureListing(vehicleListing, buildVehicleListing);
+        ensureListing(engineListing, buildEngineListing);
+        ensureListing(equipmentListing, buildEquipmentListing);
+    }
+
+    // Memory held by the bound catalog and by this session, followed by heap allocations by subsystem
+    std::vector<FootprintEntry> memoryFootprint() const {
+        std::vector<FootprintEntry> entries = catalogFootprint(*catalogSnapshot);
+        if (currentVehicle) entries.push_back(configurationFootprint("current configuration", *currentVehicle));
+        if (comparisonVehicle) entries.push_back(configurationFootprint("comparison configuration", *comparisonVehicle));
+        entries.push_back({"session", "arena objects", sessionObjects.getAllocationCount(),
+                           sessionObjects.getBytesAllocated(), "arena"});
+        entries.push_back({"session", "arena chunks", sessionChunks.getAllocationCount(),
+                           sessionChunks.getBytesAllocated(), "heap"});
+        entries.push_back({"session", "pricing plan", pricingPlan->getItemCount(), pricingPlanBytes, "heap"});
+        entries.push_back({"session", "what-if prices", whatIf.getItemCount(), whatIf.getMemoryBytes(), "heap"});
+        entries.push_back({"session", "quote cache", quoteCache.getStats().entries, quoteCache.getMemoryBytes(), "heap"});
+        entries.push_back({"session", "EV simulation cache", evSimulations.getStats().entries,
+                           evSimulations.getMemoryBytes(), "heap"});
+        entries.push_back({"session", "trip profiles", tripProfiles.size(), tripProfiles.capacity() * sizeof(TripProfile),
+                           "heap"});
+        entries.push_back({"session", "search index", searchIndex ? searchIndex->size() : 0, searchIndexBytes, "heap"});
+        size_t listed = 0;
+        for (const auto* listing : {&vehicleListing, &engineListing, &equipmentListing}) {
+            if (*listing) listed += (*listing)->size();
+        }
+        entries.push_back({"session", "listings", listed, listingBytes, "heap"});
+
+        std::vector<FootprintEntry> allocations = allocationFootprint();
+        entries.insert(entries.end(), allocations.begin(), allocations.end());
+        return entries;
+    }
+
+    void displayMemoryFootprint() const {
+        printHeader("Memory Footprint");
+        printFootprint(memoryFootprint());
+    }
+
+    // Writes the footprint as JSON to a file, or to the console for "-"
+    bool writeMemoryFootprint(const std::string& path) const {
+        std::string json = formatFootprintJson(memoryFootprint(), getCatalogVersion());
+        if (path == "-") {
+            console() << json;
+            return true;
+        }
+        std::string error;
+        if (!writeFileAtomically(path, json, error)) {
+            console() << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+            return false;
+        }
+        console() << COLOR_GREEN << "✓ Memory footprint written to " << path << COLOR_RESET << std::endl;
+        return true;
+    }
+
+    // Sells from inventory: vehicles and options are held for this session while configured
+    void attachInventory(Inventory* store) {
+        inventory = store;
+        inventorySession = store->openSession();
+    }
+
+    bool hasInventory() const { return inventory != nullptr; }
+
+    // Takes out a new hold for every item whose hold has lapsed; items gone out of stock meanwhile
+    // are pointed out and no longer counted as held. Returns false if any item could not be held again.
+    bool renewHolds() {
+        bool allHeld = true;
+        for (auto it = heldItems.begin(); it != heldItems.end();) {
+            if (inventory->isHeld(it->second)) {
+                ++it;
+                continue;
+            }
+            auto sku = inventory->findSku(it->first);
+            Inventory::ReservationId reservation =
+                sku ? inventory->reserve(*sku, 1, inventorySession, INVENTORY_HOLD_TIME) : 0;
+            if (reservation != 0) {
+                it->second = reservation;
+                ++it;
+            } else {
+                console() << COLOR_YELLOW << "! The hold on " << it->first << " lapsed and it is now out of stock."
+                          << COLOR_RESET << std::endl;
+                allHeld = false;
+                it = heldItems.erase(it);
+            }
+        }
+        return allHeld;
+    }
+
+    // Checkout: sells the configured vehicle and options from stock. Saving only keeps the holds
+    // alive, so a saved configuration can still be changed or dropped without selling anything.
+    bool placeOrder() {
+        if (!currentVehicle) {
+            console() << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+            return false;
+        }
+        if (!inventory) {
+            console() << COLOR_YELLOW << "! No inventory attached; start with --inventory to sell from stock."
+                      << COLOR_RESET << std::endl;
+            return false;
+        }
+        // Every item must be held at checkout, not just the ones whose holds are still running
+        std::vector<std::string> unavailable;
+        std::string vehicleName = currentVehicle->getBrand() + " " + currentVehicle->getModel();
+        if (!reserveItem(vehicleName)) unavailable.push_back(vehicleName);
+        for (const auto& item : currentVehicle->getSelectedEquipment()) {
+            std::string name = item.getName();
+            if (!reserveItem(name)) unavailable.push_back(name);
+        }
+        if (!unavailable.empty()) {
+            for (const auto& name : unavailable) {
+                console() << COLOR_RED << "✗ " << name << " is out of stock." << COLOR_RESET << std::endl;
+            }
+            console() << COLOR_RED << "✗ Order not placed." << COLOR_RESET << std::endl;
+            return false;
+        }
+
+        size_t sold = 0;
+        for (const auto& [name, reservation] : heldItems) {
+            if (inventory->commit(reservation, inventorySession)) {
+                ++sold;
+            } else {
+                console() << COLOR_YELLOW << "! The hold on " << name << " lapsed before it could be sold."
+                          << COLOR_RESET << std::endl;
+            }
+        }
+        heldItems.clear();
+        console() << COLOR_GREEN << "✓ Order placed: " << sold << " items sold from stock." << COLOR_RESET
+                  << std::endl;
+        return true;
+    }
+
+private:
+    // Holds one unit of an item for this session; untracked items are always available
+    bool reserveItem(const std::string& name) {
+        if (!inventory) return true;
+        auto sku = inventory->findSku(name);
+        if (!sku) return true;
+        auto held = heldItems.find(name);
+        if (held != heldItems.end() && inventory->isHeld(held->second)) return true;
+
+        Inventory::ReservationId reservation = inventory->reserve(*sku, 1, inventorySession, INVENTORY_HOLD_TIME);
+        if (reservation == 0) return false;
+        heldItems[name] = reservation;
+        return true;
+    }
+
+    // Returns the holds of items no longer in the configuration
+    void releaseUnusedItems() {
+        for (auto it = heldItems.begin(); it != heldItems.end();) {
+            bool used = currentVehicle && (currentVehicle->getBrand() + " " + currentVehicle->getModel() == it->first ||
+                                           std::any_of(currentVehicle->getSelectedEquipment().begin(),
+                                                       currentVehicle->getSelectedEquipment().end(),
+                                                       [&it](const Equipment& e) { return e.hasName(it->first); }));
+            if (used) {
+                ++it;
+            } else {
+                inventory->release(it->second, inventorySession);
+                it = heldItems.erase(it);
+            }
+        }
+    }
+
+    // What-if prices for the listings, brought up to date with the edits since the last listing
+    const WhatIfPricing* currentWhatIf() const {
+        if (!currentVehicle) return nullptr;
+        if (whatIfVehicle != currentVehicle.get() || whatIfRevision != currentVehicle->getRevision() ||
+            whatIfCatalogVersion != pricingPlan->getCatalogVersion()) {
+            AllocationScope scope(MemorySubsystem::PRICING);
+            const auto& engine = currentVehicle->getEngine();
+            whatIf.update(*pricingPlan, pricingPlan->describe(*currentVehicle), engine ? engine->getPrice() : 0.0);
+            whatIfVehicle = currentVehicle.get();
+            whatIfRevision = currentVehicle->getRevision();
+            whatIfCatalogVersion = pricingPlan->getCatalogVersion();
+        }
+        return &whatIf;
+    }
+
+    // Builds a listing on first use
+    template <typename Build>
+    void ensureListing(std::optional<CatalogListing>& listing, Build build) const {
+        if (listing) return;
+        AllocationScope scope(MemorySubsystem::LISTINGS);
+        listing = build(catalog);
+        listingBytes += scope.retainedBytes();
+    }
+
+    void ensureSearchIndex() const {
+        if (searchIndex) return;
+        AllocationScope scope(MemorySubsystem::SEARCH);
+        searchIndex = buildCatalogSearchIndex(catalog);
+        searchIndexBytes = scope.retainedBytes();
+    }
+
+    static void printWhatIfNote() {
+        console() << COLOR_BOLD << "Total change per unit, after packages and discounts, incl. VAT" << COLOR_RESET
+                  << std::endl;
+    }
+
+    static void printPriceDelta(double delta) {
+        console() << (delta < 0 ? COLOR_GREEN : COLOR_YELLOW) << " → " << (delta < 0 ? "-" : "+")
+                  << formatPrice(std::abs(delta)) << COLOR_RESET;
+    }
+
+    // Stock note for a listing line
+    void printStock(const std::string& name) const {
+        if (!inventory) return;
+        auto sku = inventory->findSku(name);
+        if (!sku) return;
+        int64_t available = inventory->getAvailable(*sku);
+        auto held = heldItems.find(name);
+        if (held != heldItems.end() && inventory->isHeld(held->second)) {
+            console() << COLOR_GREEN << " - reserved" << COLOR_RESET;
+        } else if (available <= 0) {
+            console() << COLOR_RED << " - out of stock" << COLOR_RESET;
+        } else {
+            console() << " - " << available << " in stock";
+        }
+    }
+
+public:
+
+    // Displaying available vehicles with improved formatting, one page at a time
+    void displayAvailableVehicles(size_t& page, size_t pageSize = LISTING_PAGE_SIZE) const {
+        printHeader("Available Vehicles");
+
+        ensureListing(vehicleListing, buildVehicleListing);
+        vehicleListing->printPage(page, pageSize, [this](size_t i) {
+            const VehicleRecord& vehicle = catalog.vehicles[i];
+            console() << COLOR_CYAN << " [" << i + 1 << "] " << COLOR_RESET;
+            console() << vehicle.brand << " " << vehicle.model << " (" << vehicle.year << ") - ";
+            console() << formatPrice(vehicle.basePrice);
+            printStock(std::string(vehicle.brand) + " " + std::string(vehicle.model));
+            console() << std::endl;
+        });
+    }
+
+    // Vehicle selection with improved feedback
+    bool selectVehicle(size_t index) {
+        if (index >= 1 && index <= catalog.vehicles.size()) {
+            const VehicleRecord& record = catalog.vehicles[index - 1];
+            if (!reserveItem(std::string(record.brand) + " " + std::string(record.model))) {
+                console() << COLOR_RED << "✗ " << record.brand << " " << record.model << " is out of stock." << COLOR_RESET
+                          << std::endl;
+                return false;
+            }
+            currentVehicle = makeVehicle(record, &sessionObjects);
+            currentVehicle->setPricingPlan(pricingPlan);
+            releaseUnusedItems();
+            printStepDone("Selecting vehicle");
+            console() << COLOR_GREEN << "✓ You've selected: " << currentVehicle->getBrand() << " "
+                      << currentVehicle->getModel() << COLOR_RESET << std::endl;
+            return true;
+        }
+        console() << COLOR_RED << "✗ Invalid selection. Please try again." << COLOR_RESET << std::endl;
+        return false;
+    }
+
+    // Displaying available engines with improved formatting, one page at a time
+    void displayAvailableEngines(size_t& page, size_t pageSize = LISTING_PAGE_SIZE) const {
+        printHeader("Available Engines");
+
+        ensureListing(engineListing, buildEngineListing);
+        const WhatIfPricing* prices = currentWhatIf();
+        const Engine* selected = prices ? currentVehicle->getEngine().get() : nullptr;
+        if (prices) printWhatIfNote();
+        engineListing->printPage(page, pageSize, [this, prices, selected](size_t i) {
+            const EngineRecord& engine = catalog.engines[i];
+            console() << COLOR_CYAN << " [" << i + 1 << "] " << COLOR_RESET;
+            console() << engine.name << " (" << engine.capacity << "L, "
+                      << engine.horsePower << " HP) - " << formatPrice(engine.price);
+
+            if (engine.co2Emissions > 0) {
+                console() << " - " << engine.co2Emissions << " g/km CO2";
+            }
+
+            if (engine.fuelConsumption > 0) {
+                console() << " - " << engine.fuelConsumption << " l/100km";
+            }
+
+            if (selected && selected->getName() == engine.name) {
+                console() << COLOR_GREEN << " [selected]" << COLOR_RESET;
+            } else if (prices) {
+                printPriceDelta(prices->engineDelta(engine.price));
+            }
+            console() << std::endl;
+        });
+    }
+
+    // Engine selection with improved feedback
+    bool selectEngine(size_t index) {
+        if (currentVehicle && index >= 1 && index <= catalog.engines.size()) {
+            currentVehicle->setEngine(makeEngine(catalog.engines[index - 1], &sessionObjects));
+            printStepDone("Installing engine");
+            console() << COLOR_GREEN << "✓ Engine selected: " << catalog.engines[index - 1].name << COLOR_RESET << std::endl;
+            return true;
+        }
+        console() << COLOR_RED << "✗ Invalid selection. Please try again." << COLOR_RESET << std::endl;
+        return false;
+    }
+
+    // Displaying all available equipment with improved formatting
+    void displayAvailableEquipment() const {
+        size_t page = 0;
+        displayAvailableEquipmentByCategory(page, catalog.equipment.size() + 1);
+    }
+
+    // Adding equipment with improved feedback
+    bool addEquipment(size_t index) {
+        if (currentVehicle && index >= 1 && index <= catalog.equipment.size()) {
+            const EquipmentRecord& equipment = catalog.equipment[index - 1];
+            if (!reserveItem(std::string(equipment.name))) {
+                console() << COLOR_RED << "✗ " << equipment.name << " is out of stock." << COLOR_RESET << std::endl;
+                return false;
+            }
+            currentVehicle->addEquipment(equipment);
+            return true;
+        }
+        console() << COLOR_RED << "✗ Invalid selection. Please try again." << COLOR_RESET << std::endl;
+        return false;
+    }
+
+    // Displaying available colors with improved formatting
+    void displayAvailableColors() const {
+        printHeader("Available Colors");
+
+        for (size_t i = 0; i < catalog.colors.size(); ++i) {
+            std::string colorCode;
+            if (catalog.colors[i] == "Red") colorCode = COLOR_RED;
+            else if (catalog.colors[i] == "Blue") colorCode = COLOR_BLUE;
+            else if (catalog.colors[i] == "Green") colorCode = COLOR_GREEN;
+            else if (catalog.colors[i] == "Yellow") colorCode = COLOR_YELLOW;
+            else if (catalog.colors[i] == "Black") colorCode = COLOR_BOLD;
+            else colorCode = COLOR_WHITE;
+
+            console() << COLOR_CYAN << " [" << i + 1 << "] " << COLOR_RESET
+                      << colorCode << "■ " << catalog.colors[i] << COLOR_RESET << std::endl;
+        }
+    }
+    // Color selection with improved feedback
+    bool selectColor(size_t index) {
+        if (currentVehicle && index >= 1 && index <= catalog.colors.size()) {
+            currentVehicle->setColor(catalog.colors[index - 1]);
+            printStepDone("Applying paint");
+            console() << COLOR_GREEN << "✓ Color selected: " << catalog.colors[index - 1] << COLOR_RESET << std::endl;
+            return true;
+        }
+        console() << COLOR_RED << "✗ Invalid selection. Please try again." << COLOR_RESET << std::endl;
+        return false;
+    }
+
+    // Apply discount
+    bool applyDiscount(double discountPercent) {
+        if (currentVehicle && discountPercent >= 0 && discountPercent <= 30) {
+            currentVehicle->setDiscount(discountPercent);
+            printStepDone("Applying discount");
+            console() << COLOR_GREEN << "✓ " << discountPercent << "% discount applied!" << COLOR_RESET << std::endl;
+            return true;
+        }
+        console() << COLOR_RED << "✗ Invalid discount. Maximum allowed discount is 30%." << COLOR_RESET << std::endl;
+        return false;
+    }
+
+    // Displaying current configuration
+    void displayCurrentConfiguration() const {
+        if (currentVehicle) {
+            clearScreen();
+            currentVehicle->displayInfo();
+            pauseForEnter();
+        } else {
+            console() << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+        }
+    }
+
+    // Quote with option packages, category discounts, volume tier and VAT
+    void displayPriceQuote(unsigned quantity) const {
+        if (!currentVehicle) {
+            console() << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+            return;
+        }
+
+        PricedConfiguration config = pricingPlan->describe(*currentVehicle, quantity);
+        PriceBreakdown quote = pricingPlan->evaluate(config);
+        bool lapsed = inventory && std::any_of(heldItems.begin(), heldItems.end(), [this](const auto& held) {
+            return !inventory->isHeld(held.second);
+        });
+
+        printHeader("Price Quote: " + currentVehicle->getBrand() + " " + currentVehicle->getModel());
+        if (lapsed) {
+            console() << COLOR_YELLOW << "! Some items are no longer reserved; they may sell out before you order."
+                      << COLOR_RESET << std::endl;
+        }
+        if (hasCatalogPriceChanges(*currentVehicle)) {
+            console() << COLOR_YELLOW << "! Prices changed in catalog version " << getCatalogVersion()
+                      << "; this quote uses the prices the configuration was built with." << COLOR_RESET << std::endl;
+        }
+        console() << COLOR_BOLD << "List price: " << COLOR_RESET << formatPrice(quote.listPrice) << std::endl;
+        for (std::string_view bundle : pricingPlan->appliedBundles(config.equipment)) {
+            console() << "  ├─ " << bundle << " applied" << std::endl;
+        }
+        if (quote.bundleSavings > 0) {
+            console() << COLOR_BOLD << "Package savings: " << COLOR_RESET << "-" << formatPrice(quote.bundleSavings) << std::endl;
+        }
+        if (quote.categorySavings > 0) {
+            console() << COLOR_BOLD << "Category discounts: " << COLOR_RESET << "-" << formatPrice(quote.categorySavings) << std::endl;
+        }
+        if (quote.discountAmount > 0) {
+            console() << COLOR_BOLD << "Discount (" << currentVehicle->getDiscount() << "%): " << COLOR_RESET
+                      << "-" << formatPrice(quote.discountAmount) << std::endl;
+        }
+        if (quote.volumeSavings > 0) {
+            console() << COLOR_BOLD << "Volume discount: " << COLOR_RESET << "-" << formatPrice(quote.volumeSavings) << std::endl;
+        }
+        console() << COLOR_BOLD << "Net price per unit: " << COLOR_RESET << formatPrice(quote.unitNet) << std::endl;
+        console() << COLOR_BOLD << "VAT (" << builtInPricingRules.vatPercent << "%): " << COLOR_RESET
+                  << formatPrice(quote.unitVat) << std::endl;
+        console() << COLOR_BOLD << "Gross price per unit: " << COLOR_RESET << formatPrice(quote.unitGross) << std::endl;
+        console() << COLOR_BOLD << COLOR_GREEN << "\nTotal for " << quantity << " unit(s): "
+                  << formatPrice(quote.totalGross) << COLOR_RESET << std::endl;
+    }
+
+    // Running-cost distribution of the current configuration and, if saved, the comparison one
+    void displayTotalCostOfOwnership(const TcoAssumptions& assumptions) const {
+        AllocationScope scope(MemorySubsystem::SIMULATION);
+        std::vector<TcoProfile> profiles;
+        for (const auto& vehicle : {currentVehicle, comparisonVehicle}) {
+            if (!vehicle) continue;
+            TcoProfile profile;
+            std::string error;
+            if (makeTcoProfile(*vehicle, profile, error)) {
+                profiles.push_back(std::move(profile));
+            } else {
+                console() << COLOR_YELLOW << "! " << vehicle->getBrand() << " " << vehicle->getModel() << ": "
+                          << error << COLOR_RESET << std::endl;
+            }
+        }
+        if (profiles.empty()) return;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<TcoResult> results = simulateTco(profiles, assumptions, defaultThreadCount());
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        printHeader("Total Cost of Ownership: " + std::to_string(assumptions.years) + " years, " +
+                    formatNumber(assumptions.annualKm) + " km/year");
+        for (size_t i = 0; i < profiles.size(); ++i) {
+            const TcoResult& result = results[i];
+            console() << COLOR_BOLD << "\n" << profiles[i].label << COLOR_RESET << std::endl;
+            console() << "  ├─ Purchase: " << formatPrice(result.purchase) << std::endl;
+            console() << "  ├─ " << (profiles[i].electric ? "Electricity" : "Fuel") << " (mean): "
+                      << formatPrice(result.meanEnergy) << std::endl;
+            console() << "  ├─ CO2 tax (mean): " << formatPrice(result.meanTax) << std::endl;
+            console() << "  └─ Total: " << COLOR_GREEN << formatPrice(result.p50) << COLOR_RESET << " median, "
+                      << formatPrice(result.p5) << " - " << formatPrice(result.p95) << " (90% of scenarios)" << std::endl;
+            printTcoHistogram(result);
+        }
+        console() << "\nSimulated " << results.front().totals.size() << " price paths per configuration in "
+                  << std::fixed << std::setprecision(1) << elapsedMs << " ms" << std::endl;
+    }
+
+    // Financing of the configuration total: the plan, its amortization schedule, and monthly payments
+    // across terms and down payments at the offer's rate
+    void displayFinancing(const FinanceOffer& offer) const {
+        if (!currentVehicle) {
+            console() << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+            return;
+        }
+        VehicleKind kind = vehicleKindOf(*currentVehicle);
+        double price = currentVehicle->calculateTotalPrice();
+        if (offer.downPayment > price) {
+            console() << COLOR_RED << "✗ The down payment is more than the price of " << formatPrice(price) << "."
+                      << COLOR_RESET << std::endl;
+            return;
+        }
+        FinancePlan plan = planFinancing(price, offer, kind);
+
+        std::ostringstream title;
+        title << "Financing: " << financeKindName(offer.kind) << ", " << offer.months << " months at " << std::fixed
+              << std::setprecision(2) << offer.annualRate << "%";
+        printHeader(title.str());
+        console() << COLOR_BOLD << "Price: " << COLOR_RESET << formatPrice(plan.price) << std::endl;
+        console() << COLOR_BOLD << "Down payment: " << COLOR_RESET << formatPrice(offer.downPayment) << std::endl;
+        console() << COLOR_BOLD << "Financed: " << COLOR_RESET << formatPrice(plan.financed) << std::endl;
+        console() << COLOR_BOLD << COLOR_GREEN << "Monthly payment: " << formatPrice(plan.monthlyPayment) << COLOR_RESET
+                  << std::endl;
+        if (plan.finalCapped) {
+            console() << COLOR_YELLOW << "! " << (offer.kind == FinanceKind::LEASE ? "The residual value" : "The balloon")
+                      << " is capped at the financed amount." << COLOR_RESET << std::endl;
+        }
+        if (offer.kind == FinanceKind::BALLOON) {
+            console() << COLOR_BOLD << "Balloon with the last payment: " << COLOR_RESET << formatPrice(plan.finalAmount)
+                      << std::endl;
+        } else if (offer.kind == FinanceKind::LEASE) {
+            console() << COLOR_BOLD << "Residual value (" << formatNumber(offer.annualKm) << " km/year): " << COLOR_RESET
+                      << formatPrice(plan.finalAmount) << std::endl;
+        }
+        console() << COLOR_BOLD << "Total interest: " << COLOR_RESET << formatPrice(plan.totalInterest) << std::endl;
+        console() << COLOR_BOLD << "Total paid: " << COLOR_RESET << formatPrice(plan.totalPaid) << std::endl;
+
+        console() << COLOR_YELLOW << "\nAmortization schedule:" << COLOR_RESET << std::endl;
+        console() << std::right << std::setw(7) << "Month" << std::setw(20) << "Payment" << std::setw(20) << "Interest"
+                  << std::setw(20) << "Principal" << std::setw(20) << "Balance" << std::endl;
+        for (const auto& row : plan.schedule) {
+            console() << std::setw(7) << row.month << std::setw(20) << formatPrice(row.payment) << std::setw(20)
+                      << formatPrice(row.interest) << std::setw(20) << formatPrice(row.principal) << std::setw(20)
+                      << formatPrice(std::max(0.0, row.balance)) << std::endl;
+        }
+
+        static constexpr unsigned gridTerms[] = {24, 36, 48, 60, 72, 84};
+        static constexpr double downShares[] = {0.0, 0.1, 0.2, 0.3, 0.4};
+        std::vector<double> downPayments;
+        for (double share : downShares) downPayments.push_back(share * price);
+        const double rate[] = {offer.annualRate};
+        auto start = std::chrono::steady_clock::now();
+        std::vector<double> grid = financeGrid(price, offer, kind, gridTerms, downPayments, rate);
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        console() << COLOR_YELLOW << "\nMonthly payment by term and down payment:" << COLOR_RESET << std::endl;
+        console() << std::setw(7) << "Months";
+        for (double share : downShares) console() << std::setw(17) << formatNumber(share * 100) + "% down";
+        console() << std::endl;
+        for (size_t t = 0; t < std::size(gridTerms); ++t) {
+            console() << std::setw(7) << gridTerms[t];
+            for (size_t d = 0; d < downPayments.size(); ++d) {
+                console() << std::setw(17) << formatPrice(grid[t * downPayments.size() + d]);
+            }
+            console() << std::endl;
+        }
+        console() << "\n" << grid.size() << " offers evaluated in " << std::fixed << std::setprecision(1) << us << " us"
+                  << std::endl;
+    }
+
+    // Range and charging estimate over the trip profiles; cached until the configuration or catalog changes
+    std::optional<EvSimulationSummary> simulateRange(const Vehicle& vehicle, std::string& error) const {
+        AllocationScope scope(MemorySubsystem::SIMULATION);
+        EvModel model;
+        if (!makeEvModel(vehicle, model, error)) {
+            return std::nullopt;
+        }
+        if (tripProfiles.empty()) {
+            tripProfiles = generateTripProfiles(EV_TRIP_PROFILES);
+        }
+        return evSimulations.getOrCompute(evConfigurationKey(vehicle), getCatalogVersion(), [&] {
+            return simulateEvTrips(model, tripProfiles, defaultThreadCount());
+        });
+    }
+
+    // Side-by-side real-world range of the current and comparison EVs
+    void displayRangeSimulation() const {
+        std::vector<std::pair<std::string, EvSimulationSummary>> columns;
+        for (const auto& vehicle : {currentVehicle, comparisonVehicle}) {
+            if (!vehicle) continue;
+            std::string error;
+            if (auto summary = simulateRange(*vehicle, error)) {
+                columns.emplace_back(vehicle->getBrand() + " " + vehicle->getModel(), *summary);
+            } else {
+                console() << COLOR_YELLOW << "! " << vehicle->getBrand() << " " << vehicle->getModel() << ": "
+                          << error << COLOR_RESET << std::endl;
+            }
+        }
+        if (columns.empty()) return;
+
+        printHeader("Range Simulation: " + std::to_string(columns.front().second.trips) + " trips");
+        auto row = [&columns](const std::string& label, auto value) {
+            console() << std::left << std::setw(30) << label << std::right;
+            for (const auto& column : columns) {
+                console() << " | " << std::setw(24) << value(column.second);
+            }
+            console() << std::endl;
+        };
+        auto km = [](double value) { return formatNumber(std::round(value)) + " km"; };
+
+        console() << std::setw(30) << "";
+        for (const auto& column : columns) {
+            console() << " | " << std::setw(24) << column.first;
+        }
+        console() << std::endl;
+        console() << std::string(30 + 27 * columns.size(), '-') << std::endl;
+        row("Rated range", [&km](const EvSimulationSummary& s) { return km(s.ratedRangeKm); });
+        row("Real range (mean)", [&km](const EvSimulationSummary& s) { return km(s.meanRangeKm); });
+        row("Real range (10% - 90%)", [&km](const EvSimulationSummary& s) { return km(s.p10RangeKm) + " - " + km(s.p90RangeKm); });
+        row("Trips without charging", [](const EvSimulationSummary& s) { return formatNumber(std::round(s.tripsWithoutStop * 1000) / 10) + "%"; });
+        row("Stops on trips > 300 km", [](const EvSimulationSummary& s) { return formatNumber(std::round(s.longTripStops * 10) / 10); });
+        row("Charging on trips > 300 km", [](const EvSimulationSummary& s) { return formatNumber(std::round(s.longTripChargingMinutes)) + " min"; });
+    }
+
+    std::vector<SearchHit> searchCatalog(std::string_view query, size_t limit = 10) const {
+        ensureSearchIndex();
+        return searchIndex->search(query, limit);
+    }
+
+    // Applies a search result: selects the vehicle or engine, or adds the equipment
+    bool selectSearchHit(const SearchHit& hit) {
+        if (hit.kind == SearchKind::VEHICLE) {
+            return selectVehicle(hit.index + 1);
+        }
+        if (!currentVehicle) {
+            console() << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
+            return false;
+        }
+        return hit.kind == SearchKind::ENGINE ? selectEngine(hit.index + 1) : addEquipment(hit.index + 1);
+    }
+
+    // Saved configurations closest to the current one; identical saves are listed once with their count
+    void displaySimilarConfigurations(size_t limit = 5) const {
+        if (!currentVehicle) {
+            console() << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+            return;
+        }
+
+        struct Candidate {
+            SavedConfiguration config;
+            std::filesystem::path path;
+            size_t copies = 1;
+        };
+        std::vector<Candidate> candidates;
+        std::unordered_map<std::string, size_t> byCanonical;
+        for (const auto& path : listSavedConfigurations(getConfigDirectory().string())) {
+            std::ifstream input(path);
+            SavedConfiguration config;
+            std::string error;
+            if (!input.is_open() || !readSavedConfiguration(input, config, error)) continue;
+            auto [it, inserted] = byCanonical.emplace(configurationKey(config).canonical, candidates.size());
+            if (inserted) {
+                candidates.push_back({std::move(config), path});
+            } else {
+                ++candidates[it->second].copies;
+            }
+        }
+        if (candidates.empty()) {
+            console() << COLOR_YELLOW << "! No saved configurations to compare with." << COLOR_RESET << std::endl;
+            return;
+        }
+
+        ConfigurationFeatureEncoder encoder(catalog);
+        SimilarityIndex index(encoder.getWordCount());
+        index.reserve(candidates.size());
+        for (const auto& candidate : candidates) index.add(encoder.encode(candidate.config));
+        std::vector<SimilarConfiguration> results = index.nearest(encoder.encode(*currentVehicle), limit);
+
+        printHeader("Similar Configurations");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Candidate& candidate = candidates[results[i].id];
+            const SavedConfiguration& config = candidate.config;
+            console() << COLOR_CYAN << " [" << i + 1 << "] " << COLOR_RESET << COLOR_BOLD << config.brand << " "
+                      << config.model << COLOR_RESET << " (" << candidate.path.filename().string() << ")" << std::endl;
+            console() << "  ├─ Similarity: " << COLOR_GREEN << std::fixed << std::setprecision(0)
+                      << (1.0f - results[i].distance) * 100 << "%" << COLOR_RESET << ", equipment overlap "
+                      << results[i].jaccard * 100 << "%" << std::endl;
+            console() << "  ├─ Engine: " << (config.hasEngine ? config.engineName : "none") << ", "
+                      << config.equipment.size() << " equipment items" << std::endl;
+            console() << "  └─ Total: " << formatPrice(config.totalPrice);
+            if (candidate.copies > 1) console() << " (saved " << candidate.copies << " times)";
+            console() << std::endl;
+        }
+    }
+
+    // Visualizing current configuration
+    void visualizeCurrentConfiguration() const {
+        if (currentVehicle) {
+            currentVehicle->visualize();
+        } else {
+            console() << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+        }
+    }
+
+    // Save current configuration as comparison vehicle
+    void saveForComparison() {
+        if (currentVehicle) {
+            comparisonVehicle = currentVehicle->clone(&sessionObjects);
+            console() << COLOR_GREEN << "✓ Current configuration saved for comparison." << COLOR_RESET << std::endl;
+        } else {
+            console() << COLOR_YELLOW << "! No vehicle selected to save for comparison." << COLOR_RESET << std::endl;
+        }
+    }
+    // Compare current configuration with saved one
+    void compareConfigurations() const {
+        if (!currentVehicle) {
+            console() << COLOR_YELLOW << "! No current vehicle selected for comparison." << COLOR_RESET << std::endl;
+            return;
+        }
+
+        if (!comparisonVehicle) {
+            console() << COLOR_YELLOW << "! No vehicle saved for comparison." << COLOR_RESET << std::endl;
+            return;
+        }
+
+        clearScreen();
+        printHeader("Configuration Comparison");
+
+        // Basic vehicle info
+        console() << std::setw(30) << "Feature" << " | "
+                  << std::setw(30) << "Current Configuration" << " | "
+                  << std::setw(30) << "Saved Configuration" << std::endl;
+        console() << std::string(95, '-') << std::endl;
+
+        console() << std::setw(30) << "Vehicle" << " | "
+                  << std::setw(30) << (currentVehicle->getBrand() + " " + currentVehicle->getModel()) << " | "
+                  << std::setw(30) << (comparisonVehicle->getBrand() + " " + comparisonVehicle->getModel()) << std::endl;
+
+        console() << std::setw(30) << "Color" << " | "
+                  << std::setw(30) << currentVehicle->getColor() << " | "
+                  << std::setw(30) << comparisonVehicle->getColor() << std::endl;
+
+        console() << std::setw(30) << "Base Price" << " | "
+                  << std::setw(30) << formatPrice(currentVehicle->getBasePrice()) << " | "
+                  << std::setw(30) << formatPrice(comparisonVehicle->getBasePrice()) << std::endl;
+
+        QuoteBreakdown currentQuote = quote(*currentVehicle);
+        QuoteBreakdown savedQuote = quote(*comparisonVehicle);
+
+        auto engineText = [](const Vehicle& vehicle, const QuoteBreakdown& breakdown) {
+            if (!vehicle.getEngine()) return std::string("No engine selected");
+            return vehicle.getEngine()->getName() + " (" + formatPrice(breakdown.enginePrice) + ")";
+        };
+        console() << std::setw(30) << "Engine" << " | "
+                  << std::setw(30) << engineText(*currentVehicle, currentQuote) << " | "
+                  << std::setw(30) << engineText(*comparisonVehicle, savedQuote) << std::endl;
+
+        // Equipment totals per category
+        for (size_t category = 0; category < EQUIPMENT_CATEGORY_COUNT; ++category) {
+            if (currentQuote.categoryTotals[category] == 0 && savedQuote.categoryTotals[category] == 0) continue;
+            console() << std::setw(30) << categoryToString(static_cast<EquipmentCategory>(category)) << " | "
+                      << std::setw(30) << formatPrice(currentQuote.categoryTotals[category]) << " | "
+                      << std::setw(30) << formatPrice(savedQuote.categoryTotals[category]) << std::endl;
+        }
+
+        if (currentQuote.packageSavings > 0 || savedQuote.packageSavings > 0) {
+            console() << std::setw(30) << "Package savings" << " | "
+                      << std::setw(30) << formatPrice(currentQuote.packageSavings) << " | "
+                      << std::setw(30) << formatPrice(savedQuote.packageSavings) << std::endl;
+        }
+
+        console() << std::setw(30) << "Discount" << " | "
+                  << std::setw(30) << formatPrice(currentQuote.discountAmount) << " | "
+                  << std::setw(30) << formatPrice(savedQuote.discountAmount) << std::endl;
+
+        console() << std::setw(30) << "VAT" << " | "
+                  << std::setw(30) << formatPrice(currentQuote.vat) << " | "
+                  << std::setw(30) << formatPrice(savedQuote.vat) << std::endl;
+
+        // Total price comparison
+        console() << std::string(95, '-') << std::endl;
+        console() << std::setw(30) << "Total Price" << " | "
+                  << std::setw(30) << formatPrice(currentQuote.total) << " | "
+                  << std::setw(30) << formatPrice(savedQuote.total) << std::endl;
+
+        // Price difference
+        double priceDifference = currentQuote.total - savedQuote.total;
+        std::string differenceText = (priceDifference >= 0 ? "+" : "") + formatPrice(priceDifference);
+
+        console() << std::setw(30) << "Price Difference" << " | "
+                  << std::setw(30) << differenceText << " | "
+                  << std::setw(30) << "" << std::endl;
+
+        pauseForEnter();
+    }
+    // Saving configuration to file
+    void saveConfiguration(const std::string& filename) {
+        if (currentVehicle) {
+            // Create configs directory if it doesn't exist
+            std::filesystem::path dirPath = getConfigDirectory();
+            std::error_code ec;
+            std::filesystem::create_directories(dirPath, ec);
+
+            std::string fullPath = configurationPath(filename);
+
+            // Point out an identical configuration saved under another name
+            if (!savedConfigurations) {
+                savedConfigurations.emplace();
+                savedConfigurations->scan(dirPath.string());
+            }
+            ConfigurationKey key = configurationKey(*currentVehicle);
+            auto existing = savedConfigurations->find(key);
+            if (existing && !std::filesystem::equivalent(*existing, fullPath, ec)) {
+                console() << COLOR_YELLOW << "! This configuration is also saved as " << existing->string()
+                          << COLOR_RESET << std::endl;
+            }
+
+            // The text is taken now, so later changes to the vehicle do not race with the write. The
+            // vehicle counts as saved and the index learns the file only once the write succeeded,
+            // and only if nothing changed in the meantime.
+            std::ostringstream contents;
+            currentVehicle->writeConfiguration(contents);
+            std::weak_ptr<Vehicle> vehicle = currentVehicle;
+            uint64_t revision = currentVehicle->getRevision();
+            ioWorker.submit(
+                "Saving " + fullPath,
+                [fullPath, text = contents.str()](IoJob& job) {
+                    if (!writeFileWithProgress(fullPath, text, job)) return false;
+                    job.message = "Configuration saved to " + fullPath;
+                    return true;
+                },
+                [this, vehicle, revision, key, fullPath] {
+                    savedConfigurations->add(key, fullPath);
+                    auto saved = vehicle.lock();
+                    if (saved && saved->getRevision() == revision) saved->markSaved();
+                });
+            console() << "Saving to " << fullPath << " in the background." << std::endl;
+        } else {
+            console() << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+        }
+    }
+
+    // Loading configuration from file with better error handling
+    bool loadConfiguration(const std::string& filename) {
+        std::string fullPath = configurationPath(filename);
+
+        // Read and parse on the I/O worker; the spinner shows how much of the file has been read
+        auto config = std::make_shared<SavedConfiguration>();
+        auto job = ioWorker.submit("Loading " + fullPath, [fullPath, config](IoJob& job) {
+            std::string contents;
+            std::string error;
+            if (!readFileWithProgress(fullPath, contents, job)) return false;
+            if (!parseSavedConfiguration(contents, *config, error)) {
+                job.message = "Invalid configuration file: " + error;
+                return false;
+            }
+            return true;
+        });
+        waitForJob(ioWorker, *job);
+        ioWorker.release(job);
+        if (!job->succeeded) {
+            consoleErrors() << COLOR_RED << "✗ " << job->message << COLOR_RESET << std::endl;
+            return false;
+        }
+
+        std::vector<std::string> warnings;
+        auto vehicle = resolveSavedConfiguration(*config, catalog, &sessionObjects, warnings);
+        if (!vehicle) {
+            consoleErrors() << COLOR_RED << "✗ No matching vehicle found in available vehicles." << COLOR_RESET << std::endl;
+            return false;
+        }
+
+        for (const auto& warning : warnings) {
+            console() << COLOR_YELLOW << "! " << warning << COLOR_RESET << std::endl;
+        }
+
+        // Work recovered from an autosave stays unsaved until it is saved under a name of its own
+        std::filesystem::path autosaveDirectory = (getConfigDirectory() / "autosave").lexically_normal();
+        if (std::filesystem::path(fullPath).parent_path().lexically_normal() != autosaveDirectory) {
+            vehicle->markSaved();
+        }
+        currentVehicle = vehicle;
+        currentVehicle->setPricingPlan(pricingPlan);
+        // A loaded quote keeps every item; those out of stock are pointed out
+        std::vector<std::string> items{currentVehicle->getBrand() + " " + currentVehicle->getModel()};
+        for (const auto& equipment : currentVehicle->getSelectedEquipment()) items.push_back(equipment.getName());
+        for (const auto& item : items) {
+            if (!reserveItem(item)) {
+                console() << COLOR_YELLOW << "! " << item << " is out of stock." << COLOR_RESET << std::endl;
+            }
+        }
+        releaseUnusedItems();
+        console() << COLOR_GREEN << "✓ Configuration has been loaded from file: " << fullPath << COLOR_RESET << std::endl;
+        return true;
+    }
+
+    // Catalog accessor for batch jobs
+    const CatalogView& getCatalog() const { return catalog; }
+
+    // Checking if vehicle has been selected
+    bool hasSelectedVehicle() const {
+        return currentVehicle != nullptr;
+    }
+
+    // Generate PDF and HTML reports of the configuration
+    void generateReport() const {
+        if (!currentVehicle) {
+            console() << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+            return;
+        }
+
+        std::filesystem::path dirPath = workDirectory / "reports";
+        std::error_code ec;
+        std::filesystem::create_directories(dirPath, ec);
+
+        std::string baseName = currentVehicle->getBrand() + "_" + currentVehicle->getModel() + "_report";
+        std::replace(baseName.begin(), baseName.end(), ' ', '_');
+
+        // The worker renders a heap copy, so the session can keep changing the vehicle meanwhile
+        std::shared_ptr<const Vehicle> vehicle = currentVehicle->clone(std::pmr::new_delete_resource());
+        ioWorker.submit("Rendering " + baseName, [vehicle, dirPath, baseName](IoJob& job) {
+            constexpr const char* extensions[] = {".pdf", ".html"};
+            job.total = std::size(extensions);
+            std::string written;
+            for (const char* extension : extensions) {
+                std::filesystem::path path = dirPath / (baseName + extension);
+                if (!renderReport(*vehicle, path)) {
+                    job.message = "Cannot write report: " + path.string();
+                    return false;
+                }
+                written += (written.empty() ? "" : ", ") + path.string();
+                ++job.completed;
+            }
+            job.message = "Report has been generated: " + written;
+            return true;
+        });
+        console() << "Generating " << baseName << " in the background." << std::endl;
+    }
+
+    BackgroundIoWorker& getIoWorker() const { return ioWorker; }
+
+    void enableAutosave(const std::string& path) {
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+        autosaver.emplace(path);
+    }
+
+    const Autosaver* getAutosaver() const { return autosaver ? &*autosaver : nullptr; }
+
+    uint8_t getUnsavedChanges() const {
+        return currentVehicle ? currentVehicle->getUnsavedChanges() : 0;
+    }
+
+    // Hands unsaved changes to the autosaver. Only the text is taken here; the write waits for a
+    // quiet period and happens on the autosaver's thread
+    void autosave() {
+        if (!autosaver || !currentVehicle) return;
+        if (currentVehicle == autosavedVehicle && currentVehicle->getRevision() == autosavedRevision) return;
+        autosavedVehicle = currentVehicle;
+        autosavedRevision = currentVehicle->getRevision();
+        if (currentVehicle->getUnsavedChanges() == 0) return;
+
+        std::ostringstream text;
+        currentVehicle->writeConfiguration(text);
+        autosaver->schedule(text.str());
+    }
+
+    // At the end of a session: keeps the autosave only if it holds work that was never saved
+    void finishAutosave() {
+        if (!autosaver) return;
+        if (getUnsavedChanges() == 0) {
+            autosaver->discard();
+        } else {
+            autosave();
+        }
+    }
+    // Show equipment by category
+    void displayEquipmentByCategory() const {
+        if (!currentVehicle) {
+            console() << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+            return;
+        }
+
+        printHeader("Current Equipment by Category");
+
+        // Group the selected equipment by category in a stack-backed scratch arena
+        std::array<std::byte, 2048> scratchBuffer;
+        std::pmr::monotonic_buffer_resource scratch(scratchBuffer.data(), scratchBuffer.size());
+        EquipmentGroups equipmentByCategory = groupEquipmentByCategory(currentVehicle->getSelectedEquipment(), &scratch);
+        double totalEquipmentCost = 0.0;
+
+        for (const auto& equipment : currentVehicle->getSelectedEquipment()) {
+            totalEquipmentCost += equipment.getPrice();
+        }
+
+        if (equipmentByCategory.empty()) {
+            console() << COLOR_YELLOW << "No equipment added yet." << COLOR_RESET << std::endl;
+            return;
+        }
+
+        for (const auto& categoryPair : equipmentByCategory) {
+            console() << COLOR_YELLOW << "\n" << categoryToString(categoryPair.first) << ":" << COLOR_RESET << std::endl;
+
+            double categoryTotal = 0.0;
+            for (const Equipment* equipment : categoryPair.second) {
+                console() << "  ├─ " << equipment->getName() << ": " << formatPrice(equipment->getPrice()) << std::endl;
+                console() << "  │  " << equipment->getDescription() << std::endl;
+                categoryTotal += equipment->getPrice();
+            }
+
+            console() << "  └─ " << COLOR_BOLD << "Category total: " << formatPrice(categoryTotal)
+                      << " (" << std::fixed << std::setprecision(1)
+                      << (categoryTotal / totalEquipmentCost * 100) << "% of equipment cost)"
+                      << COLOR_RESET << std::endl;
+        }
+
+        console() << COLOR_BOLD << COLOR_GREEN << "\nTotal equipment cost: "
+                  << formatPrice(totalEquipmentCost) << COLOR_RESET << std::endl;
+    }
+
+    // Show available equipment by category, one page at a time
+    void displayAvailableEquipmentByCategory(size_t& page, size_t pageSize = LISTING_PAGE_SIZE) const {
+        printHeader("Available Equipment by Category");
+
+        ensureListing(equipmentListing, buildEquipmentListing);
+        const WhatIfPricing* prices = currentWhatIf();
+        if (prices) printWhatIfNote();
+        equipmentListing->printPage(page, pageSize, [this, prices](size_t i) {
+            const EquipmentRecord& equipment = catalog.equipment[i];
+            console() << COLOR_CYAN << " [" << i + 1 << "] " << COLOR_RESET;
+            console() << equipment.name << " - " << equipment.description << " - "
+                      << formatPrice(equipment.price);
+            // Items priced differently since they were added are not in the plan's mask
+            bool selected = prices && (prices->isSelected(i) || std::any_of(currentVehicle->getSelectedEquipment().begin(),
+                                                                            currentVehicle->getSelectedEquipment().end(),
+                                                                            [&equipment](const Equipment& e) {
+                                                                                return e.hasName(equipment.name);
+                                                                            }));
+            if (selected) {
+                console() << COLOR_GREEN << " [selected]" << COLOR_RESET;
+            } else if (prices) {
+                printPriceDelta(prices->toggleDelta(i, equipment.price));
+            }
+            printStock(std::string(equipment.name));
+            console() << std::endl;
+        });
+    }
+
+    // Remove equipment by name
+    bool removeEquipment(std::string_view name) {
+        if (!currentVehicle) {
+            console() << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+            return false;
+        }
+        const auto& selectedEquipment = currentVehicle->getSelectedEquipment();
+        bool present = std::any_of(selectedEquipment.begin(), selectedEquipment.end(),
+                                   [name](const Equipment& e) { return e.hasName(name); });
+        currentVehicle->removeEquipment(std::string(name));
+        releaseUnusedItems();
+        return present;
+    }
+
+    // Remove equipment from current vehicle; returns the name of the removed item, if any
+    std::string removeEquipmentMenu() {
+        if (!currentVehicle) {
+            console() << COLOR_YELLOW << "! No vehicle selected yet." << COLOR_RESET << std::endl;
+            return {};
+        }
+
+        const auto& selectedEquipment = currentVehicle->getSelectedEquipment();
+
+        if (selectedEquipment.empty()) {
+            console() << COLOR_YELLOW << "! No equipment to remove." << COLOR_RESET << std::endl;
+            return {};
+        }
+
+        printHeader("Remove Equipment");
+
+        for (size_t i = 0; i < selectedEquipment.size(); ++i) {
+            console() << COLOR_CYAN << " [" << i + 1 << "] " << COLOR_RESET;
+            console() << selectedEquipment[i].getName() << " - "
+                      << formatPrice(selectedEquipment[i].getPrice()) << std::endl;
+        }
+
+        console() << COLOR_CYAN << " [0] " << COLOR_RESET << "Cancel" << std::endl;
+
+        console() << "\nSelect equipment to remove: ";
+        std::string input;
+        size_t choice = 0;
+        if (!(std::cin >> input)) return {};
+        if (!parseNumber(std::string_view(input), choice)) choice = SIZE_MAX;
+
+        if (choice == 0) {
+            return {};
+        }
+
+        if (choice >= 1 && choice <= selectedEquipment.size()) {
+            std::string name = selectedEquipment[choice - 1].getName();
+            currentVehicle->removeEquipment(name);
+            releaseUnusedItems();
+            return name;
+        }
+        console() << COLOR_RED << "✗ Invalid selection." << COLOR_RESET << std::endl;
+        return {};
+    }
+};
+// Numbered list of search results, as the menu and scripts pick from it
+void printSearchHits(const std::vector<SearchHit>& hits) {
+    if (hits.empty()) {
+        console() << COLOR_YELLOW << "! Nothing found." << COLOR_RESET << std::endl;
+        return;
+    }
+    for (size_t i = 0; i < hits.size(); ++i) {
+        const char* kind = hits[i].kind == SearchKind::VEHICLE ? "Vehicle"
+                         : hits[i].kind == SearchKind::ENGINE ? "Engine" : "Equipment";
+        console() << COLOR_CYAN << " [" << i + 1 << "] " << COLOR_RESET << hits[i].title
+                  << COLOR_YELLOW << " (" << kind << ")" << COLOR_RESET << std::endl;
+    }
+}
+
+// Script commands: one line per menu action, "<command> [argument]". Vehicles, engines, equipment
+// and colors are given by name, or by the number the menus show; names keep recorded scripts valid
+// when the catalog order changes. Lines starting with '#' are comments.
+enum class ScriptVerb {
+    VEHICLE,
+    ENGINE,
+    ADD,
+    REMOVE,
+    COLOR,
+    DISCOUNT,
+    SHOW,
+    VISUALIZE,
+    SAVE,
+    LOAD,
+    KEEP,
+    COMPARE,
+    REPORT,
+    QUOTE,
+    TCO,
+    RANGE,
+    SEARCH,
+    PICK,
+    SIMILAR,
+    FINANCE,
+    MEMORY,
+    ORDER,
+    WAIT,
+    EXIT
+};
+
+struct ScriptVerbInfo {
+    std::string_view name;
+    ScriptVerb verb;
+    bool needsArgument;
+    std::string_view usage;
+};
+
+constexpr ScriptVerbInfo scriptVerbs[] = {
+    {"vehicle", ScriptVerb::VEHICLE, true, "vehicle <number|brand model>    Select vehicle [1]"},
+    {"engine", ScriptVerb::ENGINE, true, "engine <number|name>            Select engine [2]"},
+    {"add", ScriptVerb::ADD, true, "add <number|name>               Add equipment [3]"},
+    {"remove", ScriptVerb::REMOVE, true, "remove <name>                   Remove equipment [4]"},
+    {"color", ScriptVerb::COLOR, true, "color <number|name>             Select color [5]"},
+    {"discount", ScriptVerb::DISCOUNT, true, "discount <percent>              Apply discount [6]"},
+    {"show", ScriptVerb::SHOW, false, "show                            Display current configuration [7]"},
+    {"visualize", ScriptVerb::VISUALIZE, false, "visualize                       Visualize vehicle [8]"},
+    {"save", ScriptVerb::SAVE, true, "save <filename>                 Save configuration [9]"},
+    {"load", ScriptVerb::LOAD, true, "load <filename>                 Load configuration [10]"},
+    {"keep", ScriptVerb::KEEP, false, "keep                            Save for comparison [11]"},
+    {"compare", ScriptVerb::COMPARE, false, "compare                         Compare configurations [12]"},
+    {"report", ScriptVerb::REPORT, false, "report                          Generate PDF report [13]"},
+    {"quote", ScriptVerb::QUOTE, false, "quote [units]                   Price quote [14]"},
+    {"tco", ScriptVerb::TCO, false, "tco [years] [km per year]       Total cost of ownership [15]"},
+    {"range", ScriptVerb::RANGE, false, "range                           EV range and charging simulation [16]"},
+    {"search", ScriptVerb::SEARCH, true, "search <query>                  Search catalog [17]"},
+    {"pick", ScriptVerb::PICK, true, "pick <number>                   Apply a result of the last search [17]"},
+    {"similar", ScriptVerb::SIMILAR, false, "similar                         Similar saved configurations [18]"},
+    {"finance", ScriptVerb::FINANCE, true,
+     "finance <loan|balloon|lease> [months] [down] [rate %] [balloon %|km per year]  Financing [19]"},
+    {"memory", ScriptVerb::MEMORY, false, "memory [file|-]                 Memory footprint, as JSON when given a file [20]"},
+    {"order", ScriptVerb::ORDER, false, "order                           Place the order, selling from stock [21]"},
+    {"wait", ScriptVerb::WAIT, false, "wait                            Wait for background saves and reports"},
+    {"exit", ScriptVerb::EXIT, false, "exit                            Wait for background work and stop [0]"},
+};
+
+std::string_view scriptVerbName(ScriptVerb verb) {
+    for (const auto& info : scriptVerbs) {
+        if (info.verb == verb) return info.name;
+    }
+    return "?";
+}
+
+struct ScriptCommand {
+    ScriptVerb verb;
+    std::string argument;
+    size_t line = 0;
+};
+
+// Parses a whole script up front, so a typo fails before anything runs
+bool parseScript(std::istream& input, std::vector<ScriptCommand>& commands, std::string& error) {
+    std::string text;
+    size_t lineNumber = 0;
+    while (std::getline(input, text)) {
+        ++lineNumber;
+        std::string_view line = trimView(text);
+        if (line.empty() || line.front() == '#') continue;
+
+        size_t space = line.find_first_of(" \t");
+        std::string_view name = line.substr(0, space);
+        std::string_view argument = space == std::string_view::npos ? std::string_view() : trimView(line.substr(space));
+
+        auto info = std::find_if(std::begin(scriptVerbs), std::end(scriptVerbs),
+                                 [name](const ScriptVerbInfo& candidate) { return candidate.name == name; });
+        if (info == std::end(scriptVerbs)) {
+            error = "line " + std::to_string(lineNumber) + ": unknown command '" + std::string(name) + "'";
+            return false;
+        }
+        if (info->needsArgument && argument.empty()) {
+            error = "line " + std::to_string(lineNumber) + ": usage: " + std::string(info->usage.substr(0, info->usage.find("  ")));
+            return false;
+        }
+        commands.push_back({info->verb, std::string(argument), lineNumber});
+    }
+    return true;
+}
+
+// Runs script commands against one configurator session, through the same calls as the menu
+class ScriptSession {
+private:
+    VehicleConfigurator& configurator;
+    std::optional<CatalogIndex> catalogIndex;
+    uint64_t indexedVersion = 0;
+    std::vector<SearchHit> lastHits;
+    bool finished = false;
+
+    // Menu number of a catalog entry given by number or by name
+    template <typename Find>
+    std::optional<size_t> resolve(const std::string& argument, const char* what, Find find) {
+        size_t number = 0;
+        if (parseNumber(std::string_view(argument), number)) return number;
+
+        if (!catalogIndex || indexedVersion != configurator.getCatalogVersion()) {
+            catalogIndex.emplace(configurator.getCatalog());
+            indexedVersion = configurator.getCatalogVersion();
+        }
+        if (auto position = find(*catalogIndex)) return *position + 1;
+        console() << COLOR_RED << "✗ Unknown " << what << ": " << argument << COLOR_RESET << std::endl;
+        return std::nullopt;
+    }
+
+public:
+    explicit ScriptSession(VehicleConfigurator& configurator) : configurator(configurator) {}
+
+    bool isFinished() const { return finished; }
+
+    // Returns false when the action fails the way the menu would report it
+    bool execute(const ScriptCommand& command) {
+        const std::string& argument = command.argument;
+        if (configurator.hasInventory()) configurator.renewHolds();
+        switch (command.verb) {
+            case ScriptVerb::VEHICLE: {
+                auto number = resolve(argument, "vehicle", [&argument](const CatalogIndex& index) { return index.findVehicle(argument); });
+                return number && configurator.selectVehicle(*number);
+            }
+            case ScriptVerb::ENGINE: {
+                auto number = resolve(argument, "engine", [&argument](const CatalogIndex& index) { return index.findEngine(argument); });
+                return number && configurator.selectEngine(*number);
+            }
+            case ScriptVerb::ADD: {
+                auto number = resolve(argument, "equipment", [&argument](const CatalogIndex& index) { return index.findEquipment(argument); });
+                return number && configurator.addEquipment(*number);
+            }
+            case ScriptVerb::REMOVE:
+                return configurator.removeEquipment(argument);
+            case ScriptVerb::COLOR: {
+                auto number = resolve(argument, "color", [&argument](const CatalogIndex& index) { return index.findColor(argument); });
+                return number && configurator.selectColor(*number);
+            }
+            case ScriptVerb::DISCOUNT: {
+                double percent = 0.0;
+                if (!parseNumber(std::string_view(argument), percent)) {
+                    console() << COLOR_RED << "✗ Invalid discount: " << argument << COLOR_RESET << std::endl;
+                    return false;
+                }
+                return configurator.applyDiscount(percent);
+            }
+            case ScriptVerb::SHOW:
+                configurator.displayCurrentConfiguration();
+                return configurator.hasSelectedVehicle();
+            case ScriptVerb::VISUALIZE:
+                configurator.visualizeCurrentConfiguration();
+                return configurator.hasSelectedVehicle();
+            case ScriptVerb::SAVE:
+                configurator.saveConfiguration(argument);
+                return configurator.hasSelectedVehicle();
+            case ScriptVerb::LOAD:
+                return configurator.loadConfiguration(argument);
+            case ScriptVerb::KEEP:
+                configurator.saveForComparison();
+                return configurator.hasSelectedVehicle();
+            case ScriptVerb::COMPARE:
+                configurator.compareConfigurations();
+                return configurator.hasSelectedVehicle();
+            case ScriptVerb::REPORT:
+                configurator.generateReport();
+                return configurator.hasSelectedVehicle();
+            case ScriptVerb::QUOTE: {
+                unsigned quantity = 1;
+                if (!argument.empty() && !parseNumber(std::string_view(argument), quantity)) return false;
+                configurator.displayPriceQuote(std::max(1u, quantity));
+                return configurator.hasSelectedVehicle();
+            }
+            case ScriptVerb::TCO: {
+                TcoAssumptions assumptions;
+                std::istringstream values(argument);
+                if (!argument.empty() && !(values >> assumptions.years)) return false;
+                if (!values.eof() && !(values >> assumptions.annualKm)) return false;
+                assumptions.years = std::clamp(assumptions.years, 1u, 30u);
+                assumptions.annualKm = std::max(0.0, assumptions.annualKm);
+                configurator.displayTotalCostOfOwnership(assumptions);
+                return configurator.hasSelectedVehicle();
+            }
+            case ScriptVerb::RANGE:
+                configurator.displayRangeSimulation();
+                return configurator.hasSelectedVehicle();
+            case ScriptVerb::SEARCH:
+                lastHits = configurator.searchCatalog(argument);
+                printSearchHits(lastHits);
+                return !lastHits.empty();
+            case ScriptVerb::PICK: {
+                size_t number = 0;
+                if (!parseNumber(std::string_view(argument), number) || number < 1 || number > lastHits.size()) {
+                    console() << COLOR_RED << "✗ No search result " << argument << COLOR_RESET << std::endl;
+                    return false;
+                }
+                return configurator.selectSearchHit(lastHits[number - 1]);
+            }
+            case ScriptVerb::SIMILAR:
+                configurator.displaySimilarConfigurations();
+                return configurator.hasSelectedVehicle();
+            case ScriptVerb::FINANCE: {
+                FinanceOffer offer;
+                std::istringstream values(argument);
+                std::string kind;
+                values >> kind;
+                if (!parseFinanceKind(kind, offer.kind)) return false;
+                double& last = offer.kind == FinanceKind::LEASE ? offer.annualKm : offer.balloonPercent;
+                if (!values.eof() && !(values >> offer.months)) return false;
+                if (!values.eof() && !(values >> offer.downPayment)) return false;
+                if (!values.eof() && !(values >> offer.annualRate)) return false;
+                if (!values.eof() && !(values >> last)) return false;
+                clampFinanceOffer(offer);
+                configurator.displayFinancing(offer);
+                return configurator.hasSelectedVehicle();
+            }
+            case ScriptVerb::MEMORY:
+                if (argument.empty()) {
+                    configurator.displayMemoryFootprint();
+                    return true;
+                }
+                return configurator.writeMemoryFootprint(argument);
+            case ScriptVerb::ORDER:
+                return configurator.placeOrder();
+            case ScriptVerb::WAIT:
+            case ScriptVerb::EXIT: {
+                BackgroundIoWorker& worker = configurator.getIoWorker();
+                bool succeeded = true;
+                for (const auto& job : worker.pendingJobs()) {
+                    waitForJob(worker, *job);
+                }
+                for (const auto& job : worker.takeFinished()) {
+                    printJobOutcome(*job);
+                    succeeded = succeeded && job->succeeded;
+                }
+                finished = command.verb == ScriptVerb::EXIT;
+                return succeeded;
+            }
+        }
+        return false;
+    }
+};
+
+// Writes the actions of an interactive session as a script for --script and --replay
+class SessionRecorder {
+private:
+    std::ofstream output;
+
+public:
+    bool open(const std::string& path) {
+        output.open(path);
+        if (output.is_open()) {
+            output << "# Vehicle Configurator session" << std::endl;
+        }
+        return output.is_open();
+    }
+
+    void record(ScriptVerb verb, std::string_view argument = {}) {
+        output << scriptVerbName(verb);
+        if (!argument.empty()) output << " " << argument;
+        output << std::endl;
+    }
+};
+
+// Shows a paged listing and reads an item id; n and p turn the page. Returns 0 to cancel and
+// SIZE_MAX for anything that is not a number. With redraw false the listing is already on screen.
+template <typename Display>
+size_t choosePagedItem(Display display, size_t& page, const char* prompt, bool redraw = true) {
+    while (true) {
+        if (redraw) {
+            clearScreen();
+            display(page);
+            std::cout << "\n";
+        }
+        std::cout << prompt;
+        std::string input;
+        if (!(std::cin >> input)) return 0;
+        redraw = true;
+        if (input == "n" || input == "N") {
+            ++page;
+        } else if (input == "p" || input == "P") {
+            if (page > 0) --page;
+        } else {
+            size_t id;
+            return parseNumber(std::string_view(input), id) ? id : SIZE_MAX;
+        }
+    }
+}
+
+// Reads a whole number within [minimum, maximum] from the menu; anything else, negative numbers
+// included, is reported and rejected instead of wrapping around in an unsigned variable
+bool readMenuNumber(const char* prompt, long minimum, long maximum, long& value) {
+    std::cout << prompt;
+    std::string input;
+    if (!(std::cin >> input)) return false;
+    if (parseNumber(std::string_view(input), value) && value >= minimum && value <= maximum) return true;
+    std::cout << COLOR_RED << "✗ Please enter a number from " << minimum << " to " << maximum << "." << COLOR_RESET
+              << std::endl;
+    return false;
+}
+
+// Same for amounts that may have decimals
+bool readMenuNumber(const char* prompt, double minimum, double maximum, double& value) {
+    std::cout << prompt;
+    std::string input;
+    if (!(std::cin >> input)) return false;
+    if (parseNumber(std::string_view(input), value) && value >= minimum && value <= maximum) return true;
+    std::ostringstream range; // Whole digits, where the default precision would switch to 1e+06
+    range << std::setprecision(15) << minimum << " to " << maximum;
+    std::cout << COLOR_RED << "✗ Please enter a number from " << range.str() << "." << COLOR_RESET << std::endl;
+    return false;
+}
+
+// Main user interface function with enhanced UI
+void runUserInterface(const CatalogStore* catalogStore = nullptr, SessionRecorder* recorder = nullptr,
+                      const std::string& autosavePath = {}, Inventory* inventory = nullptr) {
+    // std::cin gets its own buffer, so waitForInput can tell whether a read would block
+    std::ios::sync_with_stdio(false);
+    AllocationScope scope(MemorySubsystem::SESSION);
+    VehicleConfigurator configurator(catalogStore);
+    if (inventory) configurator.attachInventory(inventory);
+    bool running = true;
+
+    // A leftover autosave is work the last session never saved. It is moved aside before this
+    // session autosaves over it, and can be loaded like any file.
+    bool recoverable = !autosavePath.empty() && std::filesystem::exists(autosavePath);
+    std::string recoveryName;
+    if (recoverable) {
+        std::filesystem::path leftover = autosavePath;
+        std::filesystem::path recovered;
+        for (size_t copy = 1;; ++copy) {
+            std::string stem = leftover.stem().string() + ".recovered" + (copy > 1 ? "-" + std::to_string(copy) : "");
+            recovered = leftover.parent_path() / (stem + leftover.extension().string());
+            if (!std::filesystem::exists(recovered)) break;
+        }
+        std::error_code ec;
+        std::filesystem::rename(leftover, recovered, ec);
+        recoverable = !ec;
+        recoveryName = leftover.parent_path().filename().string() + "/" + recovered.stem().string();
+    }
+    if (!autosavePath.empty()) {
+        configurator.enableAutosave(autosavePath);
+    }
+
+    // Completed actions go to the recorder as script commands, with catalog entries by name
+    auto record = [recorder](ScriptVerb verb, std::string_view argument = {}) {
+        if (recorder) recorder->record(verb, argument);
+    };
+
+    clearScreen();
+    std::cout << COLOR_BOLD << COLOR_BLUE;
+    std::cout << R"(
+ __      __   _     _      _        _____             __ _                       _
+ \ \    / /__| |__ (_)__ _| |___   / / __| ___  _ _  / _(_)__ _ _  _ _ _ __ _ _| |_ ___ _ _ _
+  \ \/\/ / -_) '_ \| / _` | / -_) / / (__/ _ \| ' \| |_| / _` | || | '_/ _` |_  _/ _ \ '_| '_|
+   \_/\_/\___|_.__// \__,_|_\___| /_/\___\___/|_||_|_| |_\__, |\_,_|_| \__,_| \__\___/_| |_|
+                 |__/                                     |___/
+)" << COLOR_RESET << std::endl;
+
+    std::cout << COLOR_YELLOW << "Welcome to the enhanced Vehicle Configurator!" << COLOR_RESET << std::endl;
+    std::cout << "This application allows you to configure your dream vehicle with various options.\n" << std::endl;
+    if (recoverable) {
+        std::cout << COLOR_YELLOW << "! Unsaved work from the last session was autosaved. Load it with option 10 as '"
+                  << recoveryName << "'." << COLOR_RESET << std::endl;
+    }
+
+    while (running) {
+        if (configurator.refreshCatalog()) {
+            std::cout << COLOR_GREEN << "✓ Catalog updated to version " << configurator.getCatalogVersion()
+                      << COLOR_RESET << std::endl;
+        }
+        reportFinishedJobs(configurator.getIoWorker());
+        configurator.autosave();
+        if (configurator.hasInventory()) configurator.renewHolds();
+        if (uint8_t changes = configurator.getUnsavedChanges()) {
+            std::cout << COLOR_YELLOW << "! Unsaved changes: " << describeChanges(changes) << COLOR_RESET << std::endl;
+        }
+
+        printHeader("Main Menu");
+
+        printMenuItem(1, "Select vehicle");
+        printMenuItem(2, "Select engine");
+        printMenuItem(3, "Add equipment");
+        printMenuItem(4, "Remove equipment");
+        printMenuItem(5, "Select color");
+        printMenuItem(6, "Apply discount");
+        printMenuItem(7, "Display current configuration");
+        printMenuItem(8, "Visualize vehicle");
+        printMenuItem(9, "Save configuration");
+        printMenuItem(10, "Load configuration");
+        printMenuItem(11, "Save for comparison");
+        printMenuItem(12, "Compare configurations");
+        printMenuItem(13, "Generate PDF report");
+        printMenuItem(14, "Price quote (packages, volume, VAT)");
+        printMenuItem(15, "Total cost of ownership");
+        printMenuItem(16, "EV range and charging simulation");
+        printMenuItem(17, "Search catalog");
+        printMenuItem(18, "Similar saved configurations");
+        printMenuItem(19, "Financing and leasing");
+        printMenuItem(20, "Memory footprint");
+        printMenuItem(21, "Place order");
+        printMenuItem(0, "Exit");
+
+        // The prompt keeps showing background progress until the user types. End of input exits;
+        // anything but a number is an invalid option.
+        long choice = -1;
+        const std::string prompt = std::string(COLOR_BOLD) + "Your choice: " + COLOR_RESET;
+        std::cout << "\n" << prompt << std::flush;
+        waitForInputWithStatus(configurator.getIoWorker(), prompt);
+        std::string input;
+        if (!(std::cin >> input)) {
+            choice = 0;
+        } else if (!parseNumber(std::string_view(input), choice)) {
+            choice = -1;
+        }
+
+        switch (choice) {
+            case 1: {
+                size_t page = 0;
+                size_t vehicleIndex = choosePagedItem(
+                    [&configurator](size_t& page) { configurator.displayAvailableVehicles(page); }, page,
+                    "Select vehicle number (0 to cancel): ");
+
+                if (vehicleIndex == 0) break;
+
+                if (!configurator.selectVehicle(vehicleIndex)) {
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+                const VehicleRecord& vehicle = configurator.getCatalog().vehicles[vehicleIndex - 1];
+                record(ScriptVerb::VEHICLE, std::string(vehicle.brand) + " " + std::string(vehicle.model));
+                break;
+            }
+            case 2: {
+                if (!configurator.hasSelectedVehicle()) {
+                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+
+                size_t page = 0;
+                size_t engineIndex = choosePagedItem(
+                    [&configurator](size_t& page) { configurator.displayAvailableEngines(page); }, page,
+                    "Select engine number (0 to cancel): ");
+
+                if (engineIndex == 0) break;
+
+                if (!configurator.selectEngine(engineIndex)) {
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+                record(ScriptVerb::ENGINE, configurator.getCatalog().engines[engineIndex - 1].name);
+                break;
+            }
+            case 3: {
+                if (!configurator.hasSelectedVehicle()) {
+                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+
+                auto display = [&configurator](size_t& page) { configurator.displayAvailableEquipmentByCategory(page); };
+                size_t page = 0;
+                size_t equipmentIndex = choosePagedItem(display, page, "Select equipment number (0 to finish): ");
+
+                while (equipmentIndex != 0) {
+                    if (!configurator.addEquipment(equipmentIndex)) {
+                        std::cout << "Invalid equipment selection." << std::endl;
+                    } else {
+                        record(ScriptVerb::ADD, configurator.getCatalog().equipment[equipmentIndex - 1].name);
+                    }
+                    equipmentIndex = choosePagedItem(display, page, "Select next equipment (0 to finish): ", false);
+                }
+                break;
+            }
+            case 4: {
+                clearScreen();
+                std::string removed = configurator.removeEquipmentMenu();
+                if (!removed.empty()) record(ScriptVerb::REMOVE, removed);
+                std::cout << "\nPress Enter to continue...";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 5: {
+                if (!configurator.hasSelectedVehicle()) {
+                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+
+                clearScreen();
+                configurator.displayAvailableColors();
+                std::cout << "\n";
+                long colorIndex;
+                if (!readMenuNumber("Select color number (0 to cancel): ", 0,
+                                    static_cast<long>(configurator.getCatalog().colors.size()), colorIndex)) {
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+
+                if (colorIndex == 0) break;
+
+                if (!configurator.selectColor(static_cast<size_t>(colorIndex))) {
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+                record(ScriptVerb::COLOR, configurator.getCatalog().colors[colorIndex - 1]);
+                break;
+            }
+            case 6: {
+                if (!configurator.hasSelectedVehicle()) {
+                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+
+                clearScreen();
+                printHeader("Apply Discount");
+                double discountPercent;
+                if (!readMenuNumber("Enter discount percentage (0-30): ", 0.0, 30.0, discountPercent) ||
+                    !configurator.applyDiscount(discountPercent)) {
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+                record(ScriptVerb::DISCOUNT, formatNumber(discountPercent));
+                break;
+            }
+            case 7: {
+                configurator.displayCurrentConfiguration();
+                record(ScriptVerb::SHOW);
+                break;
+            }
+            case 8: {
+                configurator.visualizeCurrentConfiguration();
+                record(ScriptVerb::VISUALIZE);
+                break;
+            }
+            case 9: {
+                if (!configurator.hasSelectedVehicle()) {
+                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+
+                clearScreen();
+                printHeader("Save Configuration");
+                std::cout << "Enter filename (without extension): ";
+                std::string filename;
+                std::cin.ignore();
+                std::getline(std::cin, filename);
+
+                configurator.saveConfiguration(filename);
+                record(ScriptVerb::SAVE, filename);
+                std::cout << "Press Enter to continue...";
+                std::cin.get();
+                break;
+            }
+            case 10: {
+                clearScreen();
+                printHeader("Load Configuration");
+                std::cout << "Enter filename (without extension): ";
+                std::string filename;
+                std::cin.ignore();
+                std::getline(std::cin, filename);
+
+                if (!configurator.loadConfiguration(filename)) {
+                    std::cout << "Press Enter to continue...";
+                    std::cin.get();
+                    break;
+                }
+                record(ScriptVerb::LOAD, filename);
+                break;
+            }
+            case 11: {
+                configurator.saveForComparison();
+                record(ScriptVerb::KEEP);
+                std::cout << "Press Enter to continue...";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 12: {
+                configurator.compareConfigurations();
+                record(ScriptVerb::COMPARE);
+                break;
+            }
+            case 13: {
+                configurator.generateReport();
+                record(ScriptVerb::REPORT);
+                std::cout << "Press Enter to continue...";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 14: {
+                if (!configurator.hasSelectedVehicle()) {
+                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+
+                clearScreen();
+                long quantity;
+                if (!readMenuNumber("Number of units: ", 1, 100000, quantity)) {
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+
+                configurator.displayPriceQuote(static_cast<unsigned>(quantity));
+                record(ScriptVerb::QUOTE, std::to_string(quantity));
+                std::cout << "Press Enter to continue...";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 15: {
+                if (!configurator.hasSelectedVehicle()) {
+                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+
+                clearScreen();
+                printHeader("Total Cost of Ownership");
+                TcoAssumptions assumptions;
+                long years;
+                if (!readMenuNumber("Years of ownership: ", 1, 30, years)) {
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+                assumptions.years = static_cast<unsigned>(years);
+                if (!readMenuNumber("Kilometers per year: ", 0.0, 1000000.0, assumptions.annualKm)) {
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+
+                configurator.displayTotalCostOfOwnership(assumptions);
+                record(ScriptVerb::TCO, std::to_string(assumptions.years) + " " + formatNumber(assumptions.annualKm));
+                std::cout << "Press Enter to continue...";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 16: {
+                clearScreen();
+                if (!configurator.hasSelectedVehicle()) {
+                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
+                } else {
+                    configurator.displayRangeSimulation();
+                    record(ScriptVerb::RANGE);
+                }
+                std::cout << "Press Enter to continue...";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 17: {
+                clearScreen();
+                printHeader("Search Catalog");
+                std::cin.ignore();
+                while (true) {
+                    std::cout << "\nSearch (empty to finish): ";
+                    std::string query;
+                    if (!std::getline(std::cin, query) || trimView(query).empty()) break;
+
+                    auto start = std::chrono::steady_clock::now();
+                    std::vector<SearchHit> hits = configurator.searchCatalog(query);
+                    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+                    printSearchHits(hits);
+                    if (hits.empty()) continue;
+                    record(ScriptVerb::SEARCH, query);
+                    std::cout << hits.size() << " results in " << std::fixed << std::setprecision(0) << us << " us" << std::endl;
+
+                    std::cout << "Pick a result (0 to search again): ";
+                    std::string pick;
+                    std::getline(std::cin, pick);
+                    size_t number = 0;
+                    if (parseNumber(trimView(pick), number) && number >= 1 && number <= hits.size() &&
+                        configurator.selectSearchHit(hits[number - 1])) {
+                        record(ScriptVerb::PICK, std::to_string(number));
+                    }
+                }
+                break;
+            }
+            case 18: {
+                clearScreen();
+                configurator.displaySimilarConfigurations();
+                record(ScriptVerb::SIMILAR);
+                std::cout << "Press Enter to continue...";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 19: {
+                if (!configurator.hasSelectedVehicle()) {
+                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
+                    std::cout << "Press Enter to continue...";
+                    std::cin.ignore();
+                    std::cin.get();
+                    break;
+                }
+
+                clearScreen();
+                printHeader("Financing and Leasing");
+                FinanceOffer offer;
+                long type = 1;
+                long months = 1;
+                bool valid = readMenuNumber("Type (1 loan, 2 balloon loan, 3 lease): ", 1, 3, type) &&
+                             readMenuNumber("Term in months: ", 1, 120, months) &&
+                             readMenuNumber("Down payment: ", 0.0, 1e9, offer.downPayment) &&
+                             readMenuNumber("Annual interest rate (%): ", 0.0, 30.0, offer.annualRate);
+                offer.kind = type == 3 ? FinanceKind::LEASE : type == 2 ? FinanceKind::BALLOON : FinanceKind::LOAN;
+                if (valid && offer.kind == FinanceKind::BALLOON) {
+                    valid = readMenuNumber("Balloon (% of price): ", 0.0, 80.0, offer.balloonPercent);
+                } else if (valid && offer.kind == FinanceKind::LEASE) {
+                    valid = readMenuNumber("Kilometers per year: ", 0.0, 100000.0, offer.annualKm);
+                }
+                if (!valid) {
+                    std::cout << "Press Enter to continue...";
                     std::cin.ignore();
                     std::cin.get();
+                    break;
+                }
+                offer.months = static_cast<unsigned>(months);
+
+                clampFinanceOffer(offer);
+                configurator.displayFinancing(offer);
+                // Fixed-point, so a replay computes the same offer to the cent
+                std::ostringstream arguments;
+                arguments << std::fixed << std::setprecision(2) << financeKindName(offer.kind) << " " << offer.months
+                          << " " << offer.downPayment << " " << std::setprecision(4) << offer.annualRate;
+                if (offer.kind == FinanceKind::BALLOON) arguments << " " << offer.balloonPercent;
+                if (offer.kind == FinanceKind::LEASE) arguments << " " << std::setprecision(2) << offer.annualKm;
+                record(ScriptVerb::FINANCE, arguments.str());
+                std::cout << "Press Enter to continue...";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 20: {
+                clearScreen();
+                configurator.displayMemoryFootprint();
+                std::string path;
+                std::cout << "\nWrite as JSON to file (Enter to skip): ";
+                std::cin.ignore();
+                std::getline(std::cin, path);
+                path = std::string(trimView(path));
+                if (!path.empty()) configurator.writeMemoryFootprint(path);
+                record(ScriptVerb::MEMORY, path);
+                std::cout << "Press Enter to continue...";
+                std::cin.get();
+                break;
+            }
+            case 21: {
+                if (configurator.placeOrder()) record(ScriptVerb::ORDER);
+                std::cout << "Press Enter to continue...";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+            case 0: {
+                for (const auto& job : configurator.getIoWorker().pendingJobs()) {
+                    waitForJob(configurator.getIoWorker(), *job);
+                }
+                reportFinishedJobs(configurator.getIoWorker());
+                configurator.finishAutosave();
+                if (configurator.getUnsavedChanges() != 0 && configurator.getAutosaver()) {
+                    std::cout << COLOR_YELLOW << "! Unsaved changes are kept in " << configurator.getAutosaver()->getPath()
+                              << "; the next session offers to recover them." << COLOR_RESET << std::endl;
+                }
+                record(ScriptVerb::EXIT);
+                std::cout << COLOR_YELLOW << "Thank you for using Vehicle Configurator!" << COLOR_RESET << std::endl;
+                running = false;
+                break;
+            }
+            default: {
+                std::cout << COLOR_RED << "✗ Invalid option. Please try again." << COLOR_RESET << std::endl;
+                std::cout << "Press Enter to continue...";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+            }
+        }
+    }
+}
+
+bool loadScript(const std::string& path, std::vector<ScriptCommand>& commands) {
+    std::ifstream file;
+    if (path != "-") {
+        file.open(path);
+        if (!file.is_open()) {
+            std::cerr << COLOR_RED << "✗ Cannot open script: " << path << COLOR_RESET << std::endl;
+            return false;
+        }
+    }
+    std::string error;
+    if (!parseScript(path == "-" ? std::cin : file, commands, error)) {
+        std::cerr << COLOR_RED << "✗ " << path << ": " << error << COLOR_RESET << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Runs a script as one session with its output shown; returns non-zero if any command failed
+int runScript(const CatalogStore* catalogStore, const std::string& path, Inventory* inventory = nullptr) {
+    std::vector<ScriptCommand> commands;
+    if (!loadScript(path, commands)) return 1;
+
+    consoleTarget.interactive = false;
+    AllocationScope scope(MemorySubsystem::SESSION);
+    VehicleConfigurator configurator(catalogStore);
+    if (inventory) configurator.attachInventory(inventory);
+    ScriptSession session(configurator);
+    size_t failed = 0;
+    for (const auto& command : commands) {
+        console() << COLOR_CYAN << "> " << scriptVerbName(command.verb)
+                  << (command.argument.empty() ? "" : " ") << command.argument << COLOR_RESET << std::endl;
+        if (!session.execute(command)) {
+            console() << COLOR_RED << "✗ Line " << command.line << " failed" << COLOR_RESET << std::endl;
+            ++failed;
+        }
+        reportFinishedJobs(configurator.getIoWorker());
+        if (session.isFinished()) break;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+// Discards everything written to it
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// Replays a script as many independent sessions from several threads at full speed and reports
+// throughput and latency percentiles per command. Session output is discarded.
+void runScriptReplay(const CatalogStore* catalogStore, const std::string& path, size_t sessions, size_t threads,
+                     Inventory* inventory = nullptr) {
+    std::vector<ScriptCommand> commands;
+    if (!loadScript(path, commands)) return;
+
+    constexpr size_t VERB_COUNT = std::size(scriptVerbs);
+    struct Samples {
+        std::array<std::vector<double>, VERB_COUNT> commandUs;
+        std::vector<double> sessionMs;
+        size_t failures = 0;
+    };
+    Samples total;
+    std::mutex totalMutex;
+    std::atomic<size_t> nextSession{0};
+
+    std::error_code ec;
+    std::filesystem::path replayDirectory = std::filesystem::temp_directory_path(ec) /
+        ("vehicle-configurator-replay-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    if (ec) replayDirectory = "replay-sessions";
+
+    threads = std::max<size_t>(1, std::min(threads, sessions));
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                NullBuffer discard;
+                std::ostream output(&discard);
+                consoleTarget = {&output, &output, false};
+                AllocationScope scope(MemorySubsystem::SESSION);
+
+                Samples local;
+                for (size_t session; (session = nextSession.fetch_add(1, std::memory_order_relaxed)) < sessions;) {
+                    auto sessionStart = std::chrono::steady_clock::now();
+                    // Each session saves and loads in a directory of its own, removed when it ends
+                    std::filesystem::path sessionDirectory = replayDirectory / ("session-" + std::to_string(session));
+                    {
+                        VehicleConfigurator configurator(catalogStore, sessionDirectory);
+                        if (inventory) configurator.attachInventory(inventory);
+                        ScriptSession session(configurator);
+                        for (const auto& command : commands) {
+                            auto commandStart = std::chrono::steady_clock::now();
+                            bool ok = session.execute(command);
+                            local.commandUs[static_cast<size_t>(command.verb)].push_back(
+                                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - commandStart).count());
+                            local.failures += ok ? 0 : 1;
+                            if (session.isFinished()) break;
+                        }
+                    }
+                    std::error_code ec;
+                    std::filesystem::remove_all(sessionDirectory, ec);
+                    local.sessionMs.push_back(
+                        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sessionStart).count());
+                }
+
+                std::lock_guard<std::mutex> lock(totalMutex);
+                for (size_t verb = 0; verb < VERB_COUNT; ++verb) {
+                    total.commandUs[verb].insert(total.commandUs[verb].end(), local.commandUs[verb].begin(),
+                                                 local.commandUs[verb].end());
+                }
+                total.sessionMs.insert(total.sessionMs.end(), local.sessionMs.begin(), local.sessionMs.end());
+                total.failures += local.failures;
+            });
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::filesystem::remove_all(replayDirectory, ec);
+
+    auto percentile = [](const std::vector<double>& sorted, double q) {
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(q * sorted.size()))];
+    };
+
+    printHeader("Replay: " + std::to_string(sessions) + " sessions, " + std::to_string(threads) + " threads");
+    std::cout << std::left << std::setw(12) << "Command" << std::right << std::setw(10) << "Count"
+              << std::setw(12) << "Mean us" << std::setw(12) << "p50 us" << std::setw(12) << "p90 us"
+              << std::setw(12) << "p99 us" << std::setw(12) << "Max us" << std::endl;
+    std::cout << std::string(82, '-') << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    size_t commandCount = 0;
+    for (size_t verb = 0; verb < VERB_COUNT; ++verb) {
+        std::vector<double>& samples = total.commandUs[verb];
+        if (samples.empty()) continue;
+        std::sort(samples.begin(), samples.end());
+        commandCount += samples.size();
+        double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+        std::cout << std::left << std::setw(12) << scriptVerbName(static_cast<ScriptVerb>(verb)) << std::right
+                  << std::setw(10) << samples.size() << std::setw(12) << mean << std::setw(12) << percentile(samples, 0.5)
+                  << std::setw(12) << percentile(samples, 0.9) << std::setw(12) << percentile(samples, 0.99)
+                  << std::setw(12) << samples.back() << std::endl;
+    }
+
+    std::sort(total.sessionMs.begin(), total.sessionMs.end());
+    if (!total.sessionMs.empty()) {
+        std::cout << "\nSession latency: p50 " << percentile(total.sessionMs, 0.5) << " ms, p90 "
+                  << percentile(total.sessionMs, 0.9) << " ms, p99 " << percentile(total.sessionMs, 0.99)
+                  << " ms, max " << total.sessionMs.back() << " ms" << std::endl;
+    }
+    std::cout << "Throughput: " << std::setprecision(0) << commandCount / seconds << " commands/s, "
+              << total.sessionMs.size() / seconds << " sessions/s (" << std::setprecision(2) << seconds << " s)"
+              << std::endl;
+    if (inventory) {
+        Inventory::Stats stats = inventory->getStats();
+        std::cout << "Inventory: " << stats.reserved << " holds, " << stats.committed << " sold, " << stats.rejected
+                  << " out of stock, " << stats.released << " released" << std::endl;
+    }
+    if (total.failures > 0) {
+        std::cout << COLOR_YELLOW << "! " << total.failures << " commands failed" << COLOR_RESET << std::endl;
+    } else {
+        std::cout << COLOR_GREEN << "✓ All commands succeeded" << COLOR_RESET << std::endl;
+    }
+}
+
+// Result of one bulk load + bulk pricing run
+struct BatchRunStats {
+    size_t allocations = 0;
+    size_t bytesAllocated = 0;
+    double loadMs = 0.0;
+    double priceMs = 0.0;
+    double releaseMs = 0.0;
+    double checksum = 0.0;
+};
+
+// Loads and prices a batch of synthetic configurations with all objects allocated from the given resource
+BatchRunStats runConfigurationBatch(const VehicleConfigurator& catalog, size_t count,
+                                    std::pmr::memory_resource* resource, const CountingResource& counter) {
+    using Clock = std::chrono::steady_clock;
+    const auto& vehicles = catalog.getCatalog().vehicles;
+    const auto& engines = catalog.getCatalog().engines;
+    const auto& equipment = catalog.getCatalog().equipment;
+    const auto& colors = catalog.getCatalog().colors;
+
+    BatchRunStats stats;
+    size_t allocationsBefore = counter.getAllocationCount();
+    size_t bytesBefore = counter.getBytesAllocated();
+
+    // Bulk loading: materialize every configuration
+    auto start = Clock::now();
+    {
+        std::pmr::vector<std::shared_ptr<Vehicle>> batch(resource);
+        batch.reserve(count);
+
+        uint32_t seed = 12345;
+        for (size_t i = 0; i < count; ++i) {
+            auto vehicle = makeVehicle(vehicles[i % vehicles.size()], resource);
+            vehicle->setEngine(makeEngine(engines[(i * 7) % engines.size()], resource));
+            vehicle->setColor(colors[i % colors.size()]);
+            vehicle->setDiscount(static_cast<double>(i % 31));
+
+            seed = seed * 1664525u + 1013904223u;
+            for (size_t j = 0; j < equipment.size(); ++j) {
+                if (seed & (1u << (j % 32))) {
+                    vehicle->attachEquipment(equipment[j]);
+                }
+            }
+            batch.push_back(std::move(vehicle));
+        }
+        auto loaded = Clock::now();
+        stats.loadMs = std::chrono::duration<double, std::milli>(loaded - start).count();
+
+        // Bulk pricing: totals plus the per-category breakdown shown by displayInfo
+        for (const auto& vehicle : batch) {
+            stats.checksum += vehicle->calculateTotalPrice();
+            EquipmentGroups groups = groupEquipmentByCategory(vehicle->getSelectedEquipment(), resource);
+            for (const auto& categoryPair : groups) {
+                for (const Equipment* item : categoryPair.second) {
+                    stats.checksum += item->getPrice() * 1e-6;
+                }
+            }
+        }
+        auto priced = Clock::now();
+        stats.priceMs = std::chrono::duration<double, std::milli>(priced - loaded).count();
+        start = priced;
+    }
+    stats.releaseMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    stats.allocations = counter.getAllocationCount() - allocationsBefore;
+    stats.bytesAllocated = counter.getBytesAllocated() - bytesBefore;
+    return stats;
+}
+
+// Compares the global heap against a per-batch arena for bulk loading and bulk pricing
+void runArenaBenchmark(size_t count) {
+    VehicleConfigurator catalog;
+    printHeader("Arena benchmark: " + std::to_string(count) + " configurations");
+
+    CountingResource heapCounter(std::pmr::new_delete_resource());
+    BatchRunStats heap = runConfigurationBatch(catalog, count, &heapCounter, heapCounter);
+
+    CountingResource arenaCounter(std::pmr::new_delete_resource());
+    BatchRunStats arena;
+    double arenaReleaseMs = 0.0;
+    {
+        std::pmr::monotonic_buffer_resource batchArena(&arenaCounter);
+        arena = runConfigurationBatch(catalog, count, &batchArena, arenaCounter);
+
+        auto start = std::chrono::steady_clock::now();
+        batchArena.release();
+        arenaReleaseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    arena.releaseMs += arenaReleaseMs;
+
+    auto printRow = [](const std::string& label, const BatchRunStats& stats) {
+        std::cout << std::left << std::setw(14) << label << std::right
+                  << std::setw(14) << stats.allocations
+                  << std::setw(14) << stats.bytesAllocated / 1024
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(12) << stats.loadMs
+                  << std::setw(12) << stats.priceMs
+                  << std::setw(12) << stats.releaseMs << std::endl;
+    };
+
+    std::cout << std::left << std::setw(14) << "Resource" << std::right
+              << std::setw(14) << "Allocations" << std::setw(14) << "KiB"
+              << std::setw(12) << "Load ms" << std::setw(12) << "Price ms" << std::setw(12) << "Free ms" << std::endl;
+    std::cout << std::string(78, '-') << std::endl;
+    printRow("Global heap", heap);
+    printRow("Batch arena", arena);
+
+    if (arena.allocations > 0) {
+        std::cout << COLOR_GREEN << "\nUpstream allocations reduced " << heap.allocations / arena.allocations
+                  << "x, total time " << std::fixed << std::setprecision(2)
+                  << (heap.loadMs + heap.priceMs + heap.releaseMs) << " ms -> "
+                  << (arena.loadMs + arena.priceMs + arena.releaseMs) << " ms" << COLOR_RESET << std::endl;
+    }
+    if (std::abs(heap.checksum - arena.checksum) > 1e-6 * std::abs(heap.checksum)) {
+        std::cout << COLOR_RED << "✗ Checksum mismatch between runs" << COLOR_RESET << std::endl;
+    }
+}
+
+// Times plan compilation and batch scoring of random configurations
+void runPricingBenchmark(const CatalogSnapshot& snapshot, size_t count) {
+    const CatalogView& catalog = snapshot.getView();
+    printHeader("Pricing benchmark: " + std::to_string(count) + " configurations");
+
+    auto start = std::chrono::steady_clock::now();
+    PricingPlan plan(catalog, snapshot.getVersion(), builtInPricingRules);
+    double compileUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    std::mt19937 rng(42);
+    size_t itemCount = catalog.equipment.size();
+    std::vector<PricedConfiguration> configs(count);
+    for (auto& config : configs) {
+        const VehicleRecord& vehicle = catalog.vehicles[rng() % catalog.vehicles.size()];
+        config.basePrice = vehicle.basePrice + catalog.engines[rng() % catalog.engines.size()].price;
+        for (size_t item = 0; item < itemCount; ++item) {
+            if (rng() % 3 == 0) config.equipment.set(item);
+        }
+        config.discountPercent = rng() % 31;
+        config.quantity = 1 + rng() % 30;
+    }
+
+    std::vector<PriceBreakdown> results(count);
+    start = std::chrono::steady_clock::now();
+    plan.evaluateBatch(configs, results);
+    double evaluateNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    double checksum = 0.0;
+    for (const auto& result : results) checksum += result.totalGross;
+
+    std::cout << "Plan compiled in " << std::fixed << std::setprecision(1) << compileUs << " us" << std::endl;
+    std::cout << "Evaluated " << count << " configurations in " << std::setprecision(2) << evaluateNs / 1e6
+              << " ms (" << std::setprecision(1) << (count ? evaluateNs / count : 0.0) << " ns each)" << std::endl;
+    std::cout << "Checksum: " << formatPrice(checksum) << std::endl;
+}
+
+// All single-edit prices of random configurations: one incremental pass against evaluating every
+// edited configuration in full, plus the cost of catching up after one toggle
+void runWhatIfBenchmark(const CatalogSnapshot& snapshot, size_t count) {
+    const CatalogView& catalog = snapshot.getView();
+    printHeader("What-if benchmark: " + std::to_string(count) + " configurations");
+
+    PricingPlan plan(catalog, snapshot.getVersion(), builtInPricingRules);
+    size_t itemCount = plan.getItemCount();
+    std::mt19937 rng(49);
+    std::vector<PricedConfiguration> configs(count);
+    std::vector<double> enginePrices(count);
+    for (size_t i = 0; i < count; ++i) {
+        enginePrices[i] = catalog.engines[rng() % catalog.engines.size()].price;
+        configs[i].basePrice = catalog.vehicles[rng() % catalog.vehicles.size()].basePrice + enginePrices[i];
+        for (size_t item = 0; item < itemCount; ++item) {
+            if (rng() % 3 == 0) configs[i].equipment.set(item);
+        }
+        configs[i].discountPercent = rng() % 31;
+    }
+
+    double fullMs = 0.0;
+    double passMs = 0.0;
+    double toggleMs = 0.0;
+    double maxDifference = 0.0;
+    size_t recomputed = 0;
+    std::vector<double> fullDeltas(itemCount + catalog.engines.size());
+    for (size_t i = 0; i < count; ++i) {
+        const PricedConfiguration& config = configs[i];
+
+        auto start = std::chrono::steady_clock::now();
+        double current = plan.evaluate(config).unitGross;
+        for (size_t item = 0; item < itemCount; ++item) {
+            PricedConfiguration edited = config;
+            edited.equipment.flip(item);
+            fullDeltas[item] = plan.evaluate(edited).unitGross - current;
+        }
+        for (size_t engine = 0; engine < catalog.engines.size(); ++engine) {
+            PricedConfiguration edited = config;
+            edited.basePrice += catalog.engines[engine].price - enginePrices[i];
+            fullDeltas[itemCount + engine] = plan.evaluate(edited).unitGross - current;
+        }
+        auto middle = std::chrono::steady_clock::now();
+        WhatIfPricing whatIf;
+        whatIf.update(plan, config, enginePrices[i]);
+        auto end = std::chrono::steady_clock::now();
+        fullMs += std::chrono::duration<double, std::milli>(middle - start).count();
+        passMs += std::chrono::duration<double, std::milli>(end - middle).count();
+
+        for (size_t item = 0; item < itemCount; ++item) {
+            maxDifference = std::max(maxDifference, std::abs(whatIf.toggleDelta(item, 0.0) - fullDeltas[item]));
+        }
+        for (size_t engine = 0; engine < catalog.engines.size(); ++engine) {
+            maxDifference = std::max(maxDifference, std::abs(whatIf.engineDelta(catalog.engines[engine].price) -
+                                                             fullDeltas[itemCount + engine]));
+        }
+
+        PricedConfiguration toggled = config;
+        size_t item = rng() % itemCount;
+        toggled.equipment.flip(item);
+        start = std::chrono::steady_clock::now();
+        recomputed += whatIf.update(plan, toggled, enginePrices[i]);
+        toggleMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        double expected = plan.evaluate(config).unitGross - plan.evaluate(toggled).unitGross;
+        maxDifference = std::max(maxDifference, std::abs(whatIf.toggleDelta(item, 0.0) - expected));
+    }
+
+    size_t candidates = itemCount + catalog.engines.size();
+    std::cout << candidates << " single edits per configuration" << std::endl;
+    std::cout << std::fixed << "Evaluated one by one: " << std::setprecision(2) << fullMs << " ms ("
+              << std::setprecision(1) << (count ? fullMs * 1e6 / count : 0.0) << " ns per configuration)" << std::endl;
+    std::cout << "One pass:             " << std::setprecision(2) << passMs << " ms (" << std::setprecision(1)
+              << (count ? passMs * 1e6 / count : 0.0) << " ns per configuration)" << std::endl;
+    std::cout << "After one toggle:     " << std::setprecision(2) << toggleMs << " ms (" << std::setprecision(1)
+              << (count ? toggleMs * 1e6 / count : 0.0) << " ns, " << (count ? double(recomputed) / count : 0.0)
+              << " items recomputed on average)" << std::endl;
+    std::cout << "Max difference: " << std::setprecision(6) << maxDifference << std::endl;
+}
+
+// TCO distribution of every catalog vehicle with every engine, ranked by median cost
+void runTcoSurvey(const CatalogView& catalog, size_t paths, size_t threadCount) {
+    TcoAssumptions assumptions;
+    assumptions.paths = paths;
+
+    std::vector<TcoProfile> profiles;
+    auto plan = std::make_shared<const PricingPlan>(catalog, 0, builtInPricingRules);
+    for (const auto& record : catalog.vehicles) {
+        auto vehicle = makeVehicle(record, {});
+        vehicle->setPricingPlan(plan);
+        std::vector<const EngineRecord*> engines;
+        if (record.kind == VehicleKind::ELECTRIC) {
+            engines.push_back(nullptr);
+        } else {
+            for (const auto& engine : catalog.engines) engines.push_back(&engine);
+        }
+        for (const EngineRecord* engine : engines) {
+            vehicle->setEngine(engine ? makeEngine(*engine, {}) : nullptr);
+            TcoProfile profile;
+            std::string error;
+            if (makeTcoProfile(*vehicle, profile, error)) {
+                profiles.push_back(std::move(profile));
+            }
+        }
+    }
+    printHeader("TCO survey: " + std::to_string(profiles.size()) + " configurations");
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<TcoResult> results = simulateTco(profiles, assumptions, threadCount);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<size_t> order(profiles.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&results](size_t a, size_t b) { return results[a].p50 < results[b].p50; });
+
+    std::cout << std::left << std::setw(36) << "Configuration" << std::right << std::setw(20) << "P5"
+              << std::setw(20) << "Median" << std::setw(20) << "P95" << std::endl;
+    std::cout << std::string(96, '-') << std::endl;
+    for (size_t i : order) {
+        std::cout << std::left << std::setw(36) << profiles[i].label << std::right
+                  << std::setw(20) << formatPrice(results[i].p5) << std::setw(20) << formatPrice(results[i].p50)
+                  << std::setw(20) << formatPrice(results[i].p95) << std::endl;
+    }
+
+    size_t simulated = profiles.size() * (results.empty() ? 0 : results.front().totals.size());
+    std::cout << "\nSimulated " << simulated << " paths of " << assumptions.years << " years in " << std::fixed
+              << std::setprecision(3) << seconds << " s (" << std::setprecision(0)
+              << (seconds > 0 ? simulated / seconds : 0.0) << " paths/s, " << threadCount << " threads)" << std::endl;
+}
+
+// Range estimates for every catalog EV, bare and fully equipped; the second pass is served from the cache
+void runEvSimulationSurvey(const CatalogView& catalog, uint64_t catalogVersion, size_t tripCount, size_t threadCount) {
+    std::vector<TripProfile> trips = generateTripProfiles(tripCount);
+    EvSimulationCache cache(64);
+
+    std::vector<std::shared_ptr<Vehicle>> vehicles;
+    for (const auto& record : catalog.vehicles) {
+        if (record.kind != VehicleKind::ELECTRIC) continue;
+        vehicles.push_back(makeVehicle(record, {}));
+        auto equipped = makeVehicle(record, {});
+        for (const auto& item : catalog.equipment) equipped->attachEquipment(item);
+        vehicles.push_back(equipped);
+    }
+    printHeader("EV simulation: " + std::to_string(vehicles.size()) + " configurations x " +
+                std::to_string(trips.size()) + " trips");
+
+    std::cout << std::left << std::setw(34) << "Configuration" << std::right << std::setw(10) << "Rated"
+              << std::setw(10) << "Mean" << std::setw(10) << "P10" << std::setw(12) << "No stop"
+              << std::setw(14) << "Long stops" << std::setw(14) << "Long charge" << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+
+    for (int pass = 0; pass < 2; ++pass) {
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& vehicle : vehicles) {
+            EvModel model;
+            std::string error;
+            if (!makeEvModel(*vehicle, model, error)) continue;
+            EvSimulationSummary summary = cache.getOrCompute(evConfigurationKey(*vehicle), catalogVersion, [&] {
+                return simulateEvTrips(model, trips, threadCount);
+            });
+            if (pass == 0) {
+                std::string label = model.label + (vehicle->getSelectedEquipment().empty() ? "" : " (all options)");
+                std::cout << std::left << std::setw(34) << label << std::right << std::fixed << std::setprecision(0)
+                          << std::setw(10) << summary.ratedRangeKm << std::setw(10) << summary.meanRangeKm
+                          << std::setw(10) << summary.p10RangeKm << std::setw(11) << summary.tripsWithoutStop * 100 << "%"
+                          << std::setw(14) << std::setprecision(1) << summary.longTripStops
+                          << std::setw(10) << std::setprecision(0) << summary.longTripChargingMinutes << " min" << std::endl;
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << (pass == 0 ? "\nSimulated in " : "Cached pass in ") << std::fixed << std::setprecision(3)
+                  << ms << " ms" << std::endl;
+    }
+    auto stats = cache.getStats();
+    std::cout << "Cache: " << stats.hits << " hits, " << stats.misses << " misses" << std::endl;
+}
+
+// Search latency over a synthetic catalog: as-you-type prefixes of real titles, and the same titles with typos
+void runSearchBenchmark(const CatalogView& catalog, size_t entryCount) {
+    // Sampled titles and the per-query averages need at least one entry
+    if (entryCount == 0) {
+        std::cerr << COLOR_RED << "✗ The search benchmark needs at least one entry." << COLOR_RESET << std::endl;
+        return;
+    }
+    SimulationRandom random(11);
+    auto pseudoWord = [&random] {
+        static constexpr std::string_view syllables[] = {"ka", "lo", "mi", "ne", "ro", "su", "ta", "vi", "xe", "zo",
+                                                         "ber", "dan", "gor", "lin", "mar", "tor", "vel", "sky"};
+        std::string word;
+        size_t count = 2 + random.next() % 3;
+        for (size_t i = 0; i < count; ++i) word += syllables[random.next() % std::size(syllables)];
+        return word;
+    };
+
+    SearchIndex index;
+    std::vector<std::string> titles;
+    for (size_t i = 0; i < entryCount; ++i) {
+        std::string title;
+        std::string description = pseudoWord() + " " + pseudoWord() + " " + pseudoWord();
+        SearchKind kind;
+        if (i % 3 == 0) {
+            const VehicleRecord& vehicle = catalog.vehicles[i / 3 % catalog.vehicles.size()];
+            title = std::string(vehicle.brand) + " " + std::string(vehicle.model) + " " + pseudoWord();
+            kind = SearchKind::VEHICLE;
+        } else if (i % 3 == 1) {
+            title = std::string(catalog.engines[i / 3 % catalog.engines.size()].name) + " " + pseudoWord();
+            kind = SearchKind::ENGINE;
+        } else {
+            title = pseudoWord() + " " + std::string(catalog.equipment[i / 3 % catalog.equipment.size()].name);
+            kind = SearchKind::EQUIPMENT;
+        }
+        index.add(kind, i, title, description);
+        titles.push_back(std::move(title));
+    }
+
+    printHeader("Search benchmark: " + std::to_string(entryCount) + " entries");
+    auto start = std::chrono::steady_clock::now();
+    index.build();
+    std::cout << "Index built in " << std::fixed << std::setprecision(1)
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms" << std::endl;
+
+    std::vector<std::string> typed;
+    std::vector<std::string> typos;
+    for (size_t sample = 0; sample < 200; ++sample) {
+        const std::string& title = titles[random.next() % titles.size()];
+        for (size_t length = 1; length <= title.size(); ++length) typed.push_back(title.substr(0, length));
+
+        std::string typo = title;
+        size_t position = random.next() % (typo.size() - 1);
+        if (std::isalpha(static_cast<unsigned char>(typo[position])) && std::isalpha(static_cast<unsigned char>(typo[position + 1]))) {
+            std::swap(typo[position], typo[position + 1]);
+        }
+        typos.push_back(typo);
+    }
+
+    auto measure = [&index](const std::string& label, const std::vector<std::string>& queries) {
+        std::vector<double> latencies;
+        size_t found = 0;
+        for (const auto& query : queries) {
+            auto start = std::chrono::steady_clock::now();
+            found += !index.search(query).empty();
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        double mean = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+        std::cout << std::left << std::setw(18) << label << std::right << std::setw(7) << queries.size() << " queries  "
+                  << std::fixed << std::setprecision(1) << "mean " << mean << " us, p50 " << latencies[latencies.size() / 2]
+                  << " us, p99 " << latencies[latencies.size() * 99 / 100] << " us, max " << latencies.back()
+                  << " us, " << found << " with results" << std::endl;
+    };
+    measure("As-you-type", typed);
+    measure("With typos", typos);
+}
+
+// Payment grids for one configuration and one offer across many configurations, timed against
+// evaluating every offer on its own and checked against the amortization plan
+void runFinanceBenchmark(const CatalogView& catalog, size_t configurationCount) {
+    printHeader("Financing benchmark");
+    const double price = catalog.vehicles.front().basePrice + catalog.engines.front().price;
+    const VehicleKind kind = catalog.vehicles.front().kind;
+
+    std::vector<unsigned> terms;
+    for (unsigned months = 12; months <= 84; months += 6) terms.push_back(months);
+    std::vector<double> downPayments;
+    for (int percent = 0; percent <= 100; ++percent) downPayments.push_back(price * percent / 200.0);
+    std::vector<double> rates;
+    for (int basisPoints = 0; basisPoints <= 1500; basisPoints += 5) rates.push_back(basisPoints / 100.0);
+
+    for (FinanceKind financeKind : {FinanceKind::LOAN, FinanceKind::BALLOON, FinanceKind::LEASE}) {
+        FinanceOffer offer;
+        offer.kind = financeKind;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<double> grid = financeGrid(price, offer, kind, terms, downPayments, rates);
+        double gridMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        // Every offer evaluated on its own, and the plan for a sample of them
+        start = std::chrono::steady_clock::now();
+        double maxDifference = 0.0;
+        size_t cell = 0;
+        for (unsigned months : terms) {
+            for (double rate : rates) {
+                for (double down : downPayments) {
+                    FinanceOffer single = offer;
+                    single.months = months;
+                    single.annualRate = rate;
+                    single.downPayment = down;
+                    AnnuityTerms annuity = annuityTerms(months, rate);
+                    double financed = std::max(0.0, price - down);
+                    double owedAtEnd = std::min(financeFinalShare(single, kind) * price, financed);
+                    double payment = (financed - owedAtEnd * annuity.discount) * annuity.factor;
+                    maxDifference = std::max(maxDifference, std::abs(payment - grid[cell]));
+                    if (cell % 4999 == 0) {
+                        maxDifference = std::max(maxDifference,
+                                                 std::abs(planFinancing(price, single, kind).monthlyPayment - grid[cell]));
+                    }
+                    ++cell;
+                }
+            }
+        }
+        double singleMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << std::left << std::setw(8) << financeKindName(financeKind) << std::right << grid.size()
+                  << " offers: grid " << std::fixed << std::setprecision(2) << gridMs << " ms ("
+                  << std::setprecision(1) << gridMs * 1e6 / grid.size() << " ns/offer), one by one "
+                  << std::setprecision(2) << singleMs << " ms, max difference " << std::setprecision(6)
+                  << maxDifference << std::endl;
+    }
+
+    SimulationRandom random(48);
+    std::vector<double> prices(configurationCount);
+    std::vector<double> residuals(configurationCount);
+    FinanceOffer lease;
+    lease.kind = FinanceKind::LEASE;
+    lease.months = 36;
+    lease.annualRate = 3.9;
+    for (size_t i = 0; i < configurationCount; ++i) {
+        const VehicleRecord& vehicle = catalog.vehicles[random.next() % catalog.vehicles.size()];
+        prices[i] = vehicle.basePrice + catalog.engines[random.next() % catalog.engines.size()].price +
+                    (random.next() % 20) * 1000.0;
+        residuals[i] = financeFinalShare(lease, vehicle.kind);
+    }
+    std::vector<double> payments(configurationCount);
+    auto start = std::chrono::steady_clock::now();
+    financeAcrossPrices(prices, residuals, 0.1, lease.months, lease.annualRate, payments);
+    double acrossMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    double maxDifference = 0.0;
+    for (size_t i = 0; i < configurationCount; i += 9973) {
+        lease.downPayment = prices[i] * 0.1;
+        lease.kind = FinanceKind::BALLOON;
+        lease.balloonPercent = residuals[i] * 100.0;
+        maxDifference = std::max(maxDifference, std::abs(planFinancing(prices[i], lease, kind).monthlyPayment - payments[i]));
+        lease.kind = FinanceKind::LEASE;
+    }
+    std::cout << "Lease across " << configurationCount << " configurations: " << std::fixed << std::setprecision(2)
+              << acrossMs << " ms (" << std::setprecision(2) << acrossMs * 1e6 / std::max<size_t>(1, configurationCount)
+              << " ns/configuration), max difference " << std::setprecision(6) << maxDifference << std::endl;
+}
+
+// Reserve/commit/release storm from many threads on a few scarce SKUs and a long tail of plentiful
+// ones, with short holds left to expire and occasional deliveries; afterwards stock must add up
+void runInventoryBenchmark(size_t threadCount, size_t operationsPerThread) {
+    constexpr size_t SKU_COUNT = 1000;
+    constexpr size_t HOT_SKUS = 8;
+    std::vector<std::pair<std::string, int64_t>> stock;
+    for (size_t i = 0; i < SKU_COUNT; ++i) stock.emplace_back("SKU-" + std::to_string(i), i < HOT_SKUS ? 20 : 1000);
+    Inventory inventory(stock, std::chrono::milliseconds(1), 4096);
+
+    std::atomic<bool> oversold{false};
+    std::vector<double> latencies;
+    std::mutex latencyMutex;
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> workers;
+        for (size_t t = 0; t < threadCount; ++t) {
+            workers.emplace_back([&, t] {
+                SimulationRandom random(100 + t);
+                uint64_t session = inventory.openSession();
+                std::vector<Inventory::ReservationId> open;
+                std::vector<double> local;
+                for (size_t n = 0; n < operationsPerThread; ++n) {
+                    uint64_t roll = random.next();
+                    bool sampled = n % 64 == 0;
+                    auto operationStart = sampled ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
+                    if (n % 1000 == 999) {
+                        inventory.restock(static_cast<uint32_t>(roll % HOT_SKUS), 5);
+                    } else if (!open.empty() && roll % 4 != 0) {
+                        // Finish the newest hold: mostly released, some sold, some abandoned to expire
+                        Inventory::ReservationId reservation = open.back();
+                        open.pop_back();
+                        if (roll % 100 < 5) {
+                            inventory.commit(reservation, session);
+                        } else if (roll % 100 < 25) {
+                            // Abandoned
+                        } else {
+                            inventory.release(reservation, session);
+                        }
+                    } else {
+                        uint32_t sku = static_cast<uint32_t>(roll % 10 < 8 ? (roll >> 8) % HOT_SKUS
+                                                                           : HOT_SKUS + (roll >> 8) % (SKU_COUNT - HOT_SKUS));
+                        auto hold = std::chrono::milliseconds(1 + (roll >> 20) % 20);
+                        Inventory::ReservationId reservation = inventory.reserve(sku, 1, session, hold);
+                        if (reservation != 0) open.push_back(reservation);
+                        if (inventory.getAvailable(sku) < 0) oversold = true;
+                    }
+
+                    if (sampled) {
+                        local.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - operationStart).count());
+                    }
+                }
+                for (Inventory::ReservationId reservation : open) inventory.release(reservation, session);
+
+                std::lock_guard<std::mutex> lock(latencyMutex);
+                latencies.insert(latencies.end(), local.begin(), local.end());
+            });
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Inventory::Stats beforeFlush = inventory.getStats();
+    inventory.expireDue(std::chrono::steady_clock::now() + std::chrono::minutes(1));
+    Inventory::Stats stats = inventory.getStats();
+
+    size_t inconsistent = 0;
+    for (uint32_t sku = 0; sku < SKU_COUNT; ++sku) {
+        bool balanced = inventory.getHeld(sku) == 0 && inventory.getAvailable(sku) >= 0 &&
+                        inventory.getAvailable(sku) + inventory.getSold(sku) == inventory.getReceived(sku);
+        inconsistent += balanced ? 0 : 1;
+    }
+
+    printHeader("Inventory benchmark: " + std::to_string(threadCount) + " threads");
+    size_t operations = threadCount * operationsPerThread;
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << operations << " operations in " << std::fixed << std::setprecision(2) << seconds << " s: "
+              << std::setprecision(0) << operations / seconds << " ops/s" << std::endl;
+    if (!latencies.empty()) {
+        std::cout << "Latency: p50 " << latencies[latencies.size() / 2] << " ns, p99 "
+                  << latencies[latencies.size() * 99 / 100] << " ns, max " << latencies.back() << " ns" << std::endl;
+    }
+    std::cout << "Holds: " << stats.reserved << " granted, " << stats.rejected << " out of stock" << std::endl;
+    std::cout << "Outcomes: " << stats.committed << " sold, " << stats.released << " released, " << stats.expired
+              << " expired (" << beforeFlush.expired << " by the timer wheel during the run)" << std::endl;
+    if (oversold || inconsistent > 0) {
+        std::cout << COLOR_RED << "✗ Stock does not add up for " << inconsistent << " SKUs"
+                  << (oversold ? ", and stock went negative" : "") << COLOR_RESET << std::endl;
+    } else {
+        std::cout << COLOR_GREEN << "✓ No oversell: available + sold matches received stock for every SKU" << COLOR_RESET
+                  << std::endl;
+    }
+}
+
+// Top-k similarity queries over synthetic configurations, checked against a plain scan
+void runSimilarityBenchmark(const CatalogView& catalog, size_t entryCount, size_t threadCount) {
+    ConfigurationFeatureEncoder encoder(catalog);
+    SimulationRandom random(13);
+    auto randomConfiguration = [&] {
+        SavedConfiguration config;
+        const VehicleRecord& vehicle = catalog.vehicles[random.next() % catalog.vehicles.size()];
+        config.brand = vehicle.brand;
+        config.model = vehicle.model;
+        config.totalPrice = vehicle.basePrice;
+        if (random.next() % 8 != 0) {
+            const EngineRecord& engine = catalog.engines[random.next() % catalog.engines.size()];
+            config.hasEngine = true;
+            config.horsePower = engine.horsePower;
+            config.co2Emissions = engine.co2Emissions;
+            config.totalPrice += engine.price;
+        }
+        for (const auto& item : catalog.equipment) {
+            if (random.next() % 3 == 0) {
+                config.equipment.push_back({std::string(item.name), "", item.price, static_cast<int>(item.category)});
+                config.totalPrice += item.price;
+            }
+        }
+        return encoder.encode(config);
+    };
+
+    printHeader("Similarity benchmark: " + std::to_string(entryCount) + " configurations");
+    auto start = std::chrono::steady_clock::now();
+    SimilarityIndex index(encoder.getWordCount());
+    std::vector<ConfigurationFeatures> entries;
+    entries.reserve(entryCount);
+    index.reserve(entryCount);
+    for (size_t i = 0; i < entryCount; ++i) {
+        entries.push_back(randomConfiguration());
+        index.add(entries.back());
+    }
+    std::cout << "Index built in " << std::fixed << std::setprecision(1)
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms" << std::endl;
+
+    std::vector<ConfigurationFeatures> queries;
+    for (size_t i = 0; i < 100; ++i) queries.push_back(randomConfiguration());
+
+    // Reference: the same distance computed one entry at a time, without the blocked kernel
+    SimilarityWeights weights;
+    auto plainDistance = [&](const ConfigurationFeatures& a, const ConfigurationFeatures& b) {
+        uint64_t shared = 0, either = 0;
+        for (size_t w = 0; w < encoder.getWordCount(); ++w) {
+            shared += std::popcount(a.equipment[w] & b.equipment[w]);
+            either += std::popcount(a.equipment[w] | b.equipment[w]);
+        }
+        float jaccard = either == 0 ? 1.0f : static_cast<float>(shared) / static_cast<float>(either);
+        return weights.equipment * (1.0f - jaccard) + weights.price * std::fabs(a.price - b.price) +
+               weights.horsePower * std::fabs(a.horsePower - b.horsePower) + weights.co2 * std::fabs(a.co2 - b.co2) +
+               (a.bodyType == b.bodyType ? 0.0f : weights.bodyType);
+    };
+    float best = std::numeric_limits<float>::max();
+    for (const auto& entry : entries) best = std::min(best, plainDistance(queries.front(), entry));
+    float indexed = index.nearest(queries.front(), 1).front().distance;
+    if (std::fabs(best - indexed) > 1e-5f) {
+        std::cout << COLOR_RED << "✗ Nearest distance " << indexed << " differs from plain scan " << best
+                  << COLOR_RESET << std::endl;
+    } else {
+        std::cout << COLOR_GREEN << "✓ Nearest neighbor matches a plain scan" << COLOR_RESET << std::endl;
+    }
+
+    ThreadPool pool(threadCount);
+    auto measure = [&](const std::string& label, ThreadPool* queryPool) {
+        std::vector<double> latencies;
+        for (const auto& query : queries) {
+            auto start = std::chrono::steady_clock::now();
+            index.nearest(query, 10, queryPool);
+            latencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        double mean = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+        std::cout << std::left << std::setw(18) << label << std::right << std::fixed << std::setprecision(2)
+                  << "top-10 mean " << mean << " ms, p99 " << latencies[latencies.size() * 99 / 100] << " ms ("
+                  << std::setprecision(0) << entryCount / mean / 1000 << "M configurations/s)" << std::endl;
+    };
+    measure("1 thread", nullptr);
+    if (pool.size() > 1) measure(std::to_string(pool.size()) + " threads", &pool);
+}
+
+// Aggregates over a set of saved configurations. Each worker fills its own partial, and the
+// partials are merged once at the end, so the scan itself takes no locks.
+struct ConfigurationAnalytics {
+    struct BrandStats {
+        size_t configurations = 0;
+        double discountSum = 0.0;
+        double revenue = 0.0;
+    };
+
+    size_t configurations = 0;
+    size_t unreadable = 0;
+    double revenue = 0.0; // Sum of TOTAL_PRICE
+    std::unordered_map<std::string, size_t> equipmentAttached;
+    std::unordered_map<std::string, BrandStats> brands;
+    std::array<double, EQUIPMENT_CATEGORY_COUNT> categoryRevenue{}; // Item list prices
+    std::array<size_t, EQUIPMENT_CATEGORY_COUNT> categoryItems{};
+
+    void add(const SavedConfiguration& config) {
+        ++configurations;
+        revenue += config.totalPrice;
+
+        BrandStats& brand = brands[config.brand];
+        ++brand.configurations;
+        brand.discountSum += config.discount;
+        brand.revenue += config.totalPrice;
+
+        for (const auto& item : config.equipment) {
+            auto it = equipmentAttached.find(item.name);
+            if (it == equipmentAttached.end()) {
+                equipmentAttached.emplace(item.name, 1);
+            } else {
+                ++it->second;
+            }
+            if (item.category >= 0 && static_cast<size_t>(item.category) < EQUIPMENT_CATEGORY_COUNT) {
+                categoryRevenue[item.category] += item.price;
+                ++categoryItems[item.category];
+            }
+        }
+    }
+
+    void merge(const ConfigurationAnalytics& other) {
+        configurations += other.configurations;
+        unreadable += other.unreadable;
+        revenue += other.revenue;
+        for (const auto& [name, count] : other.equipmentAttached) equipmentAttached[name] += count;
+        for (const auto& [name, stats] : other.brands) {
+            BrandStats& brand = brands[name];
+            brand.configurations += stats.configurations;
+            brand.discountSum += stats.discountSum;
+            brand.revenue += stats.revenue;
+        }
+        for (size_t c = 0; c < EQUIPMENT_CATEGORY_COUNT; ++c) {
+            categoryRevenue[c] += other.categoryRevenue[c];
+            categoryItems[c] += other.categoryItems[c];
+        }
+    }
+};
+
+// Map-reduce over saved configuration files: workers claim batches of files from a shared counter
+// (so slow files do not hold up a fixed share), parse them into a reused record and aggregate locally
+ConfigurationAnalytics analyzeSavedConfigurations(const std::vector<std::filesystem::path>& files, size_t threadCount) {
+    constexpr size_t BATCH = 256;
+    size_t workers = std::clamp<size_t>((files.size() + BATCH - 1) / BATCH, 1, threadCount);
+    std::vector<ConfigurationAnalytics> partials(workers);
+    std::atomic<size_t> nextFile{0};
+
+    ThreadPool pool(workers);
+    for (size_t worker = 0; worker < workers; ++worker) {
+        pool.submit([&files, &partials, &nextFile, worker] {
+            ConfigurationAnalytics& partial = partials[worker];
+            std::string buffer;
+            std::string error;
+            while (true) {
+                size_t begin = nextFile.fetch_add(BATCH);
+                if (begin >= files.size()) break;
+                size_t end = std::min(files.size(), begin + BATCH);
+                for (size_t i = begin; i < end; ++i) {
+                    SavedConfiguration config;
+                    if (readFileInto(files[i], buffer) && parseSavedConfiguration(buffer, config, error)) {
+                        partial.add(config);
+                    } else {
+                        ++partial.unreadable;
+                    }
+                }
+            }
+        });
+    }
+    pool.wait();
+
+    for (size_t worker = 1; worker < workers; ++worker) {
+        partials[0].merge(partials[worker]);
+    }
+    return std::move(partials[0]);
+}
+
+// Attach rates, discount and revenue per brand, and revenue mix by equipment category
+void runConfigurationAnalytics(const std::string& directory, size_t threadCount, size_t topEquipment) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::filesystem::path> files = listSavedConfigurations(directory);
+    ConfigurationAnalytics analytics = analyzeSavedConfigurations(files, threadCount);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printHeader("Configuration analytics: " + std::to_string(analytics.configurations) + " configurations");
+    if (analytics.unreadable > 0) {
+        std::cout << COLOR_YELLOW << "! Skipped " << analytics.unreadable << " unreadable files" << COLOR_RESET << std::endl;
+    }
+    if (analytics.configurations == 0) return;
+    double count = static_cast<double>(analytics.configurations);
+
+    std::vector<std::pair<std::string, size_t>> equipment(analytics.equipmentAttached.begin(), analytics.equipmentAttached.end());
+    std::sort(equipment.begin(), equipment.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    std::cout << COLOR_YELLOW << "\nMost attached equipment:" << COLOR_RESET << std::endl;
+    for (size_t i = 0; i < std::min(topEquipment, equipment.size()); ++i) {
+        std::cout << "  " << std::left << std::setw(30) << equipment[i].first << std::right << std::setw(10)
+                  << equipment[i].second << "  " << std::fixed << std::setprecision(1)
+                  << equipment[i].second * 100.0 / count << "%" << std::endl;
+    }
+
+    std::vector<std::pair<std::string, ConfigurationAnalytics::BrandStats>> brands(analytics.brands.begin(), analytics.brands.end());
+    std::sort(brands.begin(), brands.end(), [](const auto& a, const auto& b) { return a.second.revenue > b.second.revenue; });
+    std::cout << COLOR_YELLOW << "\nBrands:" << COLOR_RESET << std::endl;
+    std::cout << "  " << std::left << std::setw(20) << "Brand" << std::right << std::setw(14) << "Configurations"
+              << std::setw(14) << "Avg discount" << std::setw(24) << "Revenue" << std::endl;
+    for (const auto& [name, stats] : brands) {
+        std::cout << "  " << std::left << std::setw(20) << name << std::right << std::setw(14) << stats.configurations
+                  << std::setw(13) << std::fixed << std::setprecision(2) << stats.discountSum / stats.configurations
+                  << "%" << std::setw(24) << formatPrice(stats.revenue) << std::endl;
+    }
+
+    double equipmentRevenue = std::accumulate(analytics.categoryRevenue.begin(), analytics.categoryRevenue.end(), 0.0);
+    std::cout << COLOR_YELLOW << "\nEquipment revenue by category (list prices):" << COLOR_RESET << std::endl;
+    for (size_t c = 0; c < EQUIPMENT_CATEGORY_COUNT; ++c) {
+        double share = equipmentRevenue > 0 ? analytics.categoryRevenue[c] * 100.0 / equipmentRevenue : 0.0;
+        std::cout << "  " << std::left << std::setw(20) << categoryToString(static_cast<EquipmentCategory>(c))
+                  << std::right << std::setw(10) << analytics.categoryItems[c] << " items" << std::setw(24)
+                  << formatPrice(analytics.categoryRevenue[c]) << std::setw(8) << std::fixed << std::setprecision(1)
+                  << share << "%" << std::endl;
+    }
+
+    std::cout << "\nTotal revenue: " << COLOR_GREEN << formatPrice(analytics.revenue) << COLOR_RESET
+              << ", average " << formatPrice(analytics.revenue / count) << std::endl;
+    std::cout << "Analyzed in " << std::fixed << std::setprecision(2) << seconds << " s ("
+              << std::setprecision(0) << count / seconds << " configurations/s)" << std::endl;
+}
+
+// Columnar export of saved configurations. Layout:
+//   magic | blocks of column chunks | footer | footer offset | magic
+// Every block holds up to BLOCK_ROWS rows and stores each column as one contiguous, 8-byte aligned
+// chunk. Text columns are dictionary ids, equipment is a bitmap of dictionary bits (as many words
+// per row as the dictionary needed when the block was written), prices are cents and discounts
+// hundredths of a percent. The footer holds the dictionaries and, per block, each
+// column's offset and min/max plus the union of the equipment bits, so readers can skip blocks.
+enum class ConfigurationColumn : uint8_t {
+    BRAND, MODEL, ENGINE, COLOR, EQUIPMENT, BASE_PRICE, ENGINE_PRICE, DISCOUNT, TOTAL_PRICE
+};
+
+constexpr size_t CONFIGURATION_COLUMN_COUNT = static_cast<size_t>(ConfigurationColumn::TOTAL_PRICE) + 1;
+constexpr size_t DICTIONARY_COLUMN_COUNT = static_cast<size_t>(ConfigurationColumn::COLOR) + 1;
+constexpr char COLUMNAR_MAGIC[8] = {'V', 'C', 'F', 'G', 'C', 'O', 'L', '1'};
+constexpr uint32_t COLUMNAR_VERSION = 1;
+constexpr uint32_t NO_ENGINE_ID = 0xFFFFFFFF;
+
+// Values of a block, one vector per column; equipment has wordCount words per row
+struct ConfigurationBlock {
+    size_t rows = 0;
+    size_t wordCount = 1;
+    std::array<std::vector<uint32_t>, DICTIONARY_COLUMN_COUNT> ids;
+    std::vector<uint64_t> equipment;
+    std::vector<int64_t> basePrice;
+    std::vector<int64_t> enginePrice;
+    std::vector<int32_t> discount;
+    std::vector<int64_t> totalPrice;
+
+    void clear() {
+        rows = 0;
+        for (auto& column : ids) column.clear();
+        equipment.clear();
+        basePrice.clear();
+        enginePrice.clear();
+        discount.clear();
+        totalPrice.clear();
+    }
+};
+
+struct ColumnStats {
+    uint64_t offset = 0;
+    int64_t min = 0;
+    int64_t max = 0;
+};
+
+struct BlockDirectory {
+    uint32_t rows = 0;
+    uint32_t wordCount = 1;
+    std::vector<uint64_t> equipmentAny; // Union of the rows' equipment bits, wordCount words
+    std::array<ColumnStats, CONFIGURATION_COLUMN_COUNT> columns{};
+};
+
+inline int64_t toFixedPoint(double value, double scale) {
+    return static_cast<int64_t>(std::llround(value * scale));
+}
+
+template <typename T>
+void writeBinary(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readBinary(std::string_view data, size_t& position, T& value) {
+    if (position > data.size() || data.size() - position < sizeof(T)) return false;
+    std::memcpy(&value, data.data() + position, sizeof(T));
+    position += sizeof(T);
+    return true;
+}
+
+class ColumnarWriter {
+public:
+    static constexpr size_t BLOCK_ROWS = 16384;
+
+private:
+    struct Dictionary {
+        std::unordered_map<std::string, uint32_t> ids;
+        std::vector<std::string> values;
+
+        uint32_t intern(const std::string& value) {
+            auto [it, inserted] = ids.emplace(value, static_cast<uint32_t>(values.size()));
+            if (inserted) values.push_back(value);
+            return it->second;
+        }
+    };
+
+    std::ofstream out;
+    std::array<Dictionary, DICTIONARY_COLUMN_COUNT> dictionaries;
+    Dictionary equipmentNames;
+    std::vector<int32_t> equipmentCategories;
+    std::vector<BlockDirectory> directory;
+    ConfigurationBlock block;
+    // Equipment ids of the block's rows, turned into bitmaps as wide as the dictionary when the block is written
+    std::vector<uint32_t> equipmentIds;
+    std::vector<size_t> equipmentRowEnds;
+    std::vector<uint64_t> packedEquipment;
+    uint64_t rowCount = 0;
+
+    template <typename T>
+    void writeColumn(BlockDirectory& entry, ConfigurationColumn column, const std::vector<T>& values, bool stats) {
+        // Chunks start on 8-byte boundaries so readers can copy them straight into typed arrays
+        while (out.tellp() % 8 != 0) out.put('\0');
+        ColumnStats& columnStats = entry.columns[static_cast<size_t>(column)];
+        columnStats.offset = static_cast<uint64_t>(out.tellp());
+        if (stats && !values.empty()) {
+            auto [min, max] = std::minmax_element(values.begin(), values.end());
+            columnStats.min = static_cast<int64_t>(*min);
+            columnStats.max = static_cast<int64_t>(*max);
+        }
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    void flushBlock() {
+        if (block.rows == 0) return;
+        BlockDirectory entry;
+        entry.rows = static_cast<uint32_t>(block.rows);
+        entry.wordCount = static_cast<uint32_t>(std::max<size_t>(1, (equipmentNames.values.size() + 63) / 64));
+        for (size_t c = 0; c < DICTIONARY_COLUMN_COUNT; ++c) {
+            writeColumn(entry, static_cast<ConfigurationColumn>(c), block.ids[c], true);
+        }
+        packedEquipment.assign(block.rows * entry.wordCount, 0);
+        entry.equipmentAny.assign(entry.wordCount, 0);
+        size_t begin = 0;
+        for (size_t row = 0; row < block.rows; ++row) {
+            for (size_t i = begin; i < equipmentRowEnds[row]; ++i) {
+                uint32_t bit = equipmentIds[i];
+                packedEquipment[row * entry.wordCount + bit / 64] |= uint64_t{1} << (bit % 64);
+                entry.equipmentAny[bit / 64] |= uint64_t{1} << (bit % 64);
+            }
+            begin = equipmentRowEnds[row];
+        }
+        equipmentIds.clear();
+        equipmentRowEnds.clear();
+        writeColumn(entry, ConfigurationColumn::EQUIPMENT, packedEquipment, false);
+        writeColumn(entry, ConfigurationColumn::BASE_PRICE, block.basePrice, true);
+        writeColumn(entry, ConfigurationColumn::ENGINE_PRICE, block.enginePrice, true);
+        writeColumn(entry, ConfigurationColumn::DISCOUNT, block.discount, true);
+        writeColumn(entry, ConfigurationColumn::TOTAL_PRICE, block.totalPrice, true);
+        directory.push_back(entry);
+        block.clear();
+    }
+
+public:
+    explicit ColumnarWriter(const std::string& path) : out(path, std::ios::binary) {
+        out.write(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+    }
+
+    bool isOpen() const { return out.is_open(); }
+    uint64_t getRowCount() const { return rowCount; }
+    size_t getBlockCount() const { return directory.size(); }
+
+    void append(const SavedConfiguration& config) {
+        block.ids[static_cast<size_t>(ConfigurationColumn::BRAND)].push_back(dictionaries[0].intern(config.brand));
+        block.ids[static_cast<size_t>(ConfigurationColumn::MODEL)].push_back(dictionaries[1].intern(config.model));
+        block.ids[static_cast<size_t>(ConfigurationColumn::ENGINE)].push_back(
+            config.hasEngine ? dictionaries[2].intern(config.engineName) : NO_ENGINE_ID);
+        block.ids[static_cast<size_t>(ConfigurationColumn::COLOR)].push_back(dictionaries[3].intern(config.color));
+
+        for (const auto& item : config.equipment) {
+            uint32_t bit = equipmentNames.intern(item.name);
+            if (bit == equipmentCategories.size()) equipmentCategories.push_back(item.category);
+            equipmentIds.push_back(bit);
+        }
+        equipmentRowEnds.push_back(equipmentIds.size());
+
+        block.basePrice.push_back(toFixedPoint(config.basePrice, 100));
+        block.enginePrice.push_back(toFixedPoint(config.hasEngine ? config.enginePrice : 0.0, 100));
+        block.discount.push_back(static_cast<int32_t>(toFixedPoint(config.discount, 100)));
+        block.totalPrice.push_back(toFixedPoint(config.totalPrice, 100));
+        ++rowCount;
+        if (++block.rows == BLOCK_ROWS) flushBlock();
+    }
+
+    bool finish() {
+        flushBlock();
+        while (out.tellp() % 8 != 0) out.put('\0');
+        uint64_t footerOffset = static_cast<uint64_t>(out.tellp());
+
+        writeBinary(out, COLUMNAR_VERSION);
+        writeBinary(out, rowCount);
+        auto writeStrings = [this](const std::vector<std::string>& values) {
+            writeBinary(out, static_cast<uint32_t>(values.size()));
+            for (const auto& value : values) {
+                writeBinary(out, static_cast<uint32_t>(value.size()));
+                out.write(value.data(), static_cast<std::streamsize>(value.size()));
+            }
+        };
+        for (const auto& dictionary : dictionaries) writeStrings(dictionary.values);
+        writeStrings(equipmentNames.values);
+        for (int32_t category : equipmentCategories) writeBinary(out, category);
+
+        writeBinary(out, static_cast<uint32_t>(directory.size()));
+        for (const auto& entry : directory) {
+            writeBinary(out, entry.rows);
+            writeBinary(out, entry.wordCount);
+            for (size_t w = 0; w < entry.wordCount; ++w) writeBinary(out, entry.equipmentAny[w]);
+            for (const auto& column : entry.columns) {
+                writeBinary(out, column.offset);
+                writeBinary(out, column.min);
+                writeBinary(out, column.max);
+            }
+        }
+        writeBinary(out, footerOffset);
+        out.write(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+        out.close();
+        return !out.fail();
+    }
+};
+
+// Conjunction of conditions: value ranges on columns and equipment that must be present
+struct ColumnPredicate {
+    struct Range {
+        ConfigurationColumn column;
+        int64_t min;
+        int64_t max;
+    };
+    std::vector<Range> ranges;
+    std::vector<uint64_t> requiredEquipment; // Bits by equipment dictionary id
+};
+
+// Reads a columnar export through a memory mapping. Blocks whose statistics rule out the predicate
+// are skipped without touching their pages; the others are copied into typed arrays.
+class ColumnarReader {
+private:
+    MappedFile file;
+    uint64_t rowCount = 0;
+    std::array<std::vector<std::string_view>, DICTIONARY_COLUMN_COUNT> dictionaries;
+    std::vector<std::string_view> equipmentNames;
+    std::vector<int32_t> equipmentCategories;
+    std::vector<BlockDirectory> directory;
+
+    static bool readStrings(std::string_view data, size_t& position, std::vector<std::string_view>& values) {
+        uint32_t count = 0;
+        if (!readBinary(data, position, count)) return false;
+        values.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t length = 0;
+            if (!readBinary(data, position, length) || data.size() - position < length) return false;
+            values.push_back(data.substr(position, length));
+            position += length;
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool copyColumn(const BlockDirectory& entry, ConfigurationColumn column, size_t valuesPerRow, std::vector<T>& values) const {
+        std::string_view data = file.contents();
+        uint64_t offset = entry.columns[static_cast<size_t>(column)].offset;
+        size_t bytes = entry.rows * valuesPerRow * sizeof(T);
+        if (offset > data.size() || data.size() - offset < bytes) return false;
+        values.resize(entry.rows * valuesPerRow);
+        std::memcpy(values.data(), data.data() + offset, bytes);
+        return true;
+    }
+
+public:
+    bool open(const std::string& path, std::string& error) {
+        if (!file.open(path)) {
+            error = "cannot open " + path;
+            return false;
+        }
+        std::string_view data = file.contents();
+        if (data.size() < 2 * sizeof(COLUMNAR_MAGIC) + sizeof(uint64_t) ||
+            data.substr(0, sizeof(COLUMNAR_MAGIC)) != std::string_view(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC)) ||
+            data.substr(data.size() - sizeof(COLUMNAR_MAGIC)) != std::string_view(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC))) {
+            error = path + " is not a columnar configuration export";
+            return false;
+        }
+
+        uint64_t footerOffset = 0;
+        size_t position = data.size() - sizeof(COLUMNAR_MAGIC) - sizeof(uint64_t);
+        readBinary(data, position, footerOffset);
+        position = footerOffset;
+
+        uint32_t version = 0;
+        bool valid = readBinary(data, position, version) && version == COLUMNAR_VERSION &&
+                     readBinary(data, position, rowCount);
+        for (auto& dictionary : dictionaries) valid = valid && readStrings(data, position, dictionary);
+        valid = valid && readStrings(data, position, equipmentNames);
+        equipmentCategories.resize(valid ? equipmentNames.size() : 0);
+        for (auto& category : equipmentCategories) valid = valid && readBinary(data, position, category);
+
+        uint32_t blockCount = 0;
+        valid = valid && readBinary(data, position, blockCount);
+        directory.assign(valid ? blockCount : 0, {});
+        for (auto& entry : directory) {
+            valid = valid && readBinary(data, position, entry.rows) && readBinary(data, position, entry.wordCount) &&
+                    entry.wordCount >= 1 && entry.wordCount <= std::max<size_t>(1, (equipmentNames.size() + 63) / 64);
+            entry.equipmentAny.resize(valid ? entry.wordCount : 0);
+            for (size_t w = 0; valid && w < entry.wordCount; ++w) valid = readBinary(data, position, entry.equipmentAny[w]);
+            for (auto& column : entry.columns) {
+                valid = valid && readBinary(data, position, column.offset) && readBinary(data, position, column.min) &&
+                        readBinary(data, position, column.max);
+            }
+        }
+        if (!valid) {
+            error = path + ": corrupt footer";
+            return false;
+        }
+        return true;
+    }
+
+    uint64_t getRowCount() const { return rowCount; }
+    size_t getBlockCount() const { return directory.size(); }
+    const std::vector<std::string_view>& dictionary(ConfigurationColumn column) const {
+        return dictionaries[static_cast<size_t>(column)];
+    }
+    const std::vector<std::string_view>& getEquipmentNames() const { return equipmentNames; }
+    const std::vector<int32_t>& getEquipmentCategories() const { return equipmentCategories; }
+
+    // Dictionary id of a value, or nothing if no row has it
+    std::optional<uint32_t> findId(ConfigurationColumn column, std::string_view value) const {
+        const auto& values = column == ConfigurationColumn::EQUIPMENT ? equipmentNames : dictionary(column);
+        auto it = std::find(values.begin(), values.end(), value);
+        if (it == values.end()) return std::nullopt;
+        return static_cast<uint32_t>(it - values.begin());
+    }
+
+    // True if the block statistics allow a matching row
+    bool mayMatch(size_t blockIndex, const ColumnPredicate& predicate) const {
+        const BlockDirectory& entry = directory[blockIndex];
+        for (const auto& range : predicate.ranges) {
+            const ColumnStats& stats = entry.columns[static_cast<size_t>(range.column)];
+            if (stats.max < range.min || stats.min > range.max) return false;
+        }
+        // Equipment first seen after the block was written lies past its width and rules it out too
+        for (size_t w = 0; w < predicate.requiredEquipment.size(); ++w) {
+            uint64_t any = w < entry.equipmentAny.size() ? entry.equipmentAny[w] : 0;
+            if ((any & predicate.requiredEquipment[w]) != predicate.requiredEquipment[w]) return false;
+        }
+        return true;
+    }
+
+    bool readBlock(size_t blockIndex, ConfigurationBlock& block) const {
+        const BlockDirectory& entry = directory[blockIndex];
+        block.rows = entry.rows;
+        block.wordCount = entry.wordCount;
+        bool ok = true;
+        for (size_t c = 0; c < DICTIONARY_COLUMN_COUNT; ++c) {
+            ok = ok && copyColumn(entry, static_cast<ConfigurationColumn>(c), 1, block.ids[c]);
+        }
+        return ok && copyColumn(entry, ConfigurationColumn::EQUIPMENT, entry.wordCount, block.equipment) &&
+               copyColumn(entry, ConfigurationColumn::BASE_PRICE, 1, block.basePrice) &&
+               copyColumn(entry, ConfigurationColumn::ENGINE_PRICE, 1, block.enginePrice) &&
+               copyColumn(entry, ConfigurationColumn::DISCOUNT, 1, block.discount) &&
+               copyColumn(entry, ConfigurationColumn::TOTAL_PRICE, 1, block.totalPrice);
+    }
+};
+
+// Converts a directory of saved configurations into one columnar file. Files are parsed in parallel
+// one block at a time, so memory stays bounded by the block size.
+void runColumnarExport(const std::string& directory, const std::string& outputPath, size_t threadCount) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::filesystem::path> files = listSavedConfigurations(directory);
+    ColumnarWriter writer(outputPath);
+    if (!writer.isOpen()) {
+        std::cout << COLOR_RED << "✗ Cannot create " << outputPath << COLOR_RESET << std::endl;
+        return;
+    }
+
+    ThreadPool pool(threadCount);
+    std::vector<SavedConfiguration> configs(ColumnarWriter::BLOCK_ROWS);
+    std::vector<char> parsed(ColumnarWriter::BLOCK_ROWS);
+    size_t unreadable = 0;
+    for (size_t begin = 0; begin < files.size(); begin += ColumnarWriter::BLOCK_ROWS) {
+        size_t count = std::min(ColumnarWriter::BLOCK_ROWS, files.size() - begin);
+        size_t perTask = (count + pool.size() - 1) / pool.size();
+        for (size_t first = 0; first < count; first += perTask) {
+            size_t last = std::min(count, first + perTask);
+            pool.submit([&, first, last] {
+                std::string buffer;
+                std::string error;
+                for (size_t i = first; i < last; ++i) {
+                    configs[i] = SavedConfiguration{};
+                    parsed[i] = readFileInto(files[begin + i], buffer) && parseSavedConfiguration(buffer, configs[i], error);
                 }
-                break;
+            });
+        }
+        pool.wait();
+        for (size_t i = 0; i < count; ++i) {
+            if (parsed[i]) {
+                writer.append(configs[i]);
+            } else {
+                ++unreadable;
             }
-            case 7: {
-                configurator.displayCurrentConfiguration();
-                break;
+        }
+    }
+
+    if (!writer.finish()) {
+        std::cout << COLOR_RED << "✗ Failed to write " << outputPath << COLOR_RESET << std::endl;
+        return;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::error_code ec;
+    auto bytes = std::filesystem::file_size(outputPath, ec);
+    std::cout << COLOR_GREEN << "✓ Exported " << writer.getRowCount() << " configurations in " << writer.getBlockCount()
+              << " blocks to " << outputPath << " (" << std::fixed << std::setprecision(1)
+              << (ec ? 0.0 : bytes / 1024.0) << " KB) in " << std::setprecision(2) << seconds << " s" << COLOR_RESET << std::endl;
+    if (unreadable > 0) {
+        std::cout << COLOR_YELLOW << "! Skipped " << unreadable << " unreadable files" << COLOR_RESET << std::endl;
+    }
+}
+
+// Scans a columnar export with filters such as brand=Audi, equipment=Heated seats, min-total=100000 or
+// max-discount=5, and reports the matching rows. Blocks are ruled out from their statistics first;
+// surviving blocks are filtered with a branch-free pass per column.
+void runColumnarScan(const std::string& path, const std::vector<std::string>& filters) {
+    ColumnarReader reader;
+    std::string error;
+    if (!reader.open(path, error)) {
+        std::cout << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+        return;
+    }
+
+    ColumnPredicate predicate;
+    bool impossible = false;
+    for (const auto& filter : filters) {
+        size_t separator = filter.find('=');
+        std::string_view key = std::string_view(filter).substr(0, separator);
+        std::string_view value = separator == std::string::npos ? std::string_view() : std::string_view(filter).substr(separator + 1);
+        double number = 0.0;
+        static const std::pair<std::string_view, ConfigurationColumn> textColumns[] = {
+            {"brand", ConfigurationColumn::BRAND}, {"model", ConfigurationColumn::MODEL},
+            {"engine", ConfigurationColumn::ENGINE}, {"color", ConfigurationColumn::COLOR}};
+        auto text = std::find_if(std::begin(textColumns), std::end(textColumns), [key](const auto& entry) { return entry.first == key; });
+
+        if (text != std::end(textColumns)) {
+            auto id = reader.findId(text->second, value);
+            impossible = impossible || !id;
+            if (id) predicate.ranges.push_back({text->second, *id, *id});
+        } else if (key == "equipment") {
+            auto bit = reader.findId(ConfigurationColumn::EQUIPMENT, value);
+            impossible = impossible || !bit;
+            if (bit) {
+                predicate.requiredEquipment.resize(std::max<size_t>(predicate.requiredEquipment.size(), *bit / 64 + 1));
+                predicate.requiredEquipment[*bit / 64] |= uint64_t{1} << (*bit % 64);
             }
-            case 8: {
-                configurator.visualizeCurrentConfiguration();
-                break;
+        } else if ((key == "min-total" || key == "max-total" || key == "min-discount" || key == "max-discount") &&
+                   parseNumber(value, number)) {
+            ConfigurationColumn column = key.ends_with("total") ? ConfigurationColumn::TOTAL_PRICE : ConfigurationColumn::DISCOUNT;
+            int64_t bound = toFixedPoint(number, 100);
+            bool lower = key.starts_with("min");
+            predicate.ranges.push_back({column, lower ? bound : std::numeric_limits<int64_t>::min(),
+                                        lower ? std::numeric_limits<int64_t>::max() : bound});
+        } else {
+            std::cout << COLOR_RED << "✗ Unknown filter: " << filter << COLOR_RESET << std::endl;
+            return;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    ConfigurationBlock block;
+    std::vector<uint8_t> matches;
+    size_t blocksRead = 0;
+    uint64_t matched = 0;
+    int64_t totalCents = 0;
+    int64_t discountSum = 0;
+    std::vector<uint64_t> equipmentCounts(reader.getEquipmentNames().size());
+
+    for (size_t b = 0; b < reader.getBlockCount() && !impossible; ++b) {
+        if (!reader.mayMatch(b, predicate)) continue;
+        if (!reader.readBlock(b, block)) {
+            std::cout << COLOR_RED << "✗ Block " << b << " is truncated" << COLOR_RESET << std::endl;
+            return;
+        }
+        ++blocksRead;
+
+        matches.assign(block.rows, 1);
+        for (const auto& range : predicate.ranges) {
+            auto apply = [&matches, &range](const auto& values) {
+                for (size_t i = 0; i < matches.size(); ++i) {
+                    matches[i] &= static_cast<uint8_t>(values[i] >= range.min) & static_cast<uint8_t>(values[i] <= range.max);
+                }
+            };
+            if (range.column == ConfigurationColumn::TOTAL_PRICE) apply(block.totalPrice);
+            else if (range.column == ConfigurationColumn::DISCOUNT) apply(block.discount);
+            else apply(block.ids[static_cast<size_t>(range.column)]);
+        }
+        for (size_t w = 0; w < block.wordCount && w < predicate.requiredEquipment.size(); ++w) {
+            uint64_t required = predicate.requiredEquipment[w];
+            if (required == 0) continue;
+            for (size_t i = 0; i < block.rows; ++i) {
+                matches[i] &= static_cast<uint8_t>((block.equipment[i * block.wordCount + w] & required) == required);
+            }
+        }
+
+        for (size_t i = 0; i < block.rows; ++i) {
+            int64_t take = matches[i];
+            matched += take;
+            totalCents += take * block.totalPrice[i];
+            discountSum += take * block.discount[i];
+        }
+        for (size_t i = 0; i < block.rows; ++i) {
+            if (!matches[i]) continue;
+            for (size_t w = 0; w < block.wordCount; ++w) {
+                for (uint64_t bits = block.equipment[i * block.wordCount + w]; bits != 0; bits &= bits - 1) {
+                    size_t bit = w * 64 + std::countr_zero(bits);
+                    if (bit < equipmentCounts.size()) ++equipmentCounts[bit];
+                }
+            }
+        }
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    printHeader("Columnar scan: " + std::to_string(matched) + " of " + std::to_string(reader.getRowCount()) + " rows");
+    std::cout << "Blocks read: " << blocksRead << " of " << reader.getBlockCount() << " ("
+              << reader.getBlockCount() - blocksRead << " skipped from statistics) in " << std::fixed
+              << std::setprecision(2) << ms << " ms" << std::endl;
+    if (matched == 0) return;
+    std::cout << "Revenue: " << COLOR_GREEN << formatPrice(totalCents / 100.0) << COLOR_RESET << ", average "
+              << formatPrice(totalCents / 100.0 / matched) << ", average discount " << std::fixed << std::setprecision(2)
+              << discountSum / 100.0 / matched << "%" << std::endl;
+    std::cout << COLOR_YELLOW << "\nEquipment attach rate:" << COLOR_RESET << std::endl;
+    for (size_t bit = 0; bit < equipmentCounts.size(); ++bit) {
+        std::cout << "  " << std::left << std::setw(30) << reader.getEquipmentNames()[bit] << std::right << std::setw(10)
+                  << equipmentCounts[bit] << "  " << std::fixed << std::setprecision(1)
+                  << equipmentCounts[bit] * 100.0 / matched << "%" << std::endl;
+    }
+}
+
+// Calendar day as days since 1970-01-01, from text starting with YYYY-MM-DD (a saved DATE line works)
+bool parseDay(std::string_view text, int32_t& day) {
+    int year = 0;
+    unsigned month = 0;
+    unsigned dayOfMonth = 0;
+    if (text.size() < 10 || text[4] != '-' || text[7] != '-' || !parseNumber(text.substr(0, 4), year) ||
+        !parseNumber(text.substr(5, 2), month) || !parseNumber(text.substr(8, 2), dayOfMonth)) {
+        return false;
+    }
+    std::chrono::year_month_day date{std::chrono::year(year), std::chrono::month(month), std::chrono::day(dayOfMonth)};
+    if (!date.ok()) return false;
+    day = static_cast<int32_t>(std::chrono::sys_days(date).time_since_epoch().count());
+    return true;
+}
+
+std::string formatDay(int32_t day) {
+    std::chrono::year_month_day date{std::chrono::sys_days(std::chrono::days(day))};
+    char text[16];
+    std::snprintf(text, sizeof(text), "%04d-%02u-%02u", static_cast<int>(date.year()),
+                  static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()));
+    return text;
+}
+
+enum class PricedKind : uint8_t {
+    VEHICLE,
+    ENGINE,
+    EQUIPMENT
+};
+
+constexpr char PRICE_HISTORY_MAGIC[8] = {'V', 'C', 'F', 'G', 'H', 'I', 'S', '1'};
+
+// Catalog prices over time. A version records the day it took effect and only the prices that
+// changed since the version before; an item that left the catalog changes to NOT_PRICED. In memory
+// the versions are expanded into a dense table with one row of prices per version, and every day
+// from the first version on maps to the version in effect, so a price as of any day is two array
+// reads - as cheap as a current price. The table takes versions x items prices; the file keeps
+// only the changes.
+class PriceHistory {
+public:
+    static constexpr int64_t NOT_PRICED = -1;
+
+    struct Change {
+        uint32_t item;
+        int64_t cents;
+    };
+
+    struct Version {
+        int32_t day;
+        std::vector<Change> changes;
+    };
+
+private:
+    struct Item {
+        PricedKind kind;
+        std::string name; // "Brand Model" for vehicles
+    };
+
+    std::vector<Item> items;
+    std::array<std::unordered_map<std::string, uint32_t>, 3> itemIds; // Per kind
+    std::vector<Version> versions;
+    std::vector<int64_t> latest; // Price of every item after the last version
+
+    // Row v holds the price of every item in version v; dayVersions[d] is the version in effect
+    // firstDay + d days in, up to the last version's day
+    std::vector<int64_t> priceTable;
+    size_t tableWidth = 0;
+    int32_t firstDay = 0;
+    std::vector<uint32_t> dayVersions;
+
+    uint32_t itemId(PricedKind kind, const std::string& name) {
+        auto [it, added] = itemIds[static_cast<size_t>(kind)].emplace(name, static_cast<uint32_t>(items.size()));
+        if (added) {
+            items.push_back({kind, name});
+            latest.push_back(NOT_PRICED);
+        }
+        return it->second;
+    }
+
+    // Appends the row and the days of version v, which must be the newest one indexed
+    void indexVersion(size_t v) {
+        const Version& version = versions[v];
+        size_t row = priceTable.size();
+        priceTable.resize(row + tableWidth, NOT_PRICED);
+        if (v > 0) std::copy_n(priceTable.begin() + (row - tableWidth), tableWidth, priceTable.begin() + row);
+        for (const auto& change : version.changes) priceTable[row + change.item] = change.cents;
+
+        if (v == 0) firstDay = version.day;
+        size_t offset = static_cast<size_t>(version.day - firstDay);
+        if (offset < dayVersions.size()) {
+            dayVersions[offset] = static_cast<uint32_t>(v); // A correction on the same day
+        } else {
+            dayVersions.resize(offset, dayVersions.empty() ? 0 : dayVersions.back());
+            dayVersions.push_back(static_cast<uint32_t>(v));
+        }
+    }
+
+    // Lays the table out again for the current item count
+    void buildIndex() {
+        tableWidth = items.size();
+        priceTable.clear();
+        priceTable.reserve(versions.size() * tableWidth);
+        dayVersions.clear();
+        for (size_t v = 0; v < versions.size(); ++v) indexVersion(v);
+    }
+
+public:
+    size_t getItemCount() const { return items.size(); }
+    const std::vector<Version>& getVersions() const { return versions; }
+    const std::string& getItemName(uint32_t item) const { return items[item].name; }
+
+    std::optional<uint32_t> findItem(PricedKind kind, const std::string& name) const {
+        const auto& ids = itemIds[static_cast<size_t>(kind)];
+        auto it = ids.find(name);
+        if (it == ids.end()) return std::nullopt;
+        return it->second;
+    }
+
+    // Records the catalog's prices as in effect from day on; returns the number of changes stored.
+    // A version on the same day as the last one corrects it for that day.
+    std::optional<size_t> addVersion(int32_t day, const CatalogView& catalog, std::string& error) {
+        if (!versions.empty() && day < versions.back().day) {
+            error = "history already has a version from " + formatDay(versions.back().day);
+            return std::nullopt;
+        }
+
+        std::vector<int64_t> current(items.size(), NOT_PRICED);
+        auto set = [this, &current](PricedKind kind, const std::string& name, double price) {
+            uint32_t id = itemId(kind, name);
+            if (id >= current.size()) current.resize(id + 1, NOT_PRICED);
+            current[id] = toFixedPoint(price, 100.0);
+        };
+        for (const auto& vehicle : catalog.vehicles) {
+            set(PricedKind::VEHICLE, std::string(vehicle.brand) + " " + std::string(vehicle.model), vehicle.basePrice);
+        }
+        for (const auto& engine : catalog.engines) set(PricedKind::ENGINE, std::string(engine.name), engine.price);
+        for (const auto& equipment : catalog.equipment) {
+            set(PricedKind::EQUIPMENT, std::string(equipment.name), equipment.price);
+        }
+
+        Version version{day, {}};
+        for (uint32_t id = 0; id < items.size(); ++id) {
+            if (current[id] != latest[id]) {
+                version.changes.push_back({id, current[id]});
+                latest[id] = current[id];
+            }
+        }
+        size_t changeCount = version.changes.size();
+        versions.push_back(std::move(version));
+        // Rows only need laying out again when the version brought new items
+        if (items.size() == tableWidth) {
+            indexVersion(versions.size() - 1);
+        } else {
+            buildIndex();
+        }
+        return changeCount;
+    }
+
+    // Price in cents in effect on day, or NOT_PRICED
+    int64_t priceAsOf(uint32_t item, int32_t day) const {
+        if (dayVersions.empty() || day < firstDay) return NOT_PRICED;
+        size_t offset = std::min(static_cast<size_t>(day - firstDay), dayVersions.size() - 1);
+        return priceTable[dayVersions[offset] * tableWidth + item];
+    }
+
+    // Every price change of an item, oldest first
+    std::vector<std::pair<int32_t, int64_t>> timeline(uint32_t item) const {
+        std::vector<std::pair<int32_t, int64_t>> changes;
+        for (const auto& version : versions) {
+            for (const auto& change : version.changes) {
+                if (change.item == item) changes.emplace_back(version.day, change.cents);
+            }
+        }
+        return changes;
+    }
+
+    bool save(const std::string& path, std::string& error) const {
+        std::ostringstream out;
+        out.write(PRICE_HISTORY_MAGIC, sizeof(PRICE_HISTORY_MAGIC));
+        writeBinary(out, static_cast<uint32_t>(items.size()));
+        for (const auto& item : items) {
+            writeBinary(out, item.kind);
+            writeBinary(out, static_cast<uint32_t>(item.name.size()));
+            out.write(item.name.data(), static_cast<std::streamsize>(item.name.size()));
+        }
+        writeBinary(out, static_cast<uint32_t>(versions.size()));
+        for (const auto& version : versions) {
+            writeBinary(out, version.day);
+            writeBinary(out, static_cast<uint32_t>(version.changes.size()));
+            for (const auto& change : version.changes) {
+                writeBinary(out, change.item);
+                writeBinary(out, change.cents);
+            }
+        }
+        return writeFileAtomically(path, out.str(), error);
+    }
+
+    bool load(const std::string& path, std::string& error) {
+        std::string data;
+        if (!readFileInto(path, data)) {
+            error = "cannot read price history " + path;
+            return false;
+        }
+        *this = PriceHistory{};
+        size_t position = sizeof(PRICE_HISTORY_MAGIC);
+        uint32_t itemCount = 0;
+        bool valid = data.compare(0, sizeof(PRICE_HISTORY_MAGIC), PRICE_HISTORY_MAGIC, sizeof(PRICE_HISTORY_MAGIC)) == 0 &&
+                     readBinary(data, position, itemCount);
+        for (uint32_t i = 0; valid && i < itemCount; ++i) {
+            PricedKind kind;
+            uint32_t length = 0;
+            valid = readBinary(data, position, kind) && static_cast<size_t>(kind) < itemIds.size() &&
+                    readBinary(data, position, length) && data.size() - position >= length;
+            if (valid) {
+                itemId(kind, data.substr(position, length));
+                position += length;
+            }
+        }
+        valid = valid && items.size() == itemCount;
+
+        uint32_t versionCount = 0;
+        valid = valid && readBinary(data, position, versionCount);
+        for (uint32_t v = 0; valid && v < versionCount; ++v) {
+            Version version;
+            uint32_t changeCount = 0;
+            valid = readBinary(data, position, version.day) && readBinary(data, position, changeCount) &&
+                    (versions.empty() || version.day >= versions.back().day) &&
+                    (data.size() - position) / (sizeof(uint32_t) + sizeof(int64_t)) >= changeCount;
+            version.changes.resize(valid ? changeCount : 0);
+            for (auto& change : version.changes) {
+                valid = valid && readBinary(data, position, change.item) && change.item < items.size() &&
+                        readBinary(data, position, change.cents);
+                if (valid) latest[change.item] = change.cents;
+            }
+            versions.push_back(std::move(version));
+        }
+        if (!valid) {
+            error = path + " is not a valid price history";
+            return false;
+        }
+        buildIndex();
+        return true;
+    }
+};
+
+// Reprices a saved configuration with the prices in effect on day, the way a vehicle configured then
+// would have been priced; missing names the first item that had no price that day. The pricing
+// rules are compiled over just the configuration's equipment at that day's prices, so bundles and
+// category discounts apply as they did in the catalog.
+bool quoteAsOf(const PriceHistory& history, const SavedConfiguration& config, int32_t day, double& total,
+               std::string& missing) {
+    auto priceOf = [&](PricedKind kind, const std::string& name, int64_t& cents) {
+        auto item = history.findItem(kind, name);
+        cents = item ? history.priceAsOf(*item, day) : PriceHistory::NOT_PRICED;
+        if (cents == PriceHistory::NOT_PRICED) {
+            missing = name;
+            return false;
+        }
+        return true;
+    };
+    int64_t vehicleCents = 0;
+    int64_t engineCents = 0;
+    if (!priceOf(PricedKind::VEHICLE, config.brand + " " + config.model, vehicleCents)) return false;
+    if (config.hasEngine && !priceOf(PricedKind::ENGINE, config.engineName, engineCents)) return false;
+
+    std::vector<EquipmentRecord> equipment;
+    for (const auto& item : config.equipment) {
+        int64_t cents = 0;
+        if (!priceOf(PricedKind::EQUIPMENT, item.name, cents)) return false;
+        equipment.push_back({item.name, item.description, cents / 100.0, static_cast<EquipmentCategory>(item.category)});
+    }
+    PricingPlan plan(CatalogView{{}, {}, equipment, {}}, 0, builtInPricingRules);
+    PricedConfiguration priced;
+    priced.basePrice = (vehicleCents + engineCents) / 100.0;
+    priced.discountPercent = config.discount;
+    for (const auto& item : equipment) plan.addEquipment(priced, item.name, item.price);
+    total = plan.evaluate(priced).unitGross;
+    return true;
+}
+
+// Adds the bound catalog to a price history file as in effect from day on, creating the file if needed
+int runHistoryAdd(const CatalogView& catalog, const std::string& path, const std::string& date) {
+    int32_t day = 0;
+    if (!parseDay(date, day)) {
+        std::cerr << COLOR_RED << "✗ Invalid date " << date << ", expected YYYY-MM-DD" << COLOR_RESET << std::endl;
+        return 1;
+    }
+    PriceHistory history;
+    std::string error;
+    if (std::filesystem::exists(path) && !history.load(path, error)) {
+        std::cerr << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+        return 1;
+    }
+    auto changes = history.addVersion(day, catalog, error);
+    if (!changes || !history.save(path, error)) {
+        std::cerr << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+        return 1;
+    }
+    std::cout << COLOR_GREEN << "✓ Version " << history.getVersions().size() << " from " << formatDay(day) << " added to "
+              << path << " with " << *changes << " price changes" << COLOR_RESET << std::endl;
+    return 0;
+}
+
+// Versions of a price history with their change counts, or the timeline of one item
+int runHistoryShow(const std::string& path, const std::string& itemName) {
+    PriceHistory history;
+    std::string error;
+    if (!history.load(path, error)) {
+        std::cerr << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+        return 1;
+    }
+
+    if (itemName.empty()) {
+        printHeader("Price history: " + std::to_string(history.getVersions().size()) + " versions");
+        size_t changes = 0;
+        for (size_t v = 0; v < history.getVersions().size(); ++v) {
+            const auto& version = history.getVersions()[v];
+            changes += version.changes.size();
+            std::cout << " [" << v + 1 << "] " << formatDay(version.day) << "  " << version.changes.size()
+                      << " price changes" << std::endl;
+        }
+        std::error_code ec;
+        auto bytes = std::filesystem::file_size(path, ec);
+        std::cout << "\n" << history.getItemCount() << " items, " << changes << " stored changes instead of "
+                  << history.getItemCount() * history.getVersions().size() << " full-catalog prices ("
+                  << (ec ? 0 : bytes) << " bytes)" << std::endl;
+        return 0;
+    }
+
+    for (PricedKind kind : {PricedKind::VEHICLE, PricedKind::ENGINE, PricedKind::EQUIPMENT}) {
+        auto item = history.findItem(kind, itemName);
+        if (!item) continue;
+        printHeader("Price history: " + itemName);
+        for (const auto& [day, price] : history.timeline(*item)) {
+            std::cout << " " << formatDay(day) << "  "
+                      << (price == PriceHistory::NOT_PRICED ? std::string("not in catalog") : formatPrice(price / 100.0))
+                      << std::endl;
+        }
+        return 0;
+    }
+    std::cerr << COLOR_RED << "✗ " << itemName << " is not in " << path << COLOR_RESET << std::endl;
+    return 1;
+}
+
+// Reprices saved configurations as of a date, or as of the day each was saved ("saved"), and
+// compares against the stored TOTAL_PRICE
+int runQuoteAsOf(const std::string& historyPath, const std::string& date, const std::vector<std::string>& files) {
+    PriceHistory history;
+    std::string error;
+    if (!history.load(historyPath, error)) {
+        std::cerr << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+        return 1;
+    }
+    int32_t fixedDay = 0;
+    bool asSaved = date == "saved";
+    if (!asSaved && !parseDay(date, fixedDay)) {
+        std::cerr << COLOR_RED << "✗ Invalid date " << date << ", expected YYYY-MM-DD or saved" << COLOR_RESET << std::endl;
+        return 1;
+    }
+
+    size_t failures = 0;
+    std::string contents;
+    for (const auto& file : files) {
+        SavedConfiguration config;
+        int32_t day = fixedDay;
+        double total = 0.0;
+        std::string missing;
+        if (!readFileInto(file, contents) || !parseSavedConfiguration(contents, config, error)) {
+            std::cout << COLOR_RED << "✗ " << file << ": cannot read configuration" << COLOR_RESET << std::endl;
+        } else if (asSaved && !parseDay(config.date, day)) {
+            std::cout << COLOR_RED << "✗ " << file << ": no save date" << COLOR_RESET << std::endl;
+        } else if (!quoteAsOf(history, config, day, total, missing)) {
+            std::cout << COLOR_YELLOW << "! " << file << ": " << missing << " had no price on " << formatDay(day)
+                      << COLOR_RESET << std::endl;
+        } else {
+            double difference = total - config.totalPrice;
+            std::cout << file << "  " << formatDay(day) << "  " << formatPrice(total) << "  saved "
+                      << formatPrice(config.totalPrice);
+            if (std::abs(difference) < 0.005) {
+                std::cout << COLOR_GREEN << "  ✓" << COLOR_RESET << std::endl;
+            } else {
+                std::cout << COLOR_YELLOW << "  " << (difference > 0 ? "+" : "-") << formatPrice(std::abs(difference))
+                          << COLOR_RESET << std::endl;
+            }
+            continue;
+        }
+        ++failures;
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+// Builds a history of daily versions with a few percent of prices changed each day, then compares
+// lookups as of random days with current-price lookups by name and by position
+void runHistoryBenchmark(const CatalogView& catalog, size_t versionCount) {
+    std::vector<VehicleRecord> vehicles(catalog.vehicles.begin(), catalog.vehicles.end());
+    std::vector<EngineRecord> engines(catalog.engines.begin(), catalog.engines.end());
+    std::vector<EquipmentRecord> equipment(catalog.equipment.begin(), catalog.equipment.end());
+    CatalogView changing{vehicles, engines, equipment, catalog.colors};
+
+    SimulationRandom random(46);
+    auto drift = [&random](double& price) {
+        if (random.next() % 100 < 3) price = std::round(price * (0.95 + (random.next() % 1000) / 10000.0));
+    };
+    PriceHistory history;
+    std::string error;
+    int32_t firstDay = 0;
+    parseDay("2020-01-01", firstDay);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t v = 0; v < versionCount; ++v) {
+        for (auto& vehicle : vehicles) drift(vehicle.basePrice);
+        for (auto& engine : engines) drift(engine.price);
+        for (auto& item : equipment) drift(item.price);
+        history.addVersion(firstDay + static_cast<int32_t>(v), changing, error);
+    }
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    size_t changes = 0;
+    for (const auto& version : history.getVersions()) changes += version.changes.size();
+    printHeader("Price history benchmark: " + std::to_string(versionCount) + " versions");
+    std::cout << history.getItemCount() << " items, " << changes << " stored changes instead of "
+              << history.getItemCount() * versionCount << " full-catalog prices, built in " << std::fixed
+              << std::setprecision(1) << buildMs << " ms" << std::endl;
+
+    constexpr size_t LOOKUPS = 1000000;
+    std::vector<size_t> picks(LOOKUPS);
+    std::vector<int32_t> lookupDays(LOOKUPS);
+    std::vector<std::string> names(LOOKUPS);
+    for (size_t i = 0; i < LOOKUPS; ++i) {
+        picks[i] = random.next() % equipment.size();
+        lookupDays[i] = firstDay + static_cast<int32_t>(random.next() % versionCount);
+        names[i] = std::string(equipment[picks[i]].name);
+    }
+    std::vector<uint32_t> ids(equipment.size());
+    for (size_t i = 0; i < equipment.size(); ++i) ids[i] = *history.findItem(PricedKind::EQUIPMENT, std::string(equipment[i].name));
+    CatalogIndex index(changing);
+
+    auto measure = [](const std::string& label, auto lookup) {
+        auto start = std::chrono::steady_clock::now();
+        double sum = 0.0;
+        for (size_t i = 0; i < LOOKUPS; ++i) sum += lookup(i);
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / LOOKUPS;
+        std::cout << std::left << std::setw(30) << label << std::right << std::setw(8) << std::setprecision(1) << ns
+                  << " ns/lookup  (checksum " << std::setprecision(0) << sum << ")" << std::endl;
+    };
+    measure("Current price by name", [&](size_t i) { return equipment[*index.findEquipment(names[i])].price; });
+    measure("Price as of date by name", [&](size_t i) {
+        return history.priceAsOf(*history.findItem(PricedKind::EQUIPMENT, names[i]), lookupDays[i]) / 100.0;
+    });
+    measure("Current price by id", [&](size_t i) { return equipment[picks[i]].price; });
+    measure("Price as of date by id", [&](size_t i) { return history.priceAsOf(ids[picks[i]], lookupDays[i]) / 100.0; });
+}
+
+// Archive of saved configuration files for long-term storage: files are concatenated into blocks
+// of ARCHIVE_BLOCK_FILES, each block is compressed on its own, and an index at the end maps every
+// file name to its block and position. Reading one file decompresses only its block.
+constexpr char ARCHIVE_MAGIC[8] = {'V', 'C', 'F', 'G', 'A', 'R', 'C', '1'};
+constexpr uint32_t ARCHIVE_VERSION = 1;
+constexpr size_t ARCHIVE_BLOCK_FILES = 128;
+
+enum class ArchiveCodec : uint32_t {
+    LZ = 1,  // Built-in, always available
+    ZLIB = 2 // System zlib, when the build found it
+};
+
+#ifdef HAVE_ZLIB
+constexpr ArchiveCodec DEFAULT_ARCHIVE_CODEC = ArchiveCodec::ZLIB;
+#else
+constexpr ArchiveCodec DEFAULT_ARCHIVE_CODEC = ArchiveCodec::LZ;
+#endif
+
+std::string_view archiveCodecName(ArchiveCodec codec) {
+    return codec == ArchiveCodec::ZLIB ? "zlib" : codec == ArchiveCodec::LZ ? "lz" : "unknown";
+}
+
+// Byte-oriented LZ77 in the style of LZ4. Each sequence is a token (literal length in the high
+// nibble, match length - 4 in the low nibble, 15 meaning "more bytes follow"), the literals, and a
+// two-byte offset back into the output. The last sequence has literals only.
+constexpr size_t LZ_MIN_MATCH = 4;
+constexpr size_t LZ_MAX_OFFSET = 65535;
+constexpr unsigned LZ_HASH_BITS = 14;
+
+void lzWriteLength(std::string& out, size_t length) {
+    for (; length >= 255; length -= 255) out.push_back(static_cast<char>(255));
+    out.push_back(static_cast<char>(length));
+}
+
+void lzCompress(std::string_view input, std::string& out) {
+    auto load32 = [&input](size_t position) {
+        uint32_t value;
+        std::memcpy(&value, input.data() + position, sizeof(value));
+        return value;
+    };
+    auto emit = [&out, &input](size_t literalStart, size_t literalLength, size_t matchLength, size_t offset) {
+        size_t extraMatch = matchLength == 0 ? 0 : matchLength - LZ_MIN_MATCH;
+        out.push_back(static_cast<char>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(extraMatch, 15)));
+        if (literalLength >= 15) lzWriteLength(out, literalLength - 15);
+        out.append(input.substr(literalStart, literalLength));
+        if (matchLength == 0) return;
+        out.push_back(static_cast<char>(offset & 0xff));
+        out.push_back(static_cast<char>(offset >> 8));
+        if (extraMatch >= 15) lzWriteLength(out, extraMatch - 15);
+    };
+
+    std::vector<uint32_t> table(size_t{1} << LZ_HASH_BITS, UINT32_MAX);
+    size_t anchor = 0;
+    size_t position = 0;
+    while (position + LZ_MIN_MATCH <= input.size()) {
+        uint32_t sequence = load32(position);
+        uint32_t& slot = table[(sequence * 2654435761u) >> (32 - LZ_HASH_BITS)];
+        size_t candidate = slot;
+        slot = static_cast<uint32_t>(position);
+        if (candidate == UINT32_MAX || position - candidate > LZ_MAX_OFFSET || load32(candidate) != sequence) {
+            ++position;
+            continue;
+        }
+        size_t length = LZ_MIN_MATCH;
+        while (position + length < input.size() && input[candidate + length] == input[position + length]) ++length;
+        emit(anchor, position - anchor, length, position - candidate);
+        position += length;
+        anchor = position;
+    }
+    emit(anchor, input.size() - anchor, 0, 0);
+}
+
+// Decodes into out, which must come out at exactly rawSize bytes
+bool lzDecompress(std::string_view input, size_t rawSize, std::string& out) {
+    out.clear();
+    out.reserve(rawSize);
+    size_t position = 0;
+    auto readLength = [&input, &position](size_t& length) {
+        while (position < input.size()) {
+            unsigned char byte = static_cast<unsigned char>(input[position++]);
+            length += byte;
+            if (byte != 255) return true;
+        }
+        return false;
+    };
+
+    while (position < input.size()) {
+        unsigned char token = static_cast<unsigned char>(input[position++]);
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(literalLength)) return false;
+        if (input.size() - position < literalLength || out.size() + literalLength > rawSize) return false;
+        out.append(input.substr(position, literalLength));
+        position += literalLength;
+        if (position == input.size()) break;
+
+        if (input.size() - position < 2) return false;
+        size_t offset = static_cast<unsigned char>(input[position]) | static_cast<unsigned char>(input[position + 1]) << 8;
+        position += 2;
+        size_t matchLength = token & 0x0f;
+        if (matchLength == 15 && !readLength(matchLength)) return false;
+        matchLength += LZ_MIN_MATCH;
+        if (offset == 0 || offset > out.size() || out.size() + matchLength > rawSize) return false;
+        // Byte by byte, since a match may overlap the bytes it produces
+        size_t from = out.size() - offset;
+        for (size_t i = 0; i < matchLength; ++i) out.push_back(out[from + i]);
+    }
+    return out.size() == rawSize;
+}
+
+bool compressBlock(ArchiveCodec codec, std::string_view raw, std::string& out) {
+    out.clear();
+    if (codec == ArchiveCodec::LZ) {
+        lzCompress(raw, out);
+        return true;
+    }
+#ifdef HAVE_ZLIB
+    uLongf size = compressBound(static_cast<uLong>(raw.size()));
+    out.resize(size);
+    if (compress2(reinterpret_cast<Bytef*>(out.data()), &size, reinterpret_cast<const Bytef*>(raw.data()),
+                  static_cast<uLong>(raw.size()), Z_DEFAULT_COMPRESSION) != Z_OK) {
+        return false;
+    }
+    out.resize(size);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool decompressBlock(ArchiveCodec codec, std::string_view compressed, size_t rawSize, std::string& out) {
+    if (codec == ArchiveCodec::LZ) {
+        return lzDecompress(compressed, rawSize, out);
+    }
+#ifdef HAVE_ZLIB
+    out.resize(rawSize);
+    uLongf size = static_cast<uLongf>(rawSize);
+    return uncompress(reinterpret_cast<Bytef*>(out.data()), &size, reinterpret_cast<const Bytef*>(compressed.data()),
+                      static_cast<uLong>(compressed.size())) == Z_OK && size == rawSize;
+#else
+    return false;
+#endif
+}
+
+uint64_t archiveChecksum(std::string_view data) {
+    // FNV-1a, 64-bit
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : data) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return hash;
+}
+
+struct ArchiveBlock {
+    uint64_t offset;
+    uint32_t compressedSize;
+    uint32_t rawSize;
+    uint64_t checksum; // Of the raw bytes
+};
+
+struct ArchiveEntry {
+    std::string_view name;
+    uint32_t block;
+    uint32_t offset; // Within the raw block
+    uint32_t size;
+};
+
+// One block ready to be written: the files it holds and their compressed concatenation
+struct PackedBlock {
+    std::vector<std::pair<std::string, uint32_t>> files; // Name and size, in block order
+    std::string compressed;
+    uint32_t rawSize = 0;
+    uint64_t checksum = 0;
+    bool ok = false;
+};
+
+class ArchiveWriter {
+private:
+    std::ofstream out;
+    ArchiveCodec codec;
+    std::vector<ArchiveBlock> blocks;
+    std::vector<std::tuple<std::string, uint32_t, uint32_t, uint32_t>> entries;
+    uint64_t rawBytes = 0;
+
+public:
+    ArchiveWriter(const std::string& path, ArchiveCodec codec) : out(path, std::ios::binary), codec(codec) {
+        out.write(ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    }
+
+    bool isOpen() const { return out.is_open(); }
+    ArchiveCodec getCodec() const { return codec; }
+    size_t getBlockCount() const { return blocks.size(); }
+    size_t getFileCount() const { return entries.size(); }
+    uint64_t getRawBytes() const { return rawBytes; }
+
+    void append(const PackedBlock& block) {
+        uint32_t index = static_cast<uint32_t>(blocks.size());
+        blocks.push_back({static_cast<uint64_t>(out.tellp()), static_cast<uint32_t>(block.compressed.size()),
+                          block.rawSize, block.checksum});
+        out.write(block.compressed.data(), static_cast<std::streamsize>(block.compressed.size()));
+        uint32_t offset = 0;
+        for (const auto& [name, size] : block.files) {
+            entries.emplace_back(name, index, offset, size);
+            offset += size;
+        }
+        rawBytes += block.rawSize;
+    }
+
+    bool finish() {
+        uint64_t indexOffset = static_cast<uint64_t>(out.tellp());
+        writeBinary(out, ARCHIVE_VERSION);
+        writeBinary(out, static_cast<uint32_t>(codec));
+        writeBinary(out, static_cast<uint32_t>(blocks.size()));
+        for (const auto& block : blocks) {
+            writeBinary(out, block.offset);
+            writeBinary(out, block.compressedSize);
+            writeBinary(out, block.rawSize);
+            writeBinary(out, block.checksum);
+        }
+        writeBinary(out, static_cast<uint32_t>(entries.size()));
+        for (const auto& [name, block, offset, size] : entries) {
+            writeBinary(out, static_cast<uint32_t>(name.size()));
+            out.write(name.data(), static_cast<std::streamsize>(name.size()));
+            writeBinary(out, block);
+            writeBinary(out, offset);
+            writeBinary(out, size);
+        }
+        writeBinary(out, indexOffset);
+        out.write(ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+        out.close();
+        return !out.fail();
+    }
+};
+
+// Reads an archive through a memory mapping; names in the index point into it
+class ArchiveReader {
+private:
+    MappedFile file;
+    ArchiveCodec codec = ArchiveCodec::LZ;
+    std::vector<ArchiveBlock> blocks;
+    std::vector<ArchiveEntry> entries;
+    std::unordered_map<std::string_view, size_t> byName;
+
+public:
+    bool open(const std::string& path, std::string& error) {
+        if (!file.open(path)) {
+            error = "cannot open " + path;
+            return false;
+        }
+        std::string_view data = file.contents();
+        if (data.size() < 2 * sizeof(ARCHIVE_MAGIC) + sizeof(uint64_t) ||
+            data.substr(0, sizeof(ARCHIVE_MAGIC)) != std::string_view(ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) ||
+            data.substr(data.size() - sizeof(ARCHIVE_MAGIC)) != std::string_view(ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC))) {
+            error = path + " is not a configuration archive";
+            return false;
+        }
+
+        uint64_t indexOffset = 0;
+        size_t position = data.size() - sizeof(ARCHIVE_MAGIC) - sizeof(uint64_t);
+        readBinary(data, position, indexOffset);
+        position = indexOffset;
+
+        uint32_t version = 0;
+        uint32_t codecId = 0;
+        uint32_t blockCount = 0;
+        bool valid = readBinary(data, position, version) && version == ARCHIVE_VERSION &&
+                     readBinary(data, position, codecId) && readBinary(data, position, blockCount);
+        codec = static_cast<ArchiveCodec>(codecId);
+        blocks.assign(valid ? blockCount : 0, {});
+        for (auto& block : blocks) {
+            valid = valid && readBinary(data, position, block.offset) && readBinary(data, position, block.compressedSize) &&
+                    readBinary(data, position, block.rawSize) && readBinary(data, position, block.checksum) &&
+                    block.offset <= indexOffset && indexOffset - block.offset >= block.compressedSize;
+        }
+
+        uint32_t entryCount = 0;
+        valid = valid && readBinary(data, position, entryCount);
+        entries.assign(valid ? entryCount : 0, {});
+        for (auto& entry : entries) {
+            uint32_t length = 0;
+            valid = valid && readBinary(data, position, length) && data.size() - position >= length;
+            if (!valid) break;
+            entry.name = data.substr(position, length);
+            position += length;
+            valid = readBinary(data, position, entry.block) && readBinary(data, position, entry.offset) &&
+                    readBinary(data, position, entry.size) && entry.block < blocks.size() &&
+                    entry.offset <= blocks[entry.block].rawSize && blocks[entry.block].rawSize - entry.offset >= entry.size;
+        }
+        if (!valid) {
+            error = path + ": corrupt index";
+            return false;
+        }
+        if (codec != ArchiveCodec::LZ && codec != DEFAULT_ARCHIVE_CODEC) {
+            error = path + " uses " + std::string(archiveCodecName(codec)) + ", which this build cannot read";
+            return false;
+        }
+
+        byName.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) byName.emplace(entries[i].name, i);
+        return true;
+    }
+
+    ArchiveCodec getCodec() const { return codec; }
+    const std::vector<ArchiveBlock>& getBlocks() const { return blocks; }
+    const std::vector<ArchiveEntry>& getEntries() const { return entries; }
+
+    const ArchiveEntry* find(std::string_view name) const {
+        auto it = byName.find(name);
+        return it == byName.end() ? nullptr : &entries[it->second];
+    }
+
+    // Decompresses one block and verifies it against its checksum
+    bool readBlock(size_t index, std::string& raw) const {
+        const ArchiveBlock& block = blocks[index];
+        return decompressBlock(codec, file.contents().substr(block.offset, block.compressedSize), block.rawSize, raw) &&
+               archiveChecksum(raw) == block.checksum;
+    }
+
+    bool extract(const ArchiveEntry& entry, std::string& contents) const {
+        std::string raw;
+        if (!readBlock(entry.block, raw)) return false;
+        contents.assign(raw, entry.offset, entry.size);
+        return true;
+    }
+};
+
+// Packs every saved configuration of a directory into an archive. Blocks are read and compressed
+// in parallel, a batch at a time, and written in file order.
+void runArchivePack(const std::string& directory, const std::string& archivePath, ArchiveCodec codec,
+                    size_t threadCount) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::filesystem::path> files = listSavedConfigurations(directory);
+    ArchiveWriter writer(archivePath, codec);
+    if (!writer.isOpen()) {
+        std::cout << COLOR_RED << "✗ Cannot create " << archivePath << COLOR_RESET << std::endl;
+        return;
+    }
+
+    ThreadPool pool(threadCount);
+    const size_t batchBlocks = pool.size() * 4;
+    std::vector<PackedBlock> batch(batchBlocks);
+    size_t unreadable = 0;
+    bool failed = false;
+    for (size_t first = 0; first < files.size() && !failed; first += batchBlocks * ARCHIVE_BLOCK_FILES) {
+        size_t blockCount = std::min(batchBlocks, (files.size() - first + ARCHIVE_BLOCK_FILES - 1) / ARCHIVE_BLOCK_FILES);
+        for (size_t b = 0; b < blockCount; ++b) {
+            pool.submit([&, b] {
+                PackedBlock& block = batch[b];
+                block = PackedBlock{};
+                std::string raw;
+                std::string contents;
+                size_t begin = first + b * ARCHIVE_BLOCK_FILES;
+                size_t end = std::min(files.size(), begin + ARCHIVE_BLOCK_FILES);
+                for (size_t i = begin; i < end; ++i) {
+                    if (!readFileInto(files[i], contents)) continue;
+                    raw += contents;
+                    block.files.emplace_back(files[i].filename().string(), static_cast<uint32_t>(contents.size()));
+                }
+                block.rawSize = static_cast<uint32_t>(raw.size());
+                block.checksum = archiveChecksum(raw);
+                block.ok = compressBlock(codec, raw, block.compressed);
+            });
+        }
+        pool.wait();
+        for (size_t b = 0; b < blockCount; ++b) {
+            size_t expected = std::min(ARCHIVE_BLOCK_FILES, files.size() - first - b * ARCHIVE_BLOCK_FILES);
+            unreadable += expected - batch[b].files.size();
+            failed = failed || !batch[b].ok;
+            if (batch[b].ok && !batch[b].files.empty()) writer.append(batch[b]);
+        }
+    }
+
+    if (failed || !writer.finish()) {
+        std::cout << COLOR_RED << "✗ Failed to write " << archivePath << COLOR_RESET << std::endl;
+        return;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::error_code ec;
+    auto bytes = std::filesystem::file_size(archivePath, ec);
+    std::cout << COLOR_GREEN << "✓ Archived " << writer.getFileCount() << " configurations in " << writer.getBlockCount()
+              << " " << archiveCodecName(codec) << " blocks to " << archivePath << COLOR_RESET << std::endl;
+    std::cout << std::fixed << std::setprecision(1) << writer.getRawBytes() / 1024.0 << " KB -> "
+              << (ec ? 0.0 : bytes / 1024.0) << " KB (" << std::setprecision(2)
+              << (ec || bytes == 0 ? 0.0 : static_cast<double>(writer.getRawBytes()) / bytes) << "x) in "
+              << seconds << " s" << std::endl;
+    if (unreadable > 0) {
+        std::cout << COLOR_YELLOW << "! Skipped " << unreadable << " unreadable files" << COLOR_RESET << std::endl;
+    }
+}
+
+// Restores every configuration of an archive into a directory, one block per task
+void runArchiveUnpack(const std::string& archivePath, const std::string& directory, size_t threadCount) {
+    auto start = std::chrono::steady_clock::now();
+    ArchiveReader reader;
+    std::string error;
+    if (!reader.open(archivePath, error)) {
+        std::cout << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    // Entries are stored block by block, so each block's files are one contiguous range
+    std::vector<size_t> firstEntry(reader.getBlocks().size() + 1, reader.getEntries().size());
+    for (size_t i = reader.getEntries().size(); i-- > 0;) firstEntry[reader.getEntries()[i].block] = i;
+    for (size_t b = reader.getBlocks().size(); b-- > 0;) firstEntry[b] = std::min(firstEntry[b], firstEntry[b + 1]);
+
+    std::atomic<size_t> written{0};
+    std::atomic<size_t> failures{0};
+    ThreadPool pool(threadCount);
+    for (size_t b = 0; b < reader.getBlocks().size(); ++b) {
+        pool.submit([&, b] {
+            std::string raw;
+            if (!reader.readBlock(b, raw)) {
+                failures += firstEntry[b + 1] - firstEntry[b];
+                return;
+            }
+            for (size_t i = firstEntry[b]; i < firstEntry[b + 1]; ++i) {
+                const ArchiveEntry& entry = reader.getEntries()[i];
+                // Names come from the archive, so only plain file names are written
+                std::filesystem::path name(std::string(entry.name));
+                std::ofstream out(std::filesystem::path(directory) / name.filename(), std::ios::binary);
+                out.write(raw.data() + entry.offset, entry.size);
+                out.close();
+                if (out.fail()) {
+                    ++failures;
+                } else {
+                    ++written;
+                }
+            }
+        });
+    }
+    pool.wait();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << COLOR_GREEN << "✓ Restored " << written << " configurations to " << directory << " in "
+              << std::fixed << std::setprecision(2) << seconds << " s" << COLOR_RESET << std::endl;
+    if (failures > 0) {
+        std::cout << COLOR_RED << "✗ " << failures << " configurations could not be restored" << COLOR_RESET << std::endl;
+    }
+}
+
+// Extracts one configuration by file name, to a file or to stdout; only its block is decompressed
+int runArchiveExtract(const std::string& archivePath, const std::string& name, const std::string& outputPath) {
+    ArchiveReader reader;
+    std::string error;
+    if (!reader.open(archivePath, error)) {
+        std::cerr << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+        return 1;
+    }
+    const ArchiveEntry* entry = reader.find(name);
+    if (!entry) entry = reader.find(name + ".txt");
+    if (!entry) {
+        std::cerr << COLOR_RED << "✗ " << name << " is not in " << archivePath << COLOR_RESET << std::endl;
+        return 1;
+    }
+
+    std::string contents;
+    if (!reader.extract(*entry, contents)) {
+        std::cerr << COLOR_RED << "✗ Block " << entry->block << " of " << archivePath << " is corrupt" << COLOR_RESET << std::endl;
+        return 1;
+    }
+    if (outputPath == "-") {
+        std::cout << contents << std::flush;
+        return 0;
+    }
+    std::ofstream out(outputPath, std::ios::binary);
+    out << contents;
+    out.close();
+    if (out.fail()) {
+        std::cerr << COLOR_RED << "✗ Cannot write " << outputPath << COLOR_RESET << std::endl;
+        return 1;
+    }
+    std::cerr << COLOR_GREEN << "✓ Extracted " << entry->name << " to " << outputPath << COLOR_RESET << std::endl;
+    return 0;
+}
+
+// Lists the archive index: every configuration with its block and size
+void runArchiveList(const std::string& archivePath) {
+    ArchiveReader reader;
+    std::string error;
+    if (!reader.open(archivePath, error)) {
+        std::cout << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+        return;
+    }
+    for (const auto& entry : reader.getEntries()) {
+        std::cout << std::left << std::setw(48) << entry.name << std::right << " block " << std::setw(6) << entry.block
+                  << std::setw(10) << entry.size << " bytes" << std::endl;
+    }
+    uint64_t compressed = 0;
+    uint64_t raw = 0;
+    for (const auto& block : reader.getBlocks()) {
+        compressed += block.compressedSize;
+        raw += block.rawSize;
+    }
+    std::cout << reader.getEntries().size() << " configurations, " << reader.getBlocks().size() << " "
+              << archiveCodecName(reader.getCodec()) << " blocks, " << raw << " -> " << compressed << " bytes" << std::endl;
+}
+
+// Lists saved configurations that hold the same configuration; with remove, keeps the first file of each group
+void runConfigurationDedupe(const std::string& directory, bool remove) {
+    SavedConfigurationIndex index;
+    index.scan(directory);
+    auto groups = index.duplicates();
+    printHeader("Duplicate configurations: " + std::to_string(groups.size()) + " groups");
+
+    size_t removed = 0;
+    for (const auto& group : groups) {
+        std::cout << COLOR_CYAN << group.front().string() << COLOR_RESET << std::endl;
+        for (size_t i = 1; i < group.size(); ++i) {
+            std::cout << "  ├─ " << group[i].string();
+            std::error_code ec;
+            if (remove && std::filesystem::remove(group[i], ec)) {
+                std::cout << COLOR_RED << " (removed)" << COLOR_RESET;
+                ++removed;
             }
-            case 9: {
-                if (!configurator.hasSelectedVehicle()) {
-                    std::cout << COLOR_YELLOW << "! Please select a vehicle first." << COLOR_RESET << std::endl;
-                    std::cout << "Press Enter to continue...";
-                    std::cin.ignore();
-                    std::cin.get();
-                    break;
+            std::cout << std::endl;
+        }
+    }
+    if (remove) {
+        std::cout << COLOR_GREEN << "✓ Removed " << removed << " duplicate files" << COLOR_RESET << std::endl;
+    }
+}
+
+// Renders PDF and HTML reports for every saved configuration in a directory on a thread pool
+void runReportBatch(const CatalogView& catalog, const std::string& inputDirectory,
+                    const std::string& outputDirectory, size_t threadCount) {
+    auto files = listSavedConfigurations(inputDirectory);
+    printHeader("Report batch: " + std::to_string(files.size()) + " configurations");
+
+    std::error_code ec;
+    std::filesystem::create_directories(outputDirectory, ec);
+
+    // Reports show the total as the configurator does; one plan is shared by every job
+    auto plan = std::make_shared<const PricingPlan>(catalog, 0, builtInPricingRules);
+    std::atomic<size_t> rendered{0};
+    std::atomic<size_t> failed{0};
+    std::mutex errorMutex;
+    auto reportError = [&](const std::filesystem::path& file, const std::string& message) {
+        failed.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(errorMutex);
+        std::cerr << COLOR_RED << "✗ " << file.string() << ": " << message << COLOR_RESET << std::endl;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(threadCount);
+        for (const auto& file : files) {
+            pool.submit([&, file] {
+                // Each job keeps its vehicle in a small arena that is dropped in one shot
+                std::array<std::byte, 16384> buffer;
+                std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+
+                std::ifstream input(file);
+                SavedConfiguration config;
+                std::string error;
+                if (!input.is_open() || !readSavedConfiguration(input, config, error)) {
+                    reportError(file, error.empty() ? "cannot open file" : error);
+                    return;
                 }
 
-                clearScreen();
-                printHeader("Save Configuration");
-                std::cout << "Enter filename (without extension): ";
-                std::string filename;
-                std::cin.ignore();
-                std::getline(std::cin, filename);
+                std::vector<std::string> warnings;
+                auto vehicle = resolveSavedConfiguration(config, catalog, &arena, warnings);
+                if (!vehicle) {
+                    reportError(file, "no matching vehicle in catalog");
+                    return;
+                }
+                vehicle->setPricingPlan(plan);
 
-                configurator.saveConfiguration(filename);
-                std::cout << "Press Enter to continue...";
-                std::cin.get();
-                break;
+                std::filesystem::path outputBase = std::filesystem::path(outputDirectory) / file.stem();
+                if (!renderReport(*vehicle, outputBase.string() + ".pdf") ||
+                    !renderReport(*vehicle, outputBase.string() + ".html")) {
+                    reportError(file, "cannot write report");
+                    return;
+                }
+                rendered.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        pool.wait();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << COLOR_GREEN << "✓ Rendered " << rendered.load() << " reports to " << outputDirectory
+              << " using " << threadCount << " threads in " << std::fixed << std::setprecision(2) << seconds << " s";
+    if (seconds > 0) {
+        std::cout << " (" << std::setprecision(0) << rendered.load() / seconds << " configurations/s)";
+    }
+    std::cout << COLOR_RESET << std::endl;
+    if (failed.load() > 0) {
+        std::cout << COLOR_YELLOW << "! " << failed.load() << " configurations failed" << COLOR_RESET << std::endl;
+    }
+}
+
+// One order from a CRM export, carried through the quote pipeline
+struct QuoteOrder {
+    size_t line = 0;
+    std::string id;
+    std::string vehicle; // "Brand Model"
+    std::string engine;
+    std::vector<std::string> equipment;
+    std::string color;
+    double discount = 0.0;
+    std::string error;
+
+    // Filled by the resolve stage
+    const VehicleRecord* vehicleRecord = nullptr;
+    const EngineRecord* engineRecord = nullptr;
+    std::vector<const EquipmentRecord*> equipmentRecords;
+
+    // Filled by the price stage
+    double listPrice = 0.0;
+    double packageSavings = 0.0;
+    double discountAmount = 0.0;
+    double vat = 0.0;
+    double total = 0.0;
+};
+
+// Orders travel through the pipeline in chunks to keep queue traffic low
+struct QuoteChunk {
+    size_t sequence = 0;
+    std::vector<std::pair<size_t, std::string>> lines;
+    std::vector<QuoteOrder> orders;
+    std::string output;
+};
+
+enum class OrderFormat {
+    CSV,
+    JSON_LINES
+};
+
+// Splits one CSV line, honoring double-quoted fields with "" escapes
+std::vector<std::string> splitCsvLine(std::string_view line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields.back() += c;
             }
-            case 10: {
-                clearScreen();
-                printHeader("Load Configuration");
-                std::cout << "Enter filename (without extension): ";
-                std::string filename;
-                std::cin.ignore();
-                std::getline(std::cin, filename);
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
 
-                if (!configurator.loadConfiguration(filename)) {
-                    std::cout << "Press Enter to continue...";
-                    std::cin.get();
+// Column positions taken from the CSV header
+struct CsvColumns {
+    int id = -1;
+    int vehicle = -1;
+    int brand = -1;
+    int model = -1;
+    int engine = -1;
+    int equipment = -1;
+    int color = -1;
+    int discount = -1;
+
+    explicit CsvColumns(const std::vector<std::string>& header) {
+        for (size_t i = 0; i < header.size(); ++i) {
+            std::string name(trimView(header[i]));
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+            int column = static_cast<int>(i);
+            if (name == "id") id = column;
+            else if (name == "vehicle") vehicle = column;
+            else if (name == "brand") brand = column;
+            else if (name == "model") model = column;
+            else if (name == "engine") engine = column;
+            else if (name == "equipment") equipment = column;
+            else if (name == "color") color = column;
+            else if (name == "discount") discount = column;
+        }
+    }
+
+    bool isValid() const { return vehicle >= 0 || (brand >= 0 && model >= 0); }
+};
+
+void parseCsvOrder(std::string_view text, const CsvColumns& columns, QuoteOrder& order) {
+    std::vector<std::string> fields = splitCsvLine(text);
+    auto field = [&fields](int column) -> std::string {
+        return column >= 0 && column < static_cast<int>(fields.size()) ? std::string(trimView(fields[column])) : "";
+    };
+
+    order.id = field(columns.id);
+    order.vehicle = columns.vehicle >= 0 ? field(columns.vehicle) : field(columns.brand) + " " + field(columns.model);
+    order.engine = field(columns.engine);
+    order.color = field(columns.color);
+
+    // Equipment names are separated by ';' inside the column
+    std::string equipmentColumn = field(columns.equipment);
+    std::string_view equipmentList = equipmentColumn;
+    while (!equipmentList.empty()) {
+        size_t separator = equipmentList.find(';');
+        std::string_view name = trimView(equipmentList.substr(0, separator));
+        if (!name.empty()) order.equipment.emplace_back(name);
+        if (separator == std::string_view::npos) break;
+        equipmentList.remove_prefix(separator + 1);
+    }
+
+    std::string discount = field(columns.discount);
+    if (!discount.empty() && !parseNumber(std::string_view(discount), order.discount)) {
+        order.error = "Invalid discount: " + discount;
+    }
+}
+
+// Helpers for reading flat JSON objects
+void skipJsonWhitespace(std::string_view text, size_t& pos) {
+    while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+}
+
+bool readJsonString(std::string_view text, size_t& pos, std::string& value) {
+    if (pos >= text.size() || text[pos] != '"') return false;
+    value.clear();
+    for (++pos; pos < text.size(); ++pos) {
+        char c = text[pos];
+        if (c == '"') {
+            ++pos;
+            return true;
+        }
+        if (c != '\\') {
+            value += c;
+            continue;
+        }
+        if (++pos >= text.size()) return false;
+        switch (text[pos]) {
+            case 'n': value += '\n'; break;
+            case 't': value += '\t'; break;
+            case 'r': value += '\r'; break;
+            case 'b': value += '\b'; break;
+            case 'f': value += '\f'; break;
+            case 'u': {
+                unsigned int code = 0;
+                if (pos + 4 >= text.size() ||
+                    std::from_chars(text.data() + pos + 1, text.data() + pos + 5, code, 16).ptr != text.data() + pos + 5) {
+                    return false;
+                }
+                pos += 4;
+                // Encode the code point as UTF-8 (basic multilingual plane)
+                if (code < 0x80) {
+                    value += static_cast<char>(code);
+                } else if (code < 0x800) {
+                    value += static_cast<char>(0xC0 | (code >> 6));
+                    value += static_cast<char>(0x80 | (code & 0x3F));
+                } else {
+                    value += static_cast<char>(0xE0 | (code >> 12));
+                    value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                    value += static_cast<char>(0x80 | (code & 0x3F));
                 }
                 break;
             }
-            case 11: {
-                configurator.saveForComparison();
-                std::cout << "Press Enter to continue...";
-                std::cin.ignore();
-                std::cin.get();
-                break;
+            default: value += text[pos]; // \" \\ \/
+        }
+    }
+    return false;
+}
+
+// Returns the raw token of a number, boolean or null
+std::string_view readJsonLiteral(std::string_view text, size_t& pos) {
+    size_t start = pos;
+    while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) ||
+                                 text[pos] == '-' || text[pos] == '+' || text[pos] == '.')) {
+        ++pos;
+    }
+    return text.substr(start, pos - start);
+}
+
+void parseJsonOrder(std::string_view text, QuoteOrder& order) {
+    size_t pos = 0;
+    auto fail = [&order](const std::string& message) { order.error = "Invalid JSON: " + message; };
+
+    skipJsonWhitespace(text, pos);
+    if (pos >= text.size() || text[pos++] != '{') return fail("expected object");
+
+    std::string brand, model, key, value;
+    skipJsonWhitespace(text, pos);
+    if (pos < text.size() && text[pos] == '}') return fail("empty object");
+
+    while (true) {
+        skipJsonWhitespace(text, pos);
+        if (!readJsonString(text, pos, key)) return fail("expected key");
+        skipJsonWhitespace(text, pos);
+        if (pos >= text.size() || text[pos++] != ':') return fail("expected ':'");
+        skipJsonWhitespace(text, pos);
+        if (pos >= text.size()) return fail("missing value");
+
+        if (text[pos] == '[') {
+            ++pos;
+            skipJsonWhitespace(text, pos);
+            while (pos < text.size() && text[pos] != ']') {
+                if (!readJsonString(text, pos, value)) return fail("expected string in array");
+                if (key == "equipment") order.equipment.push_back(value);
+                skipJsonWhitespace(text, pos);
+                if (pos < text.size() && text[pos] == ',') {
+                    ++pos;
+                    skipJsonWhitespace(text, pos);
+                }
             }
-            case 12: {
-                configurator.compareConfigurations();
-                break;
+            if (pos >= text.size()) return fail("unterminated array");
+            ++pos;
+        } else {
+            if (text[pos] == '"') {
+                if (!readJsonString(text, pos, value)) return fail("unterminated string");
+            } else {
+                value = std::string(readJsonLiteral(text, pos));
+                if (value.empty()) return fail("unexpected character");
             }
-            case 13: {
-                configurator.generateReport();
-                std::cout << "Press Enter to continue...";
-                std::cin.ignore();
-                std::cin.get();
-                break;
+
+            if (key == "id") order.id = value;
+            else if (key == "vehicle") order.vehicle = value;
+            else if (key == "brand") brand = value;
+            else if (key == "model") model = value;
+            else if (key == "engine") order.engine = value;
+            else if (key == "color") order.color = value;
+            else if (key == "discount" && !parseNumber(std::string_view(value), order.discount)) {
+                order.error = "Invalid discount: " + value;
             }
-            case 0: {
-                std::cout << COLOR_YELLOW << "Thank you for using Vehicle Configurator!" << COLOR_RESET << std::endl;
-                running = false;
-                break;
+        }
+
+        skipJsonWhitespace(text, pos);
+        if (pos < text.size() && text[pos] == ',') {
+            ++pos;
+            continue;
+        }
+        if (pos < text.size() && text[pos] == '}') break;
+        return fail("expected ',' or '}'");
+    }
+
+    if (order.vehicle.empty() && !brand.empty()) {
+        order.vehicle = brand + " " + model;
+    }
+}
+
+// Looks up every name of an order in the catalog
+void resolveQuoteOrder(QuoteOrder& order, const CatalogView& catalog, const CatalogIndex& index) {
+    if (!order.error.empty()) return;
+
+    auto vehicle = index.findVehicle(order.vehicle);
+    if (!vehicle) {
+        order.error = "Unknown vehicle: " + order.vehicle;
+        return;
+    }
+    order.vehicleRecord = &catalog.vehicles[*vehicle];
+
+    if (!order.engine.empty()) {
+        auto engine = index.findEngine(order.engine);
+        if (!engine) {
+            order.error = "Unknown engine: " + order.engine;
+            return;
+        }
+        order.engineRecord = &catalog.engines[*engine];
+    }
+
+    for (const auto& name : order.equipment) {
+        auto item = index.findEquipment(name);
+        if (!item) {
+            order.error = "Unknown equipment: " + name;
+            return;
+        }
+        // Duplicates are ignored, as in Vehicle::attachEquipment
+        const EquipmentRecord* record = &catalog.equipment[*item];
+        if (std::find(order.equipmentRecords.begin(), order.equipmentRecords.end(), record) == order.equipmentRecords.end()) {
+            order.equipmentRecords.push_back(record);
+        }
+    }
+
+    if (order.color.empty()) {
+        order.color = "White";
+    } else if (!index.findColor(order.color)) {
+        order.error = "Unknown color: " + order.color;
+        return;
+    }
+
+    if (order.discount < 0 || order.discount > 30) {
+        order.error = "Invalid discount. Maximum allowed discount is 30%.";
+    }
+}
+
+// Exports repeat the same configurations, so quotes go through the cache
+void priceQuoteOrder(QuoteOrder& order, const PricingPlan& plan, QuoteCache& cache) {
+    if (!order.error.empty()) return;
+
+    std::vector<std::string_view> equipment;
+    equipment.reserve(order.equipmentRecords.size());
+    for (const EquipmentRecord* item : order.equipmentRecords) {
+        equipment.push_back(item->name);
+    }
+    ConfigurationKey key = makeConfigurationKey(order.vehicleRecord->brand, order.vehicleRecord->model,
+                                                order.engineRecord ? order.engineRecord->name : "",
+                                                std::move(equipment), order.color, order.discount);
+    QuoteBreakdown quote = cache.getOrCompute(key, plan.getCatalogVersion(), [&order, &plan] {
+        return computeQuote(plan, *order.vehicleRecord, order.engineRecord, order.equipmentRecords, order.discount);
+    });
+
+    order.listPrice = quote.listPrice;
+    order.packageSavings = quote.packageSavings;
+    order.discountAmount = quote.discountAmount;
+    order.vat = quote.vat;
+    order.total = quote.total;
+}
+
+// Output helpers for quotes
+void appendFixed(std::string& out, double value) {
+    char buffer[64];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 2);
+    out.append(buffer, result.ptr);
+}
+
+void appendCsvField(std::string& out, std::string_view text) {
+    if (text.find_first_of(",\"\n") == std::string_view::npos) {
+        out += text;
+        return;
+    }
+    out += '"';
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+void serializeQuoteOrder(const QuoteOrder& order, OrderFormat format, std::string& out) {
+    if (format == OrderFormat::JSON_LINES) {
+        out += "{\"line\":" + std::to_string(order.line) + ",\"id\":";
+        appendJsonString(out, order.id);
+        if (!order.error.empty()) {
+            out += ",\"error\":";
+            appendJsonString(out, order.error);
+            out += "}\n";
+            return;
+        }
+        out += ",\"vehicle\":";
+        appendJsonString(out, order.vehicle);
+        out += ",\"engine\":";
+        appendJsonString(out, order.engine);
+        out += ",\"color\":";
+        appendJsonString(out, order.color);
+        out += ",\"equipment_count\":" + std::to_string(order.equipmentRecords.size());
+        out += ",\"list_price\":";
+        appendFixed(out, order.listPrice);
+        out += ",\"package_savings\":";
+        appendFixed(out, order.packageSavings);
+        out += ",\"discount\":";
+        appendFixed(out, order.discount);
+        out += ",\"discount_amount\":";
+        appendFixed(out, order.discountAmount);
+        out += ",\"vat\":";
+        appendFixed(out, order.vat);
+        out += ",\"total\":";
+        appendFixed(out, order.total);
+        out += "}\n";
+        return;
+    }
+
+    out += std::to_string(order.line) + ",";
+    appendCsvField(out, order.id);
+    out += ",";
+    if (order.error.empty()) {
+        appendCsvField(out, order.vehicle);
+        out += ",";
+        appendCsvField(out, order.engine);
+        out += ",";
+        appendCsvField(out, order.color);
+        out += "," + std::to_string(order.equipmentRecords.size()) + ",";
+        appendFixed(out, order.listPrice);
+        out += ",";
+        appendFixed(out, order.packageSavings);
+        out += ",";
+        appendFixed(out, order.discount);
+        out += ",";
+        appendFixed(out, order.discountAmount);
+        out += ",";
+        appendFixed(out, order.vat);
+        out += ",";
+        appendFixed(out, order.total);
+        out += ",\n";
+    } else {
+        out += ",,,,,,,,,,";
+        appendCsvField(out, order.error);
+        out += "\n";
+    }
+}
+
+struct QuotePipelineStats {
+    size_t orders = 0;
+    size_t errors = 0;
+    QuoteCache::Stats cache;
+};
+
+// Streams orders through parse -> resolve -> price -> serialize stages connected by bounded
+// queues, then writes the quotes in input order. Memory use depends on the queue sizes, not the input.
+QuotePipelineStats runQuotePipeline(std::istream& input, std::ostream& output,
+                                    const CatalogSnapshot& snapshot, size_t threadCount) {
+    constexpr size_t CHUNK_LINES = 512;
+    QuotePipelineStats stats;
+    const CatalogView& catalog = snapshot.getView();
+    CatalogIndex index(catalog);
+    PricingPlan plan(catalog, snapshot.getVersion(), builtInPricingRules);
+    QuoteCache cache;
+
+    // The first non-empty line tells the format: a JSON object or a CSV header
+    std::string line;
+    size_t lineNumber = 0;
+    OrderFormat format = OrderFormat::CSV;
+    std::optional<CsvColumns> columns;
+    std::string firstRecord;
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        std::string_view text = trimView(line);
+        if (text.empty()) continue;
+        if (text.front() == '{') {
+            format = OrderFormat::JSON_LINES;
+            firstRecord = line;
+        } else {
+            columns.emplace(splitCsvLine(text));
+            if (!columns->isValid()) {
+                std::cerr << COLOR_RED << "✗ CSV header needs a 'vehicle' column (or 'brand' and 'model')"
+                          << COLOR_RESET << std::endl;
+                return stats;
             }
-            default: {
-                std::cout << COLOR_RED << "✗ Invalid option. Please try again." << COLOR_RESET << std::endl;
-                std::cout << "Press Enter to continue...";
-                std::cin.ignore();
-                std::cin.get();
-                break;
+        }
+        break;
+    }
+    size_t firstRecordLine = lineNumber;
+
+    using ChunkPtr = std::unique_ptr<QuoteChunk>;
+    size_t queueCapacity = threadCount * 2;
+    BoundedQueue<ChunkPtr> parseQueue(queueCapacity);
+    BoundedQueue<ChunkPtr> resolveQueue(queueCapacity);
+    BoundedQueue<ChunkPtr> priceQueue(queueCapacity);
+    BoundedQueue<ChunkPtr> serializeQueue(queueCapacity);
+    BoundedQueue<ChunkPtr> writeQueue(queueCapacity);
+
+    std::vector<std::thread> threads;
+    startPipelineStage(threads, std::max<size_t>(1, threadCount / 2), parseQueue, resolveQueue, [&](ChunkPtr& chunk) {
+        chunk->orders.resize(chunk->lines.size());
+        for (size_t i = 0; i < chunk->lines.size(); ++i) {
+            QuoteOrder& order = chunk->orders[i];
+            order.line = chunk->lines[i].first;
+            if (format == OrderFormat::JSON_LINES) {
+                parseJsonOrder(chunk->lines[i].second, order);
+            } else {
+                parseCsvOrder(chunk->lines[i].second, *columns, order);
             }
         }
+        chunk->lines.clear();
+        chunk->lines.shrink_to_fit();
+    });
+    startPipelineStage(threads, std::max<size_t>(1, threadCount / 4), resolveQueue, priceQueue, [&](ChunkPtr& chunk) {
+        for (auto& order : chunk->orders) resolveQuoteOrder(order, catalog, index);
+    });
+    startPipelineStage(threads, std::max<size_t>(1, threadCount / 4), priceQueue, serializeQueue, [&](ChunkPtr& chunk) {
+        for (auto& order : chunk->orders) priceQuoteOrder(order, plan, cache);
+    });
+    startPipelineStage(threads, std::max<size_t>(1, threadCount / 4), serializeQueue, writeQueue, [format](ChunkPtr& chunk) {
+        for (const auto& order : chunk->orders) serializeQuoteOrder(order, format, chunk->output);
+    });
+
+    std::thread reader([&] {
+        size_t sequence = 0;
+        auto chunk = std::make_unique<QuoteChunk>();
+        if (!firstRecord.empty()) {
+            chunk->lines.emplace_back(firstRecordLine, std::move(firstRecord));
+        }
+        while (std::getline(input, line)) {
+            ++lineNumber;
+            if (trimView(line).empty()) continue;
+            chunk->lines.emplace_back(lineNumber, std::move(line));
+            if (chunk->lines.size() == CHUNK_LINES) {
+                chunk->sequence = sequence++;
+                parseQueue.push(std::move(chunk));
+                chunk = std::make_unique<QuoteChunk>();
+            }
+        }
+        if (!chunk->lines.empty()) {
+            chunk->sequence = sequence++;
+            parseQueue.push(std::move(chunk));
+        }
+        parseQueue.close();
+    });
+
+    // Writer: restores input order, holding only chunks that finished early
+    if (format == OrderFormat::CSV) {
+        output << "line,id,vehicle,engine,color,equipment_count,list_price,package_savings,discount,discount_amount,vat,total,"
+                  "error\n";
+    }
+    std::map<size_t, ChunkPtr> pending;
+    size_t nextSequence = 0;
+    while (auto chunk = writeQueue.pop()) {
+        pending.emplace((*chunk)->sequence, std::move(*chunk));
+        while (!pending.empty() && pending.begin()->first == nextSequence) {
+            const QuoteChunk& ready = *pending.begin()->second;
+            output.write(ready.output.data(), static_cast<std::streamsize>(ready.output.size()));
+            stats.orders += ready.orders.size();
+            for (const auto& order : ready.orders) {
+                if (!order.error.empty()) ++stats.errors;
+            }
+            pending.erase(pending.begin());
+            ++nextSequence;
+        }
     }
+    output.flush();
+
+    reader.join();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    stats.cache = cache.getStats();
+    return stats;
 }
 
-// Main function
-int main() {
-    runUserInterface();
+// Quotes orders from a file or stdin ("-") to a file or stdout
+int runQuoteBatch(const CatalogSnapshot& snapshot, const std::string& inputPath, const std::string& outputPath,
+                  size_t threadCount) {
+    std::ifstream inputFile;
+    if (inputPath != "-") {
+        inputFile.open(inputPath);
+        if (!inputFile.is_open()) {
+            std::cerr << COLOR_RED << "✗ Cannot open orders file: " << inputPath << COLOR_RESET << std::endl;
+            return 1;
+        }
+    }
+    std::ofstream outputFile;
+    if (outputPath != "-") {
+        outputFile.open(outputPath);
+        if (!outputFile.is_open()) {
+            std::cerr << COLOR_RED << "✗ Cannot open output file: " << outputPath << COLOR_RESET << std::endl;
+            return 1;
+        }
+    }
+
+    std::ios::sync_with_stdio(false);
+    auto start = std::chrono::steady_clock::now();
+    QuotePipelineStats stats = runQuotePipeline(inputPath == "-" ? std::cin : inputFile,
+                                                outputPath == "-" ? std::cout : outputFile, snapshot, threadCount);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cerr << "Quoted " << stats.orders << " orders (" << stats.errors << " rejected) in "
+              << std::fixed << std::setprecision(2) << seconds << " s";
+    if (seconds > 0) {
+        std::cerr << " - " << std::setprecision(0) << stats.orders / seconds << " orders/s";
+    }
+    std::cerr << std::endl;
+    std::cerr << "Quote cache: " << stats.cache.hits << " hits, " << stats.cache.misses << " misses ("
+              << std::setprecision(1) << stats.cache.hitRate() * 100 << "% hit rate), "
+              << stats.cache.evictions << " evictions" << std::endl;
+    return 0;
+}
+
+// A saved quote checked against the current catalog
+struct QuoteDrift {
+    enum class Status : uint8_t { CURRENT, DRIFTED, UNPRICEABLE, UNREADABLE };
+
+    struct ItemChange {
+        std::string name;
+        double savedPrice = 0.0;
+        double currentPrice = 0.0;
+        bool removed = false; // No longer in the catalog
+    };
+
+    Status status = Status::CURRENT;
+    double savedTotal = 0.0;
+    double currentTotal = 0.0;
+    std::vector<ItemChange> changes;
+};
+
+std::string_view driftStatusName(QuoteDrift::Status status) {
+    switch (status) {
+        case QuoteDrift::Status::CURRENT: return "current";
+        case QuoteDrift::Status::DRIFTED: return "drifted";
+        case QuoteDrift::Status::UNPRICEABLE: return "unpriceable";
+        case QuoteDrift::Status::UNREADABLE: return "unreadable";
+    }
+    return "unknown";
+}
+
+// Reprices a saved configuration against the catalog through the catalog's pricing plan, as a vehicle
+// configured today would be priced, and lists every item whose saved PRICE differs from the catalog;
+// prices are compared in cents
+QuoteDrift repriceSavedConfiguration(const SavedConfiguration& config, const CatalogView& catalog, const CatalogIndex& index,
+                                     const PricingPlan& plan) {
+    QuoteDrift drift;
+    drift.savedTotal = config.totalPrice;
+    PricedConfiguration priced;
+    priced.discountPercent = config.discount;
+    auto check = [&drift](const std::string& name, double savedPrice, std::optional<double> currentPrice) {
+        if (!currentPrice) {
+            drift.changes.push_back({name, savedPrice, 0.0, true});
+            return false;
+        }
+        if (toFixedPoint(savedPrice, 100.0) != toFixedPoint(*currentPrice, 100.0)) {
+            drift.changes.push_back({name, savedPrice, *currentPrice, false});
+        }
+        return true;
+    };
+
+    std::string vehicleName = config.brand + " " + config.model;
+    auto vehicle = index.findVehicle(vehicleName);
+    if (check(vehicleName, config.basePrice,
+              vehicle ? std::optional<double>(catalog.vehicles[*vehicle].basePrice) : std::nullopt)) {
+        priced.basePrice += catalog.vehicles[*vehicle].basePrice;
+    }
+    if (config.hasEngine) {
+        auto engine = index.findEngine(config.engineName);
+        if (check(config.engineName, config.enginePrice,
+                  engine ? std::optional<double>(catalog.engines[*engine].price) : std::nullopt)) {
+            priced.basePrice += catalog.engines[*engine].price;
+        }
+    }
+    for (const auto& item : config.equipment) {
+        auto equipment = index.findEquipment(item.name);
+        if (check(item.name, item.price,
+                  equipment ? std::optional<double>(catalog.equipment[*equipment].price) : std::nullopt)) {
+            plan.addEquipment(priced, item.name, catalog.equipment[*equipment].price);
+        }
+    }
+
+    drift.currentTotal = plan.evaluate(priced).unitGross;
+    bool removed = std::any_of(drift.changes.begin(), drift.changes.end(), [](const auto& change) { return change.removed; });
+    if (removed) {
+        drift.status = QuoteDrift::Status::UNPRICEABLE;
+    } else if (!drift.changes.empty() || toFixedPoint(drift.savedTotal, 100.0) != toFixedPoint(drift.currentTotal, 100.0)) {
+        drift.status = QuoteDrift::Status::DRIFTED;
+    }
+    return drift;
+}
+
+// Drift report totals; every pool task fills its own and they are merged in file order
+struct DriftSummary {
+    std::array<size_t, 4> byStatus{};
+    size_t raised = 0;
+    size_t lowered = 0;
+    double netDrift = 0.0;
+    struct ItemStats {
+        size_t quotes = 0;
+        double currentPrice = 0.0;
+        bool removed = false;
+    };
+    std::unordered_map<std::string, ItemStats> items;
+    std::vector<std::pair<double, std::string>> largest; // Difference and file, biggest first
+
+    static constexpr size_t LARGEST = 10;
+
+    void add(const std::string& file, const QuoteDrift& drift) {
+        ++byStatus[static_cast<size_t>(drift.status)];
+        for (const auto& change : drift.changes) {
+            ItemStats& stats = items[change.name];
+            ++stats.quotes;
+            stats.currentPrice = change.currentPrice;
+            stats.removed = change.removed;
+        }
+        if (drift.status != QuoteDrift::Status::DRIFTED) return;
+        double difference = drift.currentTotal - drift.savedTotal;
+        netDrift += difference;
+        (difference > 0 ? raised : lowered) += 1;
+        keepLargest(difference, file);
+    }
+
+    void keepLargest(double difference, const std::string& file) {
+        auto bigger = [](const auto& a, const auto& b) { return std::abs(a.first) > std::abs(b.first); };
+        auto position = std::upper_bound(largest.begin(), largest.end(), std::make_pair(difference, file), bigger);
+        if (position - largest.begin() >= static_cast<ptrdiff_t>(LARGEST)) return;
+        largest.insert(position, {difference, file});
+        if (largest.size() > LARGEST) largest.pop_back();
+    }
+
+    void merge(const DriftSummary& other) {
+        for (size_t i = 0; i < byStatus.size(); ++i) byStatus[i] += other.byStatus[i];
+        raised += other.raised;
+        lowered += other.lowered;
+        netDrift += other.netDrift;
+        for (const auto& [name, stats] : other.items) {
+            ItemStats& merged = items[name];
+            merged.quotes += stats.quotes;
+            merged.currentPrice = stats.currentPrice;
+            merged.removed = stats.removed;
+        }
+        for (const auto& [difference, file] : other.largest) keepLargest(difference, file);
+    }
+};
+
+void appendDriftLine(std::string& out, const std::string& file, const QuoteDrift& drift) {
+    char number[32];
+    appendCsvField(out, file);
+    out += ',';
+    out += driftStatusName(drift.status);
+    for (double value : {drift.savedTotal, drift.currentTotal, drift.currentTotal - drift.savedTotal}) {
+        std::snprintf(number, sizeof(number), ",%.2f", value);
+        out += number;
+    }
+    out += ',';
+    std::string items;
+    for (const auto& change : drift.changes) {
+        if (!items.empty()) items += "; ";
+        items += change.name;
+        std::snprintf(number, sizeof(number), " %.2f", change.savedPrice);
+        items += number;
+        if (change.removed) {
+            items += " -> removed";
+        } else {
+            std::snprintf(number, sizeof(number), " -> %.2f", change.currentPrice);
+            items += number;
+        }
+    }
+    appendCsvField(out, items);
+    out += '\n';
+}
+
+// Reprices every saved configuration of a directory against the bound catalog on the thread pool.
+// A CSV line is streamed for each quote that no longer matches; tasks parse, reprice and format
+// their share of a batch, and batches are written in file order. The summary goes to stderr when
+// the report goes to stdout.
+int runRepriceDrift(const CatalogView& catalog, const std::string& directory, const std::string& reportPath,
+                    size_t threadCount) {
+    std::ofstream reportFile;
+    if (reportPath != "-") {
+        reportFile.open(reportPath);
+        if (!reportFile.is_open()) {
+            std::cerr << COLOR_RED << "✗ Cannot open report file: " << reportPath << COLOR_RESET << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& report = reportPath == "-" ? std::cout : reportFile;
+    std::ostream& summaryOut = reportPath == "-" ? std::cerr : std::cout;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::filesystem::path> files = listSavedConfigurations(directory);
+    CatalogIndex index(catalog);
+    PricingPlan plan(catalog, 0, builtInPricingRules); // The version only keys caches, and nothing is cached here
+    report << "file,status,saved_total,current_total,difference,changed_items\n";
+
+    constexpr size_t BATCH_FILES = 16384;
+    ThreadPool pool(threadCount);
+    size_t taskCount = pool.size() * 4;
+    std::vector<std::string> lines(taskCount);
+    std::vector<DriftSummary> partials(taskCount);
+    DriftSummary summary;
+    for (size_t begin = 0; begin < files.size(); begin += BATCH_FILES) {
+        size_t count = std::min(BATCH_FILES, files.size() - begin);
+        size_t perTask = (count + taskCount - 1) / taskCount;
+        size_t tasks = 0;
+        for (size_t first = 0; first < count; first += perTask, ++tasks) {
+            size_t last = std::min(count, first + perTask);
+            pool.submit([&, task = tasks, first, last] {
+                std::string buffer;
+                std::string error;
+                lines[task].clear();
+                partials[task] = DriftSummary{};
+                for (size_t i = begin + first; i < begin + last; ++i) {
+                    SavedConfiguration config;
+                    QuoteDrift drift;
+                    if (!readFileInto(files[i], buffer) || !parseSavedConfiguration(buffer, config, error)) {
+                        drift.status = QuoteDrift::Status::UNREADABLE;
+                    } else {
+                        drift = repriceSavedConfiguration(config, catalog, index, plan);
+                    }
+                    std::string name = files[i].filename().string();
+                    partials[task].add(name, drift);
+                    if (drift.status != QuoteDrift::Status::CURRENT) appendDriftLine(lines[task], name, drift);
+                }
+            });
+        }
+        pool.wait();
+        for (size_t task = 0; task < tasks; ++task) {
+            report << lines[task];
+            summary.merge(partials[task]);
+        }
+        report.flush();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto status = [&summary](QuoteDrift::Status s) { return summary.byStatus[static_cast<size_t>(s)]; };
+    ConsoleTarget previousTarget = consoleTarget;
+    consoleTarget.output = &summaryOut;
+    printHeader("Quote drift: " + std::to_string(files.size()) + " saved quotes");
+    consoleTarget = previousTarget;
+    summaryOut << "Current: " << status(QuoteDrift::Status::CURRENT) << ", drifted: " << status(QuoteDrift::Status::DRIFTED)
+               << " (" << summary.raised << " up, " << summary.lowered << " down), unpriceable: "
+               << status(QuoteDrift::Status::UNPRICEABLE) << ", unreadable: " << status(QuoteDrift::Status::UNREADABLE)
+               << std::endl;
+    summaryOut << "Net drift: " << (summary.netDrift < 0 ? "-" : "+") << formatPrice(std::abs(summary.netDrift)) << std::endl;
+
+    if (!summary.items.empty()) {
+        std::vector<std::pair<std::string, DriftSummary::ItemStats>> items(summary.items.begin(), summary.items.end());
+        std::sort(items.begin(), items.end(), [](const auto& a, const auto& b) {
+            return a.second.quotes != b.second.quotes ? a.second.quotes > b.second.quotes : a.first < b.first;
+        });
+        summaryOut << COLOR_YELLOW << "\nChanged items:" << COLOR_RESET << std::endl;
+        for (const auto& [name, stats] : items) {
+            summaryOut << "  " << std::left << std::setw(30) << name << std::right << std::setw(10) << stats.quotes
+                       << " quotes  now " << (stats.removed ? std::string("removed") : formatPrice(stats.currentPrice))
+                       << std::endl;
+        }
+    }
+    if (!summary.largest.empty()) {
+        summaryOut << COLOR_YELLOW << "\nLargest drifts:" << COLOR_RESET << std::endl;
+        for (const auto& [difference, file] : summary.largest) {
+            summaryOut << "  " << std::left << std::setw(30) << file << std::right << std::setw(4)
+                       << (difference < 0 ? "-" : "+") << formatPrice(std::abs(difference)) << std::endl;
+        }
+    }
+    summaryOut << "\nRepriced in " << std::fixed << std::setprecision(2) << seconds << " s (" << std::setprecision(0)
+               << files.size() / std::max(seconds, 1e-9) << " quotes/s)" << std::endl;
     return 0;
 }
 
+// Publishes the current catalog in shared memory; when following a catalog file it keeps
+// republishing every reloaded version until interrupted
+int runCatalogPublisher(const CatalogStore& catalogStore, const std::string& name, bool follow) {
+    uint64_t publishedFrom = 0;
+    while (true) {
+        auto snapshot = catalogStore.snapshot();
+        if (snapshot->getVersion() != publishedFrom) {
+            std::string error;
+            uint64_t version = publishSharedCatalog(name, snapshot->getView(), error);
+            if (version == 0) {
+                std::cerr << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+                if (publishedFrom == 0) return 1;
+            } else {
+                std::cout << COLOR_GREEN << "✓ Published " << snapshot->getSource() << " as shared catalog "
+                          << name << " version " << version << " (" << snapshot->getView().vehicles.size()
+                          << " vehicles, " << snapshot->getView().equipment.size() << " equipment items)"
+                          << COLOR_RESET << std::endl;
+            }
+            publishedFrom = snapshot->getVersion();
+        }
+        if (!follow) return 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    }
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] [mode]\n"
+              << "Modes:\n"
+              << "  (none)                                   Interactive configurator\n"
+              << "  --bench-arena [count]                    Heap vs arena bulk loading/pricing benchmark\n"
+              << "  --bench-pricing [count]                  Pricing plan compile and batch scoring benchmark\n"
+              << "  --bench-what-if [count]                  Single-edit prices in one pass versus one by one\n"
+              << "  --tco [paths]                            Total cost of ownership for every catalog configuration\n"
+              << "  --ev-sim [trips]                         Real-world range and charging stops for catalog EVs\n"
+              << "  --bench-search [entries]                 Catalog search latency on a synthetic catalog\n"
+              << "  --bench-similar [count]                  Similar-configuration queries on synthetic configurations\n"
+              << "  --render-reports <configs> <output>      Render PDF/HTML reports for saved configurations\n"
+              << "  --quote [orders|-] [output|-]            Price CSV or JSON Lines orders as a stream\n"
+              << "  --dedupe-configs <dir> [remove]          Find (and remove) identical saved configurations\n"
+              << "  --analytics <dir> [top]                  Equipment, brand and category statistics of saved configurations\n"
+              << "  --export-columns <dir> <file>            Export saved configurations to a columnar file\n"
+              << "  --scan-columns <file> [filter...]        Filter and aggregate a columnar export (e.g. brand=Audi min-total=90000)\n"
+              << "  --publish-catalog <name>                 Publish the catalog in shared memory (with --watch: keep republishing)\n"
+              << "  --unpublish-catalog <name>               Remove a shared-memory catalog\n"
+              << "  --history-add <history> <YYYY-MM-DD>     Record the catalog's prices as in effect from a date\n"
+              << "  --history-show <history> [item]          List price history versions, or one item's prices\n"
+              << "  --quote-as-of <history> <date|saved> <config>... Reprice saved configurations as of a date\n"
+              << "  --bench-history [versions]               Compare historical and current price lookups\n"
+              << "  --reprice <dir> [report.csv|-]           Reprice saved quotes against the catalog and report drift\n"
+              << "  --memory-report [file|-]                 Catalog and session memory footprint as JSON\n"
+              << "  --archive-pack <dir> <archive> [lz|zlib] Pack saved configurations into a compressed archive\n"
+              << "  --archive-unpack <archive> <dir>         Restore every configuration of an archive\n"
+              << "  --archive-extract <archive> <name> [file|-] Extract one configuration\n"
+              << "  --archive-list <archive>                 List the configurations in an archive\n"
+              << "  --script [file|-]                        Run configurator commands from a script\n"
+              << "  --replay <script> [sessions]             Replay a script as parallel sessions and report latencies\n"
+              << "  --bench-finance [configurations]         Time payment grids and offers across configurations\n"
+              << "  --bench-inventory [operations]           Stress concurrent stock reservations per thread\n"
+              << "Options:\n"
+              << "  --catalog <file>                         Load the catalog from a data file\n"
+              << "  --inventory <file>                       Sell from stock: \"name | count\" lines, holds expire after 15 min\n"
+              << "  --shared-catalog <name>                  Map the catalog another process published in shared memory\n"
+              << "  --watch                                  Reload the catalog file or follow new shared versions\n"
+              << "  --threads <count>                        Worker threads for batch modes\n"
+              << "  --record <file>                          Record the interactive session as a script\n"
+              << "  --no-autosave                            Do not autosave unsaved work to configs/autosave/\n"
+              << "Script commands:\n";
+    for (const auto& info : scriptVerbs) {
+        std::cerr << "  " << info.usage << "\n";
+    }
+}
+
+// Main function
+int main(int argc, char* argv[]) {
+    std::string mode;
+    std::vector<std::string> arguments;
+    std::string catalogPath;
+    std::string sharedCatalogName;
+    std::string recordPath;
+    std::string inventoryPath;
+    bool autosave = true;
+    bool watchCatalog = false;
+    size_t threadCount = defaultThreadCount();
+
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--catalog" && i + 1 < argc) {
+            catalogPath = argv[++i];
+        } else if (option == "--inventory" && i + 1 < argc) {
+            inventoryPath = argv[++i];
+        } else if (option == "--no-autosave") {
+            autosave = false;
+        } else if (option == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (option == "--shared-catalog" && i + 1 < argc) {
+            sharedCatalogName = argv[++i];
+        } else if (option == "--watch") {
+            watchCatalog = true;
+        } else if (option == "--threads" && i + 1 < argc) {
+            if (!parseNumber(std::string_view(argv[++i]), threadCount) || threadCount == 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (mode.empty() && option.rfind("--", 0) == 0) {
+            mode = option;
+        } else if (!mode.empty()) {
+            arguments.push_back(option);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    CatalogStore catalogStore;
+    if (!catalogPath.empty()) {
+        std::string error;
+        if (!catalogStore.loadFile(catalogPath, error)) {
+            std::cerr << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+            return 1;
+        }
+        if (watchCatalog) {
+            catalogStore.watchFile(catalogPath);
+        }
+    } else if (!sharedCatalogName.empty()) {
+        std::string error;
+        if (!catalogStore.loadSharedCatalog(sharedCatalogName, error)) {
+            std::cerr << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+            return 1;
+        }
+        if (watchCatalog) {
+            catalogStore.watchSharedCatalog(sharedCatalogName);
+        }
+    }
+
+    std::optional<Inventory> inventory;
+    if (!inventoryPath.empty()) {
+        std::vector<std::pair<std::string, int64_t>> stock;
+        std::string error;
+        if (!loadInventoryFile(inventoryPath, stock, error)) {
+            std::cerr << COLOR_RED << "✗ " << error << COLOR_RESET << std::endl;
+            return 1;
+        }
+        inventory.emplace(stock);
+    }
+    Inventory* sharedInventory = inventory ? &*inventory : nullptr;
+
+    // Counts given to batch and benchmark modes; anything but a positive number shows the usage
+    size_t count = 0;
+    auto countArgument = [&arguments, &count](size_t index, size_t fallback) {
+        count = fallback;
+        return arguments.size() <= index || (parseNumber(std::string_view(arguments[index]), count) && count > 0);
+    };
+
+    if (mode.empty()) {
+        SessionRecorder recorder;
+        if (!recordPath.empty() && !recorder.open(recordPath)) {
+            std::cerr << COLOR_RED << "✗ Cannot open recording file: " << recordPath << COLOR_RESET << std::endl;
+            return 1;
+        }
+        runUserInterface(&catalogStore, recordPath.empty() ? nullptr : &recorder,
+                         autosave ? "configs/autosave/last.txt" : "", sharedInventory);
+    } else if (mode == "--script" && arguments.size() <= 1) {
+        return runScript(&catalogStore, arguments.empty() ? "-" : arguments[0], sharedInventory);
+    } else if (mode == "--replay" && !arguments.empty() && arguments.size() <= 2 && countArgument(1, 1000)) {
+        runScriptReplay(&catalogStore, arguments[0], count, threadCount, sharedInventory);
+    } else if (mode == "--bench-finance" && countArgument(0, 1000000)) {
+        runFinanceBenchmark(catalogStore.snapshot()->getView(), count);
+    } else if (mode == "--bench-inventory" && countArgument(0, 250000)) {
+        runInventoryBenchmark(std::max<size_t>(threadCount, 4), count);
+    } else if (mode == "--bench-arena" && countArgument(0, 100000)) {
+        runArenaBenchmark(count);
+    } else if (mode == "--bench-pricing" && countArgument(0, 1000000)) {
+        runPricingBenchmark(*catalogStore.snapshot(), count);
+    } else if (mode == "--bench-what-if" && countArgument(0, 10000)) {
+        runWhatIfBenchmark(*catalogStore.snapshot(), count);
+    } else if (mode == "--tco" && countArgument(0, 20000)) {
+        runTcoSurvey(catalogStore.snapshot()->getView(), count, threadCount);
+    } else if (mode == "--ev-sim" && countArgument(0, 10000)) {
+        auto snapshot = catalogStore.snapshot();
+        runEvSimulationSurvey(snapshot->getView(), snapshot->getVersion(), count, threadCount);
+    } else if (mode == "--bench-search" && countArgument(0, 100000)) {
+        runSearchBenchmark(catalogStore.snapshot()->getView(), count);
+    } else if (mode == "--bench-similar" && countArgument(0, 1000000)) {
+        runSimilarityBenchmark(catalogStore.snapshot()->getView(), count,
+                               threadCount);
+    } else if (mode == "--render-reports" && arguments.size() == 2) {
+        runReportBatch(catalogStore.snapshot()->getView(), arguments[0], arguments[1], threadCount);
+    } else if (mode == "--dedupe-configs" && !arguments.empty() && arguments.size() <= 2) {
+        runConfigurationDedupe(arguments[0], arguments.size() == 2 && arguments[1] == "remove");
+    } else if (mode == "--analytics" && !arguments.empty() && arguments.size() <= 2 && countArgument(1, 10)) {
+        runConfigurationAnalytics(arguments[0], threadCount, count);
+    } else if (mode == "--export-columns" && arguments.size() == 2) {
+        runColumnarExport(arguments[0], arguments[1], threadCount);
+    } else if (mode == "--scan-columns" && !arguments.empty()) {
+        runColumnarScan(arguments[0], std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+    } else if (mode == "--publish-catalog" && arguments.size() == 1) {
+        return runCatalogPublisher(catalogStore, arguments[0], watchCatalog && !catalogPath.empty());
+    } else if (mode == "--unpublish-catalog" && arguments.size() == 1) {
+        unpublishSharedCatalog(arguments[0]);
+    } else if (mode == "--history-add" && arguments.size() == 2) {
+        return runHistoryAdd(catalogStore.snapshot()->getView(), arguments[0], arguments[1]);
+    } else if (mode == "--history-show" && (arguments.size() == 1 || arguments.size() == 2)) {
+        return runHistoryShow(arguments[0], arguments.size() == 2 ? arguments[1] : "");
+    } else if (mode == "--quote-as-of" && arguments.size() >= 3) {
+        return runQuoteAsOf(arguments[0], arguments[1], std::vector<std::string>(arguments.begin() + 2, arguments.end()));
+    } else if (mode == "--bench-history" && countArgument(0, 1000)) {
+        runHistoryBenchmark(catalogStore.snapshot()->getView(), count);
+    } else if (mode == "--reprice" && (arguments.size() == 1 || arguments.size() == 2)) {
+        return runRepriceDrift(catalogStore.snapshot()->getView(), arguments[0], arguments.size() == 2 ? arguments[1] : "-",
+                               threadCount);
+    } else if (mode == "--memory-report" && arguments.size() <= 1) {
+        // A fresh session with every index built, so reports compare across catalog versions
+        consoleTarget.interactive = false;
+        VehicleConfigurator configurator(&catalogStore);
+        configurator.buildIndexes();
+        return configurator.writeMemoryFootprint(arguments.empty() ? "-" : arguments[0]) ? 0 : 1;
+    } else if (mode == "--archive-pack" && (arguments.size() == 2 || arguments.size() == 3)) {
+        ArchiveCodec codec = DEFAULT_ARCHIVE_CODEC;
+        if (arguments.size() == 3 && arguments[2] == "lz") {
+            codec = ArchiveCodec::LZ;
+        } else if (arguments.size() == 3 && arguments[2] == "zlib") {
+#ifdef HAVE_ZLIB
+            codec = ArchiveCodec::ZLIB;
+#else
+            std::cerr << COLOR_RED << "✗ This build has no zlib support" << COLOR_RESET << std::endl;
+            return 1;
+#endif
+        } else if (arguments.size() == 3) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        runArchivePack(arguments[0], arguments[1], codec, threadCount);
+    } else if (mode == "--archive-unpack" && arguments.size() == 2) {
+        runArchiveUnpack(arguments[0], arguments[1], threadCount);
+    } else if (mode == "--archive-extract" && (arguments.size() == 2 || arguments.size() == 3)) {
+        return runArchiveExtract(arguments[0], arguments[1], arguments.size() == 3 ? arguments[2] : "-");
+    } else if (mode == "--archive-list" && arguments.size() == 1) {
+        runArchiveList(arguments[0]);
+    } else if (mode == "--quote" && arguments.size() <= 2) {
+        auto snapshot = catalogStore.snapshot();
+        return runQuoteBatch(*snapshot, arguments.empty() ? "-" : arguments[0],
+                             arguments.size() < 2 ? "-" : arguments[1], threadCount);
+    } else {
+        printUsage(argv[0]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Build step: converts catalog.dat into constexpr tables (catalog_data.h) for app.cpp
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdlib>
+
+// Splits a catalog line on '|' and trims surrounding spaces from every field
+std::vector<std::string> splitFields(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, '|')) {
+        size_t first = field.find_first_not_of(" \t\r");
+        size_t last = field.find_last_not_of(" \t\r");
+        fields.push_back(first == std::string::npos ? "" : field.substr(first, last - first + 1));
+    }
+    return fields;
+}
+
+// Escapes a field for use inside a C++ string literal
+std::string quote(const std::string& text) {
+    std::string result = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') result += '\\';
+        result += c;
+    }
+    return result + "\"";
+}
+
+bool isNumber(const std::string& text, bool integer) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    if (integer) {
+        std::strtol(text.c_str(), &end, 10);
+    } else {
+        std::strtod(text.c_str(), &end);
+    }
+    return *end == '\0';
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: catalog_gen <catalog.dat> <catalog_data.h>" << std::endl;
+        return 1;
+    }
+
+    std::ifstream input(argv[1]);
+    if (!input.is_open()) {
+        std::cerr << "Cannot open catalog file: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    const std::set<std::string> categories = {"COMFORT", "SAFETY", "MULTIMEDIA", "EXTERIOR", "PERFORMANCE"};
+    std::vector<std::string> colors, engines, equipment, vehicles;
+    std::string section, line;
+    int lineNumber = 0;
+
+    auto fail = [&](const std::string& message) {
+        std::cerr << argv[1] << ":" << lineNumber << ": " << message << std::endl;
+        return 1;
+    };
+
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        std::vector<std::string> fields = splitFields(line);
+        if (fields.empty() || fields[0].empty() || fields[0][0] == '#') continue;
+
+        if (fields[0].front() == '[') {
+            section = fields[0];
+            continue;
+        }
+
+        if (section == "[COLORS]") {
+            colors.push_back(quote(fields[0]));
+        } else if (section == "[ENGINES]") {
+            if (fields.size() != 7) return fail("engine needs 7 fields");
+            if (!isNumber(fields[1], false) || !isNumber(fields[2], true) || !isNumber(fields[4], false) ||
+                !isNumber(fields[5], true) || !isNumber(fields[6], false)) {
+                return fail("invalid number in engine");
+            }
+            engines.push_back("{" + quote(fields[0]) + ", " + fields[1] + ", " + fields[2] + ", " +
+                              quote(fields[3]) + ", " + fields[4] + ", " + fields[5] + ", " + fields[6] + "}");
+        } else if (section == "[EQUIPMENT]") {
+            if (fields.size() != 4) return fail("equipment needs 4 fields");
+            if (!isNumber(fields[2], false)) return fail("invalid equipment price");
+            if (!categories.count(fields[3])) return fail("unknown equipment category " + fields[3]);
+            equipment.push_back("{" + quote(fields[0]) + ", " + quote(fields[1]) + ", " + fields[2] +
+                                ", EquipmentCategory::" + fields[3] + "}");
+        } else if (section == "[VEHICLES]") {
+            // Record layout: kind, brand, model, base price, year, body type,
+            // doors, trunk, displacement, battery, range, charging time
+            const std::string& kind = fields[0];
+            size_t expected = kind == "CAR" ? 8 : kind == "MOTORCYCLE" ? 7 : kind == "ELECTRIC" ? 8 : 0;
+            if (expected == 0) return fail("unknown vehicle kind " + kind);
+            if (fields.size() != expected) return fail(kind + " needs " + std::to_string(expected) + " fields");
+            if (!isNumber(fields[3], false)) return fail("invalid vehicle price");
+            for (size_t i = (kind == "ELECTRIC" ? 5 : 6); i < fields.size(); ++i) {
+                if (!isNumber(fields[i], true)) return fail("invalid number in vehicle");
+            }
+
+            std::string common = "VehicleKind::" + kind + ", " + quote(fields[1]) + ", " + quote(fields[2]) + ", " +
+                                 fields[3] + ", " + quote(fields[4]);
+            if (kind == "CAR") {
+                vehicles.push_back("{" + common + ", " + quote(fields[5]) + ", " + fields[6] + ", " + fields[7] +
+                                   ", 0, 0, 0, 0}");
+            } else if (kind == "MOTORCYCLE") {
+                vehicles.push_back("{" + common + ", " + quote(fields[5]) + ", 0, 0, " + fields[6] + ", 0, 0, 0}");
+            } else {
+                vehicles.push_back("{" + common + ", \"\", 0, 0, 0, " + fields[5] + ", " + fields[6] + ", " +
+                                   fields[7] + "}");
+            }
+        } else {
+            return fail("entry outside of a known section");
+        }
+    }
+
+    if (colors.empty() || engines.empty() || equipment.empty() || vehicles.empty()) {
+        std::cerr << argv[1] << ": every catalog section needs at least one entry" << std::endl;
+        return 1;
+    }
+
+    std::ofstream output(argv[2]);
+    if (!output.is_open()) {
+        std::cerr << "Cannot open output file: " << argv[2] << std::endl;
+        return 1;
+    }
+
+    auto writeTable = [&output](const std::string& declaration, const std::vector<std::string>& rows) {
+        output << "constexpr " << declaration << "[] = {\n";
+        for (const auto& row : rows) {
+            output << "    " << row << ",\n";
+        }
+        output << "};\n\n";
+    };
+
+    output << "// Generated by catalog_gen from catalog.dat - do not edit\n";
+    output << "#pragma once\n\n";
+    writeTable("std::string_view catalogColors", colors);
+    writeTable("EngineRecord catalogEngines", engines);
+    writeTable("EquipmentRecord catalogEquipment", equipment);
+    writeTable("VehicleRecord catalogVehicles", vehicles);
+    return 0;
+}